@@ -2,16 +2,21 @@
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/spawn.hpp>
 #include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/asio/deadline.hpp>
+#include <sdbusplus/asio/method_stats.hpp>
 #include <sdbusplus/asio/object_server.hpp>
 #include <sdbusplus/asio/sd_event.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/exception.hpp>
+#include <sdbusplus/message/arena.hpp>
 #include <sdbusplus/server.hpp>
 #include <sdbusplus/timer.hpp>
 
 #include <chrono>
 #include <ctime>
 #include <iostream>
+#include <memory_resource>
+#include <string_view>
 #include <variant>
 
 using variant = std::variant<int, std::string>;
@@ -162,6 +167,27 @@ void do_start_async_to_yield(std::shared_ptr<sdbusplus::asio::connection> conn,
         std::cout << "ec = " << ec << ": " << testValue << "\n";
     }
 
+    // The same call with a budget: it fails with asio::error::timed_out
+    // rather than waiting out the bus default if no reply comes within
+    // 100ms, and the outcome is counted in 'metrics'.
+    ec.clear();
+    sdbusplus::bus::call_metrics metrics;
+    testValue = sdbusplus::asio::yield_method_call_until<int>(
+        *conn, yield, ec,
+        sdbusplus::bus::deadline::after(std::chrono::milliseconds(100)),
+        metrics, "xyz.openbmc_project.asio-test", "/xyz/openbmc_project/test",
+        "xyz.openbmc_project.test", "TestYieldFunction", int(41));
+
+    if (!ec && testValue == 42)
+    {
+        std::cout << "yielding call to TestYieldFunction within 100ms OK!\n";
+    }
+    else
+    {
+        std::cout << "ec = " << ec << ", timeouts = "
+                  << metrics.stats().timeouts << "\n";
+    }
+
     ec.clear();
     auto badValue = conn->yield_method_call<std::string>(
         yield, ec, "xyz.openbmc_project.asio-test", "/xyz/openbmc_project/test",
@@ -239,11 +265,15 @@ int server()
             return property + std::ctime(&timePoint);
         });
 
-    // test method creation
-    iface->register_method("TestMethod", [](const int32_t& callCount) {
-        return std::make_tuple(callCount,
-                               "success: " + std::to_string(callCount));
-    });
+    // test method creation, timed into the stats object below
+    sdbusplus::server::method_stats stats;
+    sdbusplus::server::method_stats_object statsObject(*conn, stats);
+
+    sdbusplus::asio::register_timed_method(
+        *iface, stats, "TestMethod", [](const int32_t& callCount) {
+            return std::make_tuple(callCount,
+                                   "success: " + std::to_string(callCount));
+        });
 
     iface->register_method("TestFunction", foo);
 
@@ -258,7 +288,8 @@ int server()
 
     iface->register_method("VoidFunctionReturnsInt", voidBar);
 
-    iface->register_method("execute", ipmiInterface);
+    sdbusplus::asio::register_timed_method(*iface, stats, "execute",
+                                           ipmiInterface);
 
     iface->initialize();
 
@@ -315,9 +346,15 @@ int client()
             std::cerr << "error with async_send\n";
             return;
         }
-        GetSubTreeType data;
-        ret.read(data);
-        for (auto& item : data)
+        // The same reply, with the lists in an arena and the strings as
+        // views into the message instead of one allocation each.
+        using GetSubTreeView = std::pmr::vector<std::pair<
+            std::string_view,
+            std::pmr::vector<std::pair<std::string_view,
+                                       std::pmr::vector<std::string_view>>>>>;
+        std::pmr::monotonic_buffer_resource arena;
+        for (const auto& item :
+             sdbusplus::message::unpack_arena<GetSubTreeView>(ret, arena))
         {
             std::cout << item.first << "\n";
         }
@@ -0,0 +1,72 @@
+#include "alloc_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace bench::allocations
+{
+
+namespace
+{
+thread_local bool counted = false;
+std::atomic<uint64_t> count{0};
+std::atomic<uint64_t> bytes{0};
+} // namespace
+
+void countThisThread(bool enable)
+{
+    counted = enable;
+}
+
+Totals totals()
+{
+    return {count.load(), bytes.load()};
+}
+
+static void* allocate(std::size_t size)
+{
+    if (counted)
+    {
+        count.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    if (auto p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace bench::allocations
+
+void* operator new(std::size_t size)
+{
+    return bench::allocations::allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return bench::allocations::allocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
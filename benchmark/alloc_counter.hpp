@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bench::allocations
+{
+
+/** Totals of the operator new calls made by counted threads. */
+struct Totals
+{
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+/** @brief Count the calling thread's allocations from now on.
+ *
+ *  Linking alloc_counter.cpp replaces the global operator new; only threads
+ *  that opt in are counted, so a client and server sharing one process can
+ *  be told apart.
+ */
+void countThisThread(bool enable = true);
+
+/** @brief Allocations made so far by every counted thread. */
+Totals totals();
+
+} // namespace bench::allocations
@@ -0,0 +1,153 @@
+#include "alloc_counter.hpp"
+#include "private_bus.hpp"
+#include "systemd1.hpp"
+
+#include <benchmark/benchmark.h>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/message/arena.hpp>
+#include <sdbusplus/message/stream.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+/** Decodes a ListUnits reply of /N units, five ways:
+ *
+ *    std_string   - unpack std::vector<systemd1::ListUnitsEntry>, a
+ *                   std::string or object_path per field, as the examples
+ *                   used to,
+ *    arena_string - unpack_arena() into std::pmr::vector and std::pmr::string,
+ *                   copying the strings into an arena over a reused buffer,
+ *    arena_view   - unpack_arena() with std::string_view fields, viewing
+ *                   the strings in the message, over the same buffer,
+ *    arena_grow   - arena_view with a monotonic_buffer_resource that starts
+ *                   empty and allocates its blocks from the heap, as the
+ *                   examples use it,
+ *    stream       - message::stream() of systemd1::ListUnitsEntry, one
+ *                   element at a time into the same tuple.
+ *
+ *  "allocs_per_decode" and "bytes_per_decode" count operator new calls and
+ *  bytes per decode.
+ */
+
+template <typename String>
+using Entry = std::tuple<String, String, String, String, String, String,
+                         String, uint32_t, String, String>;
+
+static sdbusplus::bus_t* bus = nullptr;
+
+/* A sealed ListUnits reply of 'units' units. */
+static sdbusplus::message_t reply(size_t units)
+{
+    std::vector<systemd1::ListUnitsEntry> entries;
+    entries.reserve(units);
+    for (size_t i = 0; i < units; ++i)
+    {
+        auto name = "bench-unit-" + std::to_string(i) + ".service";
+        entries.emplace_back(name, "Benchmark unit " + std::to_string(i),
+                             "loaded", "active", "running", "",
+                             systemd1::unitPath(name), 0, "", "/");
+    }
+
+    auto m = bus->new_method_call(systemd1::service, systemd1::path,
+                                  systemd1::managerInterface, "ListUnits");
+    m.append(entries);
+    if (auto r = sd_bus_message_seal(m.get(), 1, 0); r < 0)
+    {
+        throw sdbusplus::exception::SdBusError(-r, "sd_bus_message_seal");
+    }
+    return m;
+}
+
+/* Enough for /10000 of arena_string without falling back to the heap. */
+static std::vector<std::byte> buffer(64 << 20);
+
+static void stdString(sdbusplus::message_t& m)
+{
+    auto units = m.unpack<std::vector<systemd1::ListUnitsEntry>>();
+    benchmark::DoNotOptimize(units);
+}
+
+template <typename String>
+static void arenaBuffer(sdbusplus::message_t& m)
+{
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    auto units = sdbusplus::message::unpack_arena<
+        std::pmr::vector<Entry<String>>>(m, arena);
+    benchmark::DoNotOptimize(units);
+}
+
+static void arenaGrow(sdbusplus::message_t& m)
+{
+    std::pmr::monotonic_buffer_resource arena;
+    auto units = sdbusplus::message::unpack_arena<
+        std::pmr::vector<Entry<std::string_view>>>(m, arena);
+    benchmark::DoNotOptimize(units);
+}
+
+static void streamed(sdbusplus::message_t& m)
+{
+    for (auto& unit : sdbusplus::message::stream<systemd1::ListUnitsEntry>(m))
+    {
+        benchmark::DoNotOptimize(unit);
+    }
+}
+
+template <typename Decode>
+static void decode(benchmark::State& state, Decode d)
+{
+    auto units = static_cast<size_t>(state.range(0));
+    auto m = reply(units);
+
+    bench::allocations::countThisThread();
+    auto before = bench::allocations::totals();
+    for (auto _ : state)
+    {
+        sd_bus_message_rewind(m.get(), true);
+        d(m);
+    }
+    auto after = bench::allocations::totals();
+    bench::allocations::countThisThread(false);
+
+    state.counters["allocs_per_decode"] =
+        benchmark::Counter(static_cast<double>(after.count - before.count),
+                           benchmark::Counter::kAvgIterations);
+    state.counters["bytes_per_decode"] =
+        benchmark::Counter(static_cast<double>(after.bytes - before.bytes),
+                           benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * units));
+}
+
+BENCHMARK_CAPTURE(decode, std_string, stdString)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(decode, arena_string, arenaBuffer<std::pmr::string>)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(decode, arena_view, arenaBuffer<std::string_view>)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(decode, arena_grow, arenaGrow)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(decode, stream, streamed)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv)
+{
+    bench::PrivateBus privateBus;
+    auto b = sdbusplus::bus::new_default();
+    bus = &b;
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,235 @@
+#include "latency.hpp"
+#include "private_bus.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <nlohmann/json.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/asio/object_server.hpp>
+#include <sdbusplus/asio/strand_pool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** Calls/sec of a CPU-bound sdbusplus::asio method against the number of
+ *  worker threads in a sdbusplus::asio::strand_pool.
+ *
+ *  The server hosts --objects objects, each with a 'Work' method that spins
+ *  for --iterations rounds.  With 0 threads the work runs inline on the bus
+ *  thread (the default asio behaviour); otherwise it is offloaded to the
+ *  object's strand.  The client keeps --concurrency calls in flight,
+ *  spread round-robin over the objects, for --duration ms.
+ *
+ *  usage: asio-scaling-bench [--objects <n>] [--iterations <n>]
+ *                            [--duration <ms>] [--concurrency <n>]
+ *                            [--threads <n>]...
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto service = "bench.AsioScaling";
+constexpr auto interface = "bench.AsioScaling";
+
+struct Options
+{
+    size_t objects = 8;
+    uint64_t iterations = 100000;
+    std::chrono::milliseconds duration{2000};
+    size_t concurrency = 64;
+    std::vector<size_t> threads;
+};
+
+std::string objectPath(size_t i)
+{
+    return "/bench/scaling/obj" + std::to_string(i);
+}
+
+uint64_t spin(uint64_t seed, uint64_t iterations)
+{
+    uint64_t h = seed;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= i;
+    }
+    return h;
+}
+
+/* Host the objects on 'io' until it is stopped. */
+void serve(boost::asio::io_context& io, size_t objects, size_t threads)
+{
+    auto conn = std::make_shared<sdbusplus::asio::connection>(io);
+    sdbusplus::asio::object_server server(conn);
+
+    std::unique_ptr<sdbusplus::asio::strand_pool> pool;
+    if (threads > 0)
+    {
+        pool = std::make_unique<sdbusplus::asio::strand_pool>(threads);
+    }
+
+    std::vector<std::shared_ptr<sdbusplus::asio::dbus_interface>> ifaces;
+    for (size_t i = 0; i < objects; ++i)
+    {
+        auto path = objectPath(i);
+        auto iface = server.add_interface(path, interface);
+        iface->register_method(
+            "Work", [&pool, path](boost::asio::yield_context yield,
+                                  uint64_t seed, uint64_t iterations) {
+                if (!pool)
+                {
+                    return spin(seed, iterations);
+                }
+                return pool->run(path, yield, [seed, iterations] {
+                    return spin(seed, iterations);
+                });
+            });
+        iface->initialize();
+        ifaces.push_back(std::move(iface));
+    }
+
+    conn->request_name(service);
+    io.run();
+}
+
+nlohmann::json runCase(const Options& opts)
+{
+    boost::asio::io_context io;
+    auto conn = std::make_shared<sdbusplus::asio::connection>(io);
+
+    bench::LatencyRecorder recorder;
+    auto start = Clock::now();
+    auto deadline = start + opts.duration;
+    size_t next = 0;
+    size_t outstanding = 0;
+
+    std::function<void()> issue = [&]() {
+        ++outstanding;
+        auto path = objectPath(next++ % opts.objects);
+        auto callStart = Clock::now();
+        conn->async_method_call(
+            [&, callStart](const boost::system::error_code& ec, uint64_t) {
+                if (ec)
+                {
+                    recorder.error();
+                }
+                else
+                {
+                    recorder.record(Clock::now() - callStart);
+                }
+                --outstanding;
+                if (Clock::now() < deadline)
+                {
+                    issue();
+                }
+                else if (outstanding == 0)
+                {
+                    // The connection's read keeps run() going; stop it here.
+                    io.stop();
+                }
+            },
+            service, path, interface, "Work", static_cast<uint64_t>(next),
+            opts.iterations);
+    };
+
+    for (size_t i = 0; i < opts.concurrency; ++i)
+    {
+        issue();
+    }
+    io.run();
+
+    return recorder.summary(Clock::now() - start);
+}
+
+int main(int argc, const char* argv[])
+{
+    Options opts;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--objects" && i + 1 < argc)
+        {
+            opts.objects = std::stoul(argv[++i]);
+        }
+        else if (arg == "--iterations" && i + 1 < argc)
+        {
+            opts.iterations = std::stoull(argv[++i]);
+        }
+        else if (arg == "--duration" && i + 1 < argc)
+        {
+            opts.duration = std::chrono::milliseconds(std::stoul(argv[++i]));
+        }
+        else if (arg == "--concurrency" && i + 1 < argc)
+        {
+            opts.concurrency = std::stoul(argv[++i]);
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            opts.threads.push_back(std::stoul(argv[++i]));
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--objects <n>] [--iterations <n>]"
+                         " [--duration <ms>] [--concurrency <n>]"
+                         " [--threads <n>]...\n";
+            return -1;
+        }
+    }
+
+    if (opts.threads.empty())
+    {
+        size_t max = std::max(std::thread::hardware_concurrency(), 1u);
+        opts.threads.push_back(0);
+        for (size_t t = 1; t <= max; t *= 2)
+        {
+            opts.threads.push_back(t);
+        }
+    }
+
+    bench::PrivateBus privateBus;
+
+    nlohmann::json results = nlohmann::json::array();
+    for (auto threads : opts.threads)
+    {
+        std::cerr << "threads=" << threads << "\n";
+
+        boost::asio::io_context serverIo;
+        std::thread server(serve, std::ref(serverIo), opts.objects, threads);
+
+        if (!bench::waitForName(service, std::chrono::seconds(5)))
+        {
+            std::cerr << service << " never appeared\n";
+            serverIo.stop();
+            server.join();
+            return 1;
+        }
+
+        auto r = runCase(opts);
+        r["threads"] = threads;
+        results.push_back(std::move(r));
+
+        serverIo.stop();
+        server.join();
+        bench::waitForName(service, std::chrono::seconds(5), false);
+    }
+
+    std::cout << nlohmann::json{{"benchmark", "asio-scaling"},
+                                {"objects", opts.objects},
+                                {"iterations", opts.iterations},
+                                {"duration_ms", opts.duration.count()},
+                                {"concurrency", opts.concurrency},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include "latency.hpp"
+#include "private_bus.hpp"
+
+#include <net/poettering/Calculator/common.hpp>
+#include <nlohmann/json.hpp>
+#include <sdbusplus/async.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/** Drives Multiply / Divide / LastResult Get+Set against each calculator
+ *  server variant at fixed concurrency levels and prints a JSON report.
+ *
+ *  usage: calculator-bench [--duration <ms>] [--concurrency <n>]...
+ *                          <variant>=<server-binary>...
+ *
+ *  Variants are 'server' (calculator-server), 'aserver' (calculator-aserver)
+ *  and 'asio' (my-calculator).
+ */
+
+using Clock = std::chrono::steady_clock;
+using Calculator = sdbusplus::common::net::poettering::Calculator;
+
+struct Target
+{
+    const char* service;
+    const char* path;
+    const char* interface;
+};
+
+// calculator-server and calculator-aserver implement the generated
+// interface; my-calculator registers its own equivalent by hand.
+const std::map<std::string, Target> targets = {
+    {"server",
+     {Calculator::default_service, Calculator::instance_path,
+      Calculator::interface}},
+    {"aserver",
+     {Calculator::default_service, Calculator::instance_path,
+      Calculator::interface}},
+    {"asio",
+     {"xyz.openbmc_project.Calculator", "/xyz/openbmc_project/calculator",
+      "xyz.openbmc_project.Calculator"}},
+};
+
+enum class Operation
+{
+    Multiply,
+    Divide,
+    GetLastResult,
+    SetLastResult,
+};
+
+const std::map<Operation, std::string> operationNames = {
+    {Operation::Multiply, "Multiply"},
+    {Operation::Divide, "Divide"},
+    {Operation::GetLastResult, "LastResult.Get"},
+    {Operation::SetLastResult, "LastResult.Set"},
+};
+
+auto worker(sdbusplus::async::context& ctx, Target t, Operation op,
+            Clock::time_point deadline, bench::LatencyRecorder& recorder,
+            size_t& remaining) -> sdbusplus::async::task<>
+{
+    auto proxy = sdbusplus::async::proxy()
+                     .service(t.service)
+                     .path(t.path)
+                     .interface(t.interface);
+
+    while (Clock::now() < deadline)
+    {
+        auto start = Clock::now();
+        try
+        {
+            switch (op)
+            {
+                case Operation::Multiply:
+                    co_await proxy.call<int64_t>(ctx, "Multiply", int64_t(7),
+                                                 int64_t(6));
+                    break;
+                case Operation::Divide:
+                    co_await proxy.call<int64_t>(ctx, "Divide", int64_t(42),
+                                                 int64_t(6));
+                    break;
+                case Operation::GetLastResult:
+                    co_await proxy.get_property<int64_t>(
+                        ctx, Calculator::property_names::last_result);
+                    break;
+                case Operation::SetLastResult:
+                    co_await proxy.set_property(
+                        ctx, Calculator::property_names::last_result,
+                        int64_t(1234));
+                    break;
+            }
+            recorder.record(Clock::now() - start);
+        }
+        catch (const std::exception&)
+        {
+            recorder.error();
+        }
+    }
+
+    if (--remaining == 0)
+    {
+        ctx.request_stop();
+    }
+    co_return;
+}
+
+nlohmann::json runCase(const Target& t, Operation op, size_t concurrency,
+                       std::chrono::milliseconds duration)
+{
+    sdbusplus::async::context ctx;
+    bench::LatencyRecorder recorder;
+
+    auto start = Clock::now();
+    size_t remaining = concurrency;
+    for (size_t i = 0; i < concurrency; ++i)
+    {
+        ctx.spawn(
+            worker(ctx, t, op, start + duration, recorder, remaining));
+    }
+    ctx.run();
+
+    return recorder.summary(Clock::now() - start);
+}
+
+int main(int argc, const char* argv[])
+{
+    std::chrono::milliseconds duration{2000};
+    std::vector<size_t> concurrency;
+    std::vector<std::pair<std::string, std::string>> servers;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--duration" && i + 1 < argc)
+        {
+            duration = std::chrono::milliseconds(std::stoul(argv[++i]));
+        }
+        else if (arg == "--concurrency" && i + 1 < argc)
+        {
+            concurrency.push_back(std::stoul(argv[++i]));
+        }
+        else if (auto eq = arg.find('=');
+                 eq != std::string::npos && targets.contains(arg.substr(0, eq)))
+        {
+            servers.emplace_back(arg.substr(0, eq), arg.substr(eq + 1));
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--duration <ms>] [--concurrency <n>]..."
+                         " <server|aserver|asio>=<binary>...\n";
+            return -1;
+        }
+    }
+    if (concurrency.empty())
+    {
+        concurrency = {1, 8, 64};
+    }
+
+    bench::PrivateBus bus;
+    nlohmann::json results = nlohmann::json::array();
+
+    for (const auto& [variant, binary] : servers)
+    {
+        const auto& t = targets.at(variant);
+
+        {
+            bench::ChildProcess server({binary});
+
+            if (!bench::waitForName(t.service, std::chrono::seconds(5)))
+            {
+                std::cerr << variant << ": " << t.service
+                          << " never appeared\n";
+                return 1;
+            }
+
+            for (auto n : concurrency)
+            {
+                for (const auto& [op, name] : operationNames)
+                {
+                    std::cerr << variant << " " << name << " x" << n << "\n";
+
+                    auto r = runCase(t, op, n, duration);
+                    r["server"] = variant;
+                    r["operation"] = name;
+                    r["concurrency"] = n;
+                    results.push_back(std::move(r));
+                }
+            }
+        }
+
+        // The sync and async servers share a service name; let the broker
+        // drop it before the next variant asks for it.
+        bench::waitForName(t.service, std::chrono::seconds(5), false);
+    }
+
+    std::cout << nlohmann::json{{"benchmark", "calculator"},
+                                {"duration_ms", duration.count()},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include "latency.hpp"
+#include "private_bus.hpp"
+
+#include <sys/socket.h>
+#include <systemd/sd-bus.h>
+
+#include <nlohmann/json.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/connection_pool.hpp>
+#include <sdbusplus/exception.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** Per-call latency of a short synchronous call, with and without pooling.
+ *
+ *  Each call is org.freedesktop.DBus.GetId, answered by the broker itself,
+ *  so the connection handshake is all that differs:
+ *
+ *    new_connection - new_default() per call, as the examples used to do,
+ *    pool           - connection_pool::call() from one thread,
+ *    pool_threads   - the same pool shared by --threads threads,
+ *    after_drop     - the first call after every idle connection's socket
+ *                     was shut down, as by a broker restart; the pool must
+ *                     notice and reconnect rather than fail.
+ *
+ *  usage: connection-pool-bench [--calls <n>] [--threads <n>]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+    size_t calls = 2000;
+    size_t threads = 4;
+};
+
+std::string getId(sdbusplus::bus_t& bus)
+{
+    auto m = bus.new_method_call("org.freedesktop.DBus",
+                                 "/org/freedesktop/DBus",
+                                 "org.freedesktop.DBus", "GetId");
+    return bus.call(m).unpack<std::string>();
+}
+
+/* Time `call` `calls` times from each of `threads` threads. */
+nlohmann::json run(size_t calls, size_t threads,
+                   const std::function<void()>& call)
+{
+    bench::LatencyRecorder recorder;
+    std::mutex lock;
+    auto start = Clock::now();
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&] {
+            bench::LatencyRecorder local;
+            for (size_t i = 0; i < calls; ++i)
+            {
+                auto callStart = Clock::now();
+                try
+                {
+                    call();
+                    local.record(Clock::now() - callStart);
+                }
+                catch (const sdbusplus::exception::SdBusError&)
+                {
+                    local.error();
+                }
+            }
+            std::lock_guard l(lock);
+            recorder.merge(local);
+        });
+    }
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+
+    return recorder.summary(Clock::now() - start);
+}
+
+nlohmann::json statistics(const sdbusplus::bus::connection_pool& pool)
+{
+    auto s = pool.stats();
+    return {{"connects", s.connects},
+            {"reuses", s.reuses},
+            {"dropped", s.dropped},
+            {"retries", s.retries}};
+}
+
+int main(int argc, const char* argv[])
+{
+    Options opts;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--calls" && i + 1 < argc)
+        {
+            opts.calls = std::stoul(argv[++i]);
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            opts.threads = std::stoul(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--calls <n>] [--threads <n>]\n";
+            return -1;
+        }
+    }
+
+    bench::PrivateBus privateBus;
+    nlohmann::json results = nlohmann::json::object();
+
+    std::cerr << "new_connection\n";
+    results["new_connection"] = run(opts.calls, 1, [] {
+        auto bus = sdbusplus::bus::new_default();
+        getId(bus);
+    });
+
+    sdbusplus::bus::connection_pool pool(&sdbusplus::bus::new_bus,
+                                         opts.threads);
+    auto poolCall = [&pool] {
+        pool.call<std::string>("org.freedesktop.DBus", "/org/freedesktop/DBus",
+                               "org.freedesktop.DBus", "GetId");
+    };
+
+    std::cerr << "pool\n";
+    results["pool"] = run(opts.calls, 1, poolCall);
+    results["pool"]["pool_stats"] = statistics(pool);
+
+    std::cerr << "pool_threads\n";
+    results["pool_threads"] = run(opts.calls, opts.threads, poolCall);
+    results["pool_threads"]["threads"] = opts.threads;
+    results["pool_threads"]["pool_stats"] = statistics(pool);
+
+    // Cut every idle connection off at the socket, as a broker restart
+    // would, and put them back in the pool.
+    std::cerr << "after_drop\n";
+    {
+        std::vector<sdbusplus::bus::connection_lease> leases;
+        for (auto n = pool.idle(); n > 0; --n)
+        {
+            leases.push_back(pool.acquire());
+            shutdown(sd_bus_get_fd(leases.back()->get()), SHUT_RDWR);
+        }
+    }
+    results["after_drop"] = run(1, 1, poolCall);
+    results["after_drop"]["pool_stats"] = statistics(pool);
+
+    std::cout << nlohmann::json{{"benchmark", "connection-pool"},
+                                {"calls", opts.calls},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    return results["after_drop"]["errors"] == 0 ? 0 : 1;
+}
@@ -0,0 +1,282 @@
+#include "latency.hpp"
+#include "private_bus.hpp"
+
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <nlohmann/json.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/asio/deadline.hpp>
+#include <sdbusplus/asio/object_server.hpp>
+#include <sdbusplus/bus/deadline.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** Client-side latency of an overloaded service, with and without deadlines.
+ *
+ *  The server answers 'Work' one call at a time, taking --service-us each,
+ *  so --concurrency callers queue behind each other.  Every case makes
+ *  --calls calls:
+ *
+ *    no_deadline - yield_method_call(); latency grows with the queue, up to
+ *                  the bus's 25s default timeout,
+ *    deadline    - yield_method_call_until() with --budget-ms; a caller
+ *                  gives up at the deadline, so its latency is capped
+ *                  there and the give-ups are counted as timeouts,
+ *    cancel      - --concurrency calls with a 10s deadline, all cancelled
+ *                  through their coroutines' cancellation slots;
+ *                  release_us is how long the last one took to return.
+ *
+ *  "latency_us" covers the calls that got a reply, "observed_latency_us"
+ *  every call, as its caller saw it.  The server is drained between cases.
+ *
+ *  usage: deadline-bench [--calls <n>] [--concurrency <n>]
+ *                        [--service-us <n>] [--budget-ms <n>]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto service = "bench.Deadline";
+constexpr auto path = "/bench/deadline";
+constexpr auto interface = "bench.Deadline";
+
+struct Options
+{
+    size_t calls = 2000;
+    size_t concurrency = 64;
+    uint32_t service_us = 500;
+    std::chrono::milliseconds budget{20};
+};
+
+/* Serve 'Work' on 'io', one call at a time, until it is stopped. */
+void serve(boost::asio::io_context& io)
+{
+    auto conn = std::make_shared<sdbusplus::asio::connection>(io);
+    sdbusplus::asio::object_server server(conn);
+
+    auto iface = server.add_interface(path, interface);
+    iface->register_method("Work", [](uint32_t us) {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+        return us;
+    });
+    iface->register_method("Ping", [] {});
+    iface->initialize();
+
+    conn->request_name(service);
+    io.run();
+}
+
+/* Wait until the server has worked through every abandoned call. */
+void drain(sdbusplus::asio::connection& conn)
+{
+    auto m = conn.new_method_call(service, path, interface, "Ping");
+    conn.call(m);
+}
+
+/* Run 'call' 'calls' times from 'concurrency' coroutines. */
+nlohmann::json runCase(
+    sdbusplus::asio::connection& conn, boost::asio::io_context& io,
+    const Options& opts,
+    const std::function<bool(boost::asio::yield_context)>& call)
+{
+    bench::LatencyRecorder replies;
+    bench::LatencyRecorder observed;
+    size_t issued = 0;
+    size_t active = opts.concurrency;
+    auto start = Clock::now();
+
+    for (size_t i = 0; i < opts.concurrency; ++i)
+    {
+        boost::asio::spawn(
+            io,
+            [&](boost::asio::yield_context yield) {
+                while (issued < opts.calls)
+                {
+                    ++issued;
+                    auto callStart = Clock::now();
+                    auto ok = call(yield);
+                    auto elapsed = Clock::now() - callStart;
+                    observed.record(elapsed);
+                    if (ok)
+                    {
+                        replies.record(elapsed);
+                    }
+                    else
+                    {
+                        replies.error();
+                    }
+                }
+                // The connection's read keeps run() going; stop it here.
+                if (--active == 0)
+                {
+                    io.stop();
+                }
+            },
+            boost::asio::detached);
+    }
+    io.restart();
+    io.run();
+
+    auto result = replies.summary(Clock::now() - start);
+    result["observed_latency_us"] =
+        observed.summary(Clock::now() - start)["latency_us"];
+    drain(conn);
+    return result;
+}
+
+nlohmann::json statistics(const sdbusplus::bus::call_metrics& metrics)
+{
+    auto s = metrics.stats();
+    return {{"calls", s.calls},
+            {"replies", s.replies},
+            {"errors", s.errors},
+            {"timeouts", s.timeouts},
+            {"cancellations", s.cancellations}};
+}
+
+int main(int argc, const char* argv[])
+{
+    Options opts;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--calls" && i + 1 < argc)
+        {
+            opts.calls = std::stoul(argv[++i]);
+        }
+        else if (arg == "--concurrency" && i + 1 < argc)
+        {
+            opts.concurrency = std::stoul(argv[++i]);
+        }
+        else if (arg == "--service-us" && i + 1 < argc)
+        {
+            opts.service_us = std::stoul(argv[++i]);
+        }
+        else if (arg == "--budget-ms" && i + 1 < argc)
+        {
+            opts.budget = std::chrono::milliseconds(std::stoul(argv[++i]));
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--calls <n>] [--concurrency <n>]"
+                         " [--service-us <n>] [--budget-ms <n>]\n";
+            return -1;
+        }
+    }
+
+    bench::PrivateBus privateBus;
+
+    boost::asio::io_context serverIo;
+    std::thread server(serve, std::ref(serverIo));
+    if (!bench::waitForName(service, std::chrono::seconds(5)))
+    {
+        std::cerr << "server did not start\n";
+        serverIo.stop();
+        server.join();
+        return 1;
+    }
+
+    boost::asio::io_context io;
+    auto conn = std::make_shared<sdbusplus::asio::connection>(io);
+    nlohmann::json results = nlohmann::json::object();
+
+    std::cerr << "no_deadline\n";
+    results["no_deadline"] =
+        runCase(*conn, io, opts, [&](boost::asio::yield_context yield) {
+            boost::system::error_code ec;
+            conn->yield_method_call<uint32_t>(yield, ec, service, path,
+                                              interface, "Work",
+                                              opts.service_us);
+            return !ec;
+        });
+
+    std::cerr << "deadline\n";
+    sdbusplus::bus::call_metrics metrics;
+    results["deadline"] =
+        runCase(*conn, io, opts, [&](boost::asio::yield_context yield) {
+            boost::system::error_code ec;
+            sdbusplus::asio::yield_method_call_until<uint32_t>(
+                *conn, yield, ec,
+                sdbusplus::bus::deadline::after(opts.budget), metrics,
+                service, path, interface, "Work", opts.service_us);
+            return !ec;
+        });
+    results["deadline"]["metrics"] = statistics(metrics);
+
+    // Start a call from every coroutine, then cancel them all at once.
+    std::cerr << "cancel\n";
+    sdbusplus::bus::call_metrics cancelMetrics;
+    std::vector<boost::asio::cancellation_signal> signals(opts.concurrency);
+    Clock::time_point emitted;
+    Clock::time_point released;
+    size_t active = opts.concurrency;
+    for (auto& signal : signals)
+    {
+        boost::asio::spawn(
+            io,
+            [&](boost::asio::yield_context yield) {
+                boost::system::error_code ec;
+                sdbusplus::asio::yield_method_call_until<uint32_t>(
+                    *conn, yield, ec,
+                    sdbusplus::bus::deadline::after(std::chrono::seconds(10)),
+                    cancelMetrics, service, path, interface, "Work",
+                    opts.service_us);
+                released = std::max(released, Clock::now());
+                if (--active == 0)
+                {
+                    io.stop();
+                }
+            },
+            boost::asio::bind_cancellation_slot(signal.slot(),
+                                                boost::asio::detached));
+    }
+    boost::asio::steady_timer timer(io, std::chrono::milliseconds(1));
+    timer.async_wait([&](const boost::system::error_code&) {
+        emitted = Clock::now();
+        for (auto& signal : signals)
+        {
+            signal.emit(boost::asio::cancellation_type::terminal);
+        }
+    });
+    io.restart();
+    io.run();
+    drain(*conn);
+
+    results["cancel"] = {
+        {"release_us",
+         std::chrono::duration<double, std::micro>(released - emitted)
+             .count()},
+        {"metrics", statistics(cancelMetrics)}};
+
+    serverIo.stop();
+    server.join();
+
+    std::cout << nlohmann::json{{"benchmark", "deadline"},
+                                {"calls", opts.calls},
+                                {"concurrency", opts.concurrency},
+                                {"service_us", opts.service_us},
+                                {"budget_ms", opts.budget.count()},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    // Every cancelled call must have been released, not left to time out.
+    return cancelMetrics.stats().cancellations +
+                       cancelMetrics.stats().replies ==
+                   opts.concurrency
+               ? 0
+               : 1;
+}
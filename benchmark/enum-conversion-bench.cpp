@@ -0,0 +1,119 @@
+#include <bench/EnumConversion/common.hpp>
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+/** Compares the generated perfect-hash / indexed enum conversions against
+ *  the std::find_if scans over the same mapping that sdbus++ used to emit,
+ *  for enums of 2, 20 and 200 values.
+ */
+
+using EnumConversion = sdbusplus::common::bench::EnumConversion;
+namespace details = sdbusplus::common::bench::details;
+
+// The previous string -> enum: a linear scan comparing every entry.
+template <const auto& Mapping>
+static auto linearFromString(const std::string& s)
+{
+    auto i = std::find_if(std::begin(Mapping), std::end(Mapping),
+                          [&s](auto& e) { return s == std::get<0>(e); });
+
+    using Enum = std::tuple_element_t<1, std::ranges::range_value_t<
+                                             decltype(Mapping)>>;
+    return i == std::end(Mapping) ? std::nullopt
+                                  : std::optional<Enum>(std::get<1>(*i));
+}
+
+// The previous enum -> string: a linear scan, then a std::string copy.
+template <const auto& Mapping, typename Enum>
+static std::string linearToString(Enum v)
+{
+    auto i = std::find_if(std::begin(Mapping), std::end(Mapping),
+                          [v](auto& e) { return v == std::get<1>(e); });
+    return std::string(std::get<0>(*i));
+}
+
+/* Convert every string of the enum, plus one unknown string, per
+ * iteration. */
+template <const auto& Mapping, typename Convert>
+static void fromString(benchmark::State& state, Convert convert)
+{
+    std::vector<std::string> strings;
+    for (const auto& [s, v] : Mapping)
+    {
+        strings.emplace_back(s);
+    }
+    strings.emplace_back("bench.EnumConversion.NotAValue");
+
+    for (auto _ : state)
+    {
+        for (const auto& s : strings)
+        {
+            benchmark::DoNotOptimize(convert(s));
+        }
+    }
+    state.SetItemsProcessed(
+        static_cast<int64_t>(state.iterations() * strings.size()));
+}
+
+/* Convert every value of the enum per iteration. */
+template <const auto& Mapping, typename Convert>
+static void toString(benchmark::State& state, Convert convert)
+{
+    for (auto _ : state)
+    {
+        for (const auto& [s, v] : Mapping)
+        {
+            benchmark::DoNotOptimize(convert(v));
+        }
+    }
+    state.SetItemsProcessed(
+        static_cast<int64_t>(state.iterations() * Mapping.size()));
+}
+
+/* Register the old and generated conversions for one enum. */
+template <const auto& Mapping, typename FromString, typename ToString>
+static void registerEnum(const std::string& name, FromString from,
+                         ToString to)
+{
+    using Enum = std::tuple_element_t<
+        1, std::ranges::range_value_t<decltype(Mapping)>>;
+
+    benchmark::RegisterBenchmark((name + "/from_string/linear_scan").c_str(),
+                                 fromString<Mapping, decltype(
+                                                         &linearFromString<
+                                                             Mapping>)>,
+                                 &linearFromString<Mapping>);
+    benchmark::RegisterBenchmark((name + "/from_string/perfect_hash").c_str(),
+                                 fromString<Mapping, FromString>, from);
+    benchmark::RegisterBenchmark(
+        (name + "/to_string/linear_scan").c_str(),
+        toString<Mapping, decltype(&linearToString<Mapping, Enum>)>,
+        &linearToString<Mapping, Enum>);
+    benchmark::RegisterBenchmark((name + "/to_string/indexed_view").c_str(),
+                                 toString<Mapping, ToString>, to);
+}
+
+int main(int argc, char** argv)
+{
+    registerEnum<details::mappingEnumConversionSmall>(
+        "Small", &EnumConversion::convertStringToSmall,
+        &EnumConversion::convertSmallToStringView);
+    registerEnum<details::mappingEnumConversionMedium>(
+        "Medium", &EnumConversion::convertStringToMedium,
+        &EnumConversion::convertMediumToStringView);
+    registerEnum<details::mappingEnumConversionLarge>(
+        "Large", &EnumConversion::convertStringToLarge,
+        &EnumConversion::convertLargeToStringView);
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+#include "alloc_counter.hpp"
+#include "latency.hpp"
+#include "private_bus.hpp"
+
+#include <bench/Inventory/aserver.hpp>
+#include <nlohmann/json.hpp>
+#include <sdbusplus/async.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+
+/** Measures server-side allocations per org.freedesktop.DBus.Properties
+ *  GetAll on an async-server object with large 's', 'as' and 'a{sv}'
+ *  properties, for three ways of implementing the getters:
+ *
+ *    by_value - get_property() returns a copy (the previous behaviour for
+ *               every property),
+ *    stored   - no get_property(); the generated storage is appended in
+ *               place,
+ *    view     - get_property() returns a std::string_view, a std::span and a
+ *               const&.
+ *
+ *  usage: getall-alloc-bench [--calls <n>] [--associations <n>]
+ *                            [--attributes <n>]
+ */
+
+using Clock = std::chrono::steady_clock;
+using Inventory = sdbusplus::common::bench::Inventory;
+
+constexpr auto service = "bench.Inventory";
+
+struct Sizes
+{
+    size_t associations = 256;
+    size_t attributes = 64;
+};
+
+template <typename Server>
+void populate(Server& s, const Sizes& sizes)
+{
+    s.pretty_name_ = "Motherboard Assembly, Rev C, with Integrated Baseboard "
+                     "Management Controller";
+
+    for (size_t i = 0; i < sizes.associations; ++i)
+    {
+        s.associations_.emplace_back(
+            "/xyz/openbmc_project/inventory/system/chassis/motherboard/dimm" +
+            std::to_string(i));
+    }
+
+    for (size_t i = 0; i < sizes.attributes; ++i)
+    {
+        auto key = "VendorAttribute" + std::to_string(i);
+        if (i % 2)
+        {
+            s.attributes_.emplace(key, static_cast<int64_t>(i));
+        }
+        else
+        {
+            s.attributes_.emplace(key, "Vendor specific value for " + key);
+        }
+    }
+}
+
+class ByValue : public sdbusplus::aserver::bench::Inventory<ByValue>
+{
+  public:
+    ByValue(sdbusplus::async::context& ctx, const char* path,
+            const Sizes& sizes) :
+        sdbusplus::aserver::bench::Inventory<ByValue>(ctx, path)
+    {
+        populate(*this, sizes);
+    }
+
+    auto get_property(pretty_name_t) const
+    {
+        return pretty_name_;
+    }
+
+    auto get_property(associations_t) const
+    {
+        return associations_;
+    }
+
+    auto get_property(attributes_t) const
+    {
+        return attributes_;
+    }
+
+    friend void populate<>(ByValue&, const Sizes&);
+};
+
+class Stored : public sdbusplus::aserver::bench::Inventory<Stored>
+{
+  public:
+    Stored(sdbusplus::async::context& ctx, const char* path,
+           const Sizes& sizes) :
+        sdbusplus::aserver::bench::Inventory<Stored>(ctx, path)
+    {
+        populate(*this, sizes);
+    }
+
+    friend void populate<>(Stored&, const Sizes&);
+};
+
+class View : public sdbusplus::aserver::bench::Inventory<View>
+{
+  public:
+    View(sdbusplus::async::context& ctx, const char* path,
+         const Sizes& sizes) :
+        sdbusplus::aserver::bench::Inventory<View>(ctx, path)
+    {
+        populate(*this, sizes);
+    }
+
+    std::string_view get_property(pretty_name_t) const
+    {
+        return pretty_name_;
+    }
+
+    std::span<const std::string> get_property(associations_t) const
+    {
+        return associations_;
+    }
+
+    const auto& get_property(attributes_t) const
+    {
+        return attributes_;
+    }
+
+    friend void populate<>(View&, const Sizes&);
+};
+
+/* Host the three objects until 'done' is set. */
+void serve(const Sizes& sizes, std::atomic<bool>& done)
+{
+    sdbusplus::async::context ctx;
+
+    ByValue byValue{ctx, "/bench/inventory/by_value", sizes};
+    Stored stored{ctx, "/bench/inventory/stored", sizes};
+    View view{ctx, "/bench/inventory/view", sizes};
+
+    ctx.spawn([](sdbusplus::async::context& ctx,
+                 std::atomic<bool>& done) -> sdbusplus::async::task<> {
+        ctx.request_name(service);
+
+        // request_stop() is only safe from the context's own thread.
+        while (!done)
+        {
+            co_await sdbusplus::async::sleep_for(
+                ctx, std::chrono::milliseconds(10));
+        }
+        ctx.request_stop();
+    }(ctx, done));
+
+    bench::allocations::countThisThread();
+    ctx.run();
+    bench::allocations::countThisThread(false);
+}
+
+nlohmann::json runCase(sdbusplus::bus_t& bus, const std::string& path,
+                       size_t calls)
+{
+    auto getAll = [&bus, &path]() {
+        auto m = bus.new_method_call(service, path.c_str(),
+                                     "org.freedesktop.DBus.Properties",
+                                     "GetAll");
+        m.append(Inventory::interface);
+        return bus.call(m);
+    };
+
+    // Warm up so one-off allocations in the server are not counted.
+    getAll();
+
+    bench::LatencyRecorder recorder;
+    auto before = bench::allocations::totals();
+    auto start = Clock::now();
+
+    for (size_t i = 0; i < calls; ++i)
+    {
+        auto callStart = Clock::now();
+        try
+        {
+            getAll();
+            recorder.record(Clock::now() - callStart);
+        }
+        catch (const std::exception&)
+        {
+            recorder.error();
+        }
+    }
+
+    auto wall = Clock::now() - start;
+    auto after = bench::allocations::totals();
+
+    auto r = recorder.summary(wall);
+    r["allocations_per_getall"] =
+        static_cast<double>(after.count - before.count) /
+        static_cast<double>(calls);
+    r["bytes_per_getall"] = static_cast<double>(after.bytes - before.bytes) /
+                            static_cast<double>(calls);
+    return r;
+}
+
+int main(int argc, const char* argv[])
+{
+    size_t calls = 2000;
+    Sizes sizes;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--calls" && i + 1 < argc)
+        {
+            calls = std::stoul(argv[++i]);
+        }
+        else if (arg == "--associations" && i + 1 < argc)
+        {
+            sizes.associations = std::stoul(argv[++i]);
+        }
+        else if (arg == "--attributes" && i + 1 < argc)
+        {
+            sizes.attributes = std::stoul(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--calls <n>] [--associations <n>]"
+                         " [--attributes <n>]\n";
+            return -1;
+        }
+    }
+
+    bench::PrivateBus privateBus;
+
+    std::atomic<bool> done = false;
+    std::thread server(serve, std::cref(sizes), std::ref(done));
+
+    nlohmann::json results = nlohmann::json::array();
+    if (bench::waitForName(service, std::chrono::seconds(5)))
+    {
+        auto bus = sdbusplus::bus::new_default();
+
+        for (auto variant : {"by_value", "stored", "view"})
+        {
+            std::cerr << variant << "\n";
+
+            auto r = runCase(bus, std::string("/bench/inventory/") + variant,
+                             calls);
+            r["getter"] = variant;
+            results.push_back(std::move(r));
+        }
+    }
+    else
+    {
+        std::cerr << service << " never appeared\n";
+    }
+
+    done = true;
+    server.join();
+
+    if (results.empty())
+    {
+        return 1;
+    }
+
+    std::cout << nlohmann::json{{"benchmark", "getall-alloc"},
+                                {"associations", sizes.associations},
+                                {"attributes", sizes.attributes},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    return 0;
+}
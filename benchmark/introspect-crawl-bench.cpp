@@ -0,0 +1,161 @@
+#include "object_tree.hpp"
+#include "private_bus.hpp"
+
+#include <nlohmann/json.hpp>
+#include <sdbusplus/async.hpp>
+#include <sdbusplus/async/crawler.hpp>
+#include <sdbusplus/bus.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** Start-up time of sdbusplus::async::crawl() against a large service.
+ *
+ *  A bench::ObjectTree of --objects objects is served on its own connection
+ *  and thread.  For each --concurrency (repeatable) it is crawled from
+ *  scratch, on a fresh context, and the time until the model is complete is
+ *  reported with the model's size.
+ *
+ *  usage: introspect-crawl-bench [--objects <n>] [--per-group <n>]
+ *                                [--concurrency <n>]...
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto treeService = "bench.ObjectTree";
+constexpr auto treeRoot = "/bench/tree";
+
+struct Options
+{
+    size_t objects = 50000;
+    size_t per_group = 100;
+    std::vector<size_t> concurrency;
+};
+
+nlohmann::json crawlOnce(const Options& opts, size_t concurrency)
+{
+    sdbusplus::async::context ctx;
+    std::shared_ptr<const sdbusplus::async::object_model> model;
+    std::exception_ptr error;
+
+    auto start = Clock::now();
+    ctx.spawn([](sdbusplus::async::context& ctx, size_t concurrency,
+                 std::shared_ptr<const sdbusplus::async::object_model>& model,
+                 std::exception_ptr& error) -> sdbusplus::async::task<> {
+        sdbusplus::async::crawl_options opts;
+        opts.concurrency = concurrency;
+        try
+        {
+            model = co_await sdbusplus::async::crawl(ctx, treeService, opts);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        ctx.request_stop();
+    }(ctx, concurrency, model, error));
+    ctx.run();
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start);
+
+    if (error || !model)
+    {
+        return {{"concurrency", concurrency}, {"ok", false}};
+    }
+
+    const auto& stats = model->stats();
+    return {
+        {"concurrency", concurrency},
+        {"ok", model->size() >= opts.objects && stats.errors == 0},
+        {"startup_ms", elapsed.count() * 1000},
+        {"objects", model->size()},
+        {"calls", stats.calls},
+        {"errors", stats.errors},
+        {"objects_per_sec", model->size() / elapsed.count()},
+        {"interfaces", model->interface_count()},
+        {"interface_sets", model->interface_sets()},
+    };
+}
+
+int main(int argc, const char* argv[])
+{
+    Options opts;
+    bool usage = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--objects" && i + 1 < argc)
+        {
+            opts.objects = std::stoul(argv[++i]);
+        }
+        else if (arg == "--per-group" && i + 1 < argc)
+        {
+            opts.per_group = std::stoul(argv[++i]);
+        }
+        else if (arg == "--concurrency" && i + 1 < argc)
+        {
+            opts.concurrency.push_back(std::stoul(argv[++i]));
+        }
+        else
+        {
+            usage = true;
+            break;
+        }
+    }
+    if (usage || opts.objects == 0)
+    {
+        std::cerr << "usage: " << argv[0]
+                  << " [--objects <n>] [--per-group <n>]"
+                     " [--concurrency <n>]...\n";
+        return -1;
+    }
+    if (opts.concurrency.empty())
+    {
+        opts.concurrency = {1, 4, 16, 64};
+    }
+
+    bench::PrivateBus privateBus;
+
+    // Serve the tree from its own thread and connection.
+    auto treeBus = sdbusplus::bus::new_default();
+    bench::ObjectTree tree(treeBus, treeRoot, opts.objects, opts.per_group);
+    treeBus.request_name(treeService);
+
+    std::atomic<bool> stop = false;
+    std::thread server([&treeBus, &stop] {
+        while (!stop)
+        {
+            treeBus.process_discard();
+            treeBus.wait(uint64_t{100000});
+        }
+    });
+
+    bool ok = true;
+    nlohmann::json results = nlohmann::json::array();
+    for (auto c : opts.concurrency)
+    {
+        std::cerr << "concurrency " << c << "\n";
+        auto r = crawlOnce(opts, c);
+        ok = ok && r["ok"].get<bool>();
+        results.push_back(std::move(r));
+    }
+
+    stop = true;
+    server.join();
+
+    std::cout << nlohmann::json{{"benchmark", "introspect-crawl"},
+                                {"objects", opts.objects},
+                                {"per_group", opts.per_group},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    return ok ? 0 : 1;
+}
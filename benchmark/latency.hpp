@@ -0,0 +1,92 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace bench
+{
+
+/** Collects per-call latencies and summarizes them as JSON. */
+class LatencyRecorder
+{
+  public:
+    /** @brief Record a completed call. */
+    void record(std::chrono::nanoseconds d)
+    {
+        samples_.push_back(d.count());
+    }
+
+    /** @brief Record a failed call. */
+    void error()
+    {
+        ++errors_;
+    }
+
+    /** @brief Add the samples and errors of another recorder, ex. one
+     *         per thread. */
+    void merge(const LatencyRecorder& other)
+    {
+        samples_.insert(samples_.end(), other.samples_.begin(),
+                        other.samples_.end());
+        errors_ += other.errors_;
+    }
+
+    size_t calls() const
+    {
+        return samples_.size();
+    }
+
+    size_t errors() const
+    {
+        return errors_;
+    }
+
+    /** @brief Summarize the recorded samples.
+     *  @param[in] wall - Wall time the samples were collected over.
+     *  @return - { calls, errors, calls_per_sec, latency_us{...} }.
+     */
+    nlohmann::json summary(std::chrono::nanoseconds wall) const
+    {
+        auto sorted = samples_;
+        std::sort(sorted.begin(), sorted.end());
+
+        // Nearest-rank percentile, reported in microseconds.
+        auto percentile = [&sorted](double p) -> double {
+            if (sorted.empty())
+            {
+                return 0;
+            }
+            auto rank = static_cast<size_t>(
+                std::ceil(p * static_cast<double>(sorted.size())));
+            return static_cast<double>(sorted[std::max<size_t>(rank, 1) - 1]) /
+                   1000.0;
+        };
+
+        auto seconds = std::chrono::duration<double>(wall).count();
+
+        return {
+            {"calls", sorted.size()},
+            {"errors", errors_},
+            {"calls_per_sec",
+             seconds > 0 ? static_cast<double>(sorted.size()) / seconds : 0},
+            {"latency_us",
+             {
+                 {"p50", percentile(0.50)},
+                 {"p99", percentile(0.99)},
+                 {"p999", percentile(0.999)},
+                 {"max", sorted.empty() ? 0 : sorted.back() / 1000.0},
+             }},
+        };
+    }
+
+  private:
+    std::vector<int64_t> samples_;
+    size_t errors_ = 0;
+};
+
+} // namespace bench
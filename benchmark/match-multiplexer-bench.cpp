@@ -0,0 +1,318 @@
+#include "private_bus.hpp"
+
+#include <nlohmann/json.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/bus/match_multiplexer.hpp>
+#include <sdbusplus/bus/signal_receiver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** Per-object signal subscriptions on one connection: a match each against
+ *  sdbusplus::bus::match_multiplexer.
+ *
+ *  An emitter thread sends --signals HelloSignal signals round-robin over
+ *  --objects object paths under /bench/objects, at up to --rate signals/s.
+ *  The receiver subscribes to the first --subscribed objects:
+ *
+ *    per_object  - one bus::match_t per object, as daemons do today; the
+ *                  bus daemon holds and tests one rule per object,
+ *    multiplexed - one match_multiplexer subscription per object, merged
+ *                  into a single path_namespace rule; the daemon forwards
+ *                  every object's signal and the multiplexer routes it by
+ *                  (path, interface, member).
+ *
+ *  Each case reports the broker rules, the time to set the subscriptions up,
+ *  receiver and dbus-daemon CPU per signal received and, for the
+ *  multiplexer, its own counters with the routing cost per message.
+ *
+ *  usage: match-multiplexer-bench [--signals <n>] [--objects <n>]
+ *                                 [--subscribed <n>] [--rate <n/s>]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto subtree = "/bench/objects";
+constexpr auto interface = "com.example.Demo";
+constexpr auto member = "HelloSignal";
+
+struct Options
+{
+    size_t signals = 200000;
+    size_t objects = 1000;
+    size_t subscribed = 500;
+    size_t rate = 100000;
+};
+
+std::string objectPath(size_t i)
+{
+    return std::string(subtree) + "/object" + std::to_string(i);
+}
+
+std::chrono::nanoseconds threadCpu()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds(ts.tv_sec) +
+           std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+/* CPU time 'pid' has been scheduled for. */
+std::chrono::nanoseconds cpuTime(pid_t pid)
+{
+    std::ifstream f("/proc/" + std::to_string(pid) + "/schedstat");
+    uint64_t ns = 0;
+    f >> ns;
+    return std::chrono::nanoseconds(ns);
+}
+
+/* Emit round-robin over the objects, paced to opts.rate. */
+void emit(const Options& opts)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto start = Clock::now();
+
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < opts.objects; ++i)
+    {
+        paths.push_back(objectPath(i));
+    }
+
+    for (size_t i = 0; i < opts.signals; ++i)
+    {
+        auto s = bus.new_signal(paths[i % opts.objects].c_str(), interface,
+                                member);
+        s.append("value " + std::to_string(i));
+        s.signal_send();
+
+        if (opts.rate && i % 64 == 63)
+        {
+            bus.flush();
+            std::this_thread::sleep_until(
+                start + std::chrono::nanoseconds(std::chrono::seconds(1)) *
+                            (i + 1) / opts.rate);
+        }
+    }
+    bus.flush();
+}
+
+/* Signals a receiver subscribed to the first opts.subscribed objects gets. */
+size_t expected(const Options& opts)
+{
+    size_t full = opts.signals / opts.objects;
+    size_t rest = opts.signals % opts.objects;
+    return full * opts.subscribed + std::min(rest, opts.subscribed);
+}
+
+sdbusplus::bus::signal_spec spec(size_t i)
+{
+    return {.path = objectPath(i), .interface = interface, .member = member};
+}
+
+template <typename Setup>
+nlohmann::json runCase(const Options& opts, pid_t daemon, Setup&& setup)
+{
+    auto bus = sdbusplus::bus::new_default();
+    size_t received = 0;
+
+    auto setupStart = Clock::now();
+    auto state = setup(bus, received);
+
+    // Make sure the daemon has every match before anything is sent.
+    auto ping = bus.new_method_call("org.freedesktop.DBus",
+                                    "/org/freedesktop/DBus",
+                                    "org.freedesktop.DBus.Peer", "Ping");
+    bus.call(ping);
+    auto setupTime = Clock::now() - setupStart;
+
+    auto want = expected(opts);
+    auto cpuStart = threadCpu();
+    auto daemonStart = cpuTime(daemon);
+    auto start = Clock::now();
+    std::thread emitter(emit, std::cref(opts));
+
+    auto idleLimit = std::chrono::seconds(2);
+    auto lastProgress = Clock::now();
+    while (received < want && Clock::now() - lastProgress < idleLimit)
+    {
+        auto before = received;
+        while (bus.process_discard())
+        {}
+        if (received != before)
+        {
+            lastProgress = Clock::now();
+        }
+        bus.wait(uint64_t{100000});
+    }
+
+    auto wall = Clock::now() - start;
+    auto cpu = threadCpu() - cpuStart;
+    emitter.join();
+    auto daemonCpu = cpuTime(daemon) - daemonStart;
+
+    auto perSignal = [received](std::chrono::nanoseconds t) {
+        return received ? std::chrono::duration<double, std::micro>(t).count() /
+                              static_cast<double>(received)
+                        : 0;
+    };
+
+    auto seconds = std::chrono::duration<double>(wall).count();
+    return {
+        {"broker_rules", state->rules()},
+        {"setup_ms",
+         std::chrono::duration<double, std::milli>(setupTime).count()},
+        {"received", received},
+        {"expected", want},
+        {"receiver_cpu_us_per_signal", perSignal(cpu)},
+        {"daemon_cpu_us_per_signal", perSignal(daemonCpu)},
+        {"signals_per_sec", seconds > 0 ? received / seconds : 0},
+        {"local", state->local()},
+    };
+}
+
+nlohmann::json runPerObject(const Options& opts, pid_t daemon)
+{
+    struct State
+    {
+        std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+
+        size_t rules() const
+        {
+            return matches.size();
+        }
+
+        nlohmann::json local() const
+        {
+            return nullptr;
+        }
+    };
+
+    return runCase(opts, daemon,
+                   [&opts](sdbusplus::bus_t& bus, size_t& received) {
+                       auto s = std::make_unique<State>();
+                       for (size_t i = 0; i < opts.subscribed; ++i)
+                       {
+                           s->matches.emplace_back(
+                               std::make_unique<sdbusplus::bus::match_t>(
+                                   bus, spec(i).rule(),
+                                   [&received](sdbusplus::message_t&) {
+                                       ++received;
+                                   }));
+                       }
+                       return s;
+                   });
+}
+
+nlohmann::json runMultiplexed(const Options& opts, pid_t daemon)
+{
+    struct State
+    {
+        explicit State(sdbusplus::bus_t& bus) :
+            mux(bus, {.path_namespaces = {subtree}})
+        {}
+
+        sdbusplus::bus::match_multiplexer mux;
+        std::vector<sdbusplus::bus::match_multiplexer::subscription> subs;
+
+        size_t rules() const
+        {
+            return mux.broker_rules();
+        }
+
+        nlohmann::json local() const
+        {
+            const auto& s = mux.stats();
+            return {
+                {"messages", s.messages},
+                {"delivered", s.delivered},
+                {"unrouted", s.unrouted},
+                {"dispatch_ns_per_message",
+                 s.messages ? static_cast<double>(s.dispatch_ns) /
+                                  static_cast<double>(s.messages)
+                            : 0},
+            };
+        }
+    };
+
+    return runCase(opts, daemon,
+                   [&opts](sdbusplus::bus_t& bus, size_t& received) {
+                       auto s = std::make_unique<State>(bus);
+                       for (size_t i = 0; i < opts.subscribed; ++i)
+                       {
+                           s->subs.emplace_back(s->mux.subscribe(
+                               spec(i), [&received](sdbusplus::message_t&) {
+                                   ++received;
+                               }));
+                       }
+                       return s;
+                   });
+}
+
+int main(int argc, const char* argv[])
+{
+    Options opts;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--signals" && i + 1 < argc)
+        {
+            opts.signals = std::stoul(argv[++i]);
+        }
+        else if (arg == "--objects" && i + 1 < argc)
+        {
+            opts.objects = std::stoul(argv[++i]);
+        }
+        else if (arg == "--subscribed" && i + 1 < argc)
+        {
+            opts.subscribed = std::stoul(argv[++i]);
+        }
+        else if (arg == "--rate" && i + 1 < argc)
+        {
+            opts.rate = std::stoul(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--signals <n>] [--objects <n>] [--subscribed <n>]"
+                         " [--rate <n/s>]\n";
+            return -1;
+        }
+    }
+    opts.objects = std::max<size_t>(opts.objects, 1);
+    opts.subscribed = std::min(opts.subscribed, opts.objects);
+
+    bench::PrivateBus privateBus;
+
+    nlohmann::json results = nlohmann::json::array();
+
+    std::cerr << "per_object\n";
+    auto perObject = runPerObject(opts, privateBus.daemonPid());
+    perObject["receiver"] = "per_object";
+    results.push_back(std::move(perObject));
+
+    std::cerr << "multiplexed\n";
+    auto multiplexed = runMultiplexed(opts, privateBus.daemonPid());
+    multiplexed["receiver"] = "multiplexed";
+    results.push_back(std::move(multiplexed));
+
+    std::cout << nlohmann::json{{"benchmark", "match-multiplexer"},
+                                {"signals", opts.signals},
+                                {"objects", opts.objects},
+                                {"subscribed", opts.subscribed},
+                                {"rate", opts.rate},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,262 @@
+#include "latency.hpp"
+#include "object_tree.hpp"
+#include "private_bus.hpp"
+
+#include <nlohmann/json.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+/** Cold start and query latency of object-mapper.
+ *
+ *  A bench::ObjectTree of --objects objects (--per-group to a group, every
+ *  --rare-every'th with a second interface) is served on its own
+ *  connection.  The mapper is then started and timed until GetObject finds
+ *  the last object.  Then --queries calls of each kind are timed:
+ *
+ *    get_object         - GetObject on a random object, no filter,
+ *    subtree_group      - GetSubTree of a random group, filtered on the
+ *                         interface every object has,
+ *    subtree_paths_rare - GetSubTreePaths of the whole tree, filtered on the
+ *                         rare interface, answered from the inverted index.
+ *
+ *  Latencies are round trips through the bus; the mapper's own handler
+ *  times, from its xyz.openbmc_project.Debug.MethodStats object, are
+ *  reported alongside.
+ *
+ *  usage: object-mapper-bench --mapper <object-mapper> [--objects <n>]
+ *                             [--per-group <n>] [--rare-every <n>]
+ *                             [--queries <n>]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto treeService = "bench.ObjectTree";
+constexpr auto treeRoot = "/bench/tree";
+constexpr auto mapperService = "xyz.openbmc_project.ObjectMapper";
+constexpr auto mapperPath = "/xyz/openbmc_project/object_mapper";
+constexpr auto mapperInterface = "xyz.openbmc_project.ObjectMapper";
+
+struct Options
+{
+    std::string mapper;
+    size_t objects = 100000;
+    size_t per_group = 100;
+    size_t rare_every = 1000;
+    size_t queries = 2000;
+};
+
+using Interfaces = std::vector<std::string>;
+using ObjectInfo = std::map<std::string, Interfaces>;
+using SubTree = std::map<std::string, ObjectInfo>;
+
+sdbusplus::message_t mapperCall(sdbusplus::bus_t& bus, const char* method)
+{
+    return bus.new_method_call(mapperService, mapperPath, mapperInterface,
+                               method);
+}
+
+/* Time `call` opts.queries times; it returns the number of results. */
+nlohmann::json runQueries(const Options& opts, size_t expected,
+                          const std::function<size_t(size_t)>& call)
+{
+    bench::LatencyRecorder recorder;
+    auto start = Clock::now();
+
+    for (size_t i = 0; i < opts.queries; ++i)
+    {
+        auto callStart = Clock::now();
+        try
+        {
+            auto n = call(i);
+            if (n != expected)
+            {
+                recorder.error();
+                continue;
+            }
+            recorder.record(Clock::now() - callStart);
+        }
+        catch (const sdbusplus::exception::SdBusError&)
+        {
+            recorder.error();
+        }
+    }
+
+    auto result = recorder.summary(Clock::now() - start);
+    result["results_per_call"] = expected;
+    return result;
+}
+
+int main(int argc, const char* argv[])
+{
+    Options opts;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--mapper" && i + 1 < argc)
+        {
+            opts.mapper = argv[++i];
+        }
+        else if (arg == "--objects" && i + 1 < argc)
+        {
+            opts.objects = std::stoul(argv[++i]);
+        }
+        else if (arg == "--per-group" && i + 1 < argc)
+        {
+            opts.per_group = std::stoul(argv[++i]);
+        }
+        else if (arg == "--rare-every" && i + 1 < argc)
+        {
+            opts.rare_every = std::stoul(argv[++i]);
+        }
+        else if (arg == "--queries" && i + 1 < argc)
+        {
+            opts.queries = std::stoul(argv[++i]);
+        }
+        else
+        {
+            opts.mapper.clear();
+            break;
+        }
+    }
+    if (opts.mapper.empty() || opts.objects == 0)
+    {
+        std::cerr << "usage: " << argv[0]
+                  << " --mapper <object-mapper> [--objects <n>]"
+                     " [--per-group <n>] [--rare-every <n>] [--queries <n>]\n";
+        return -1;
+    }
+    opts.per_group = std::max<size_t>(opts.per_group, 1);
+    opts.rare_every = std::max<size_t>(opts.rare_every, 1);
+
+    bench::PrivateBus privateBus;
+
+    // Serve the tree from its own thread and connection.
+    auto treeBus = sdbusplus::bus::new_default();
+    bench::ObjectTree tree(treeBus, treeRoot, opts.objects, opts.per_group,
+                           opts.rare_every);
+    treeBus.request_name(treeService);
+
+    std::atomic<bool> stop = false;
+    std::thread server([&treeBus, &stop] {
+        while (!stop)
+        {
+            treeBus.process_discard();
+            treeBus.wait(uint64_t{100000});
+        }
+    });
+
+    auto bus = sdbusplus::bus::new_default();
+
+    // Cold start: until the mapper knows the last object.
+    std::cerr << "cold start\n";
+    auto start = Clock::now();
+    bench::ChildProcess mapper({opts.mapper});
+    bool named = bench::waitForName(mapperService, std::chrono::seconds(10));
+    auto nameTime = Clock::now() - start;
+
+    bool indexed = false;
+    auto last = tree.path(opts.objects - 1);
+    while (named && Clock::now() - start < std::chrono::seconds(60))
+    {
+        try
+        {
+            auto m = mapperCall(bus, "GetObject");
+            m.append(last, Interfaces{});
+            bus.call(m);
+            indexed = true;
+            break;
+        }
+        catch (const sdbusplus::exception::SdBusError&)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    auto indexTime = Clock::now() - start;
+
+    nlohmann::json results = nlohmann::json::object();
+    results["cold_start"] = {
+        {"indexed", indexed},
+        {"name_ms",
+         std::chrono::duration<double, std::milli>(nameTime).count()},
+        {"indexed_ms",
+         std::chrono::duration<double, std::milli>(indexTime).count()},
+    };
+
+    if (indexed)
+    {
+        std::mt19937_64 rng(1);
+
+        std::cerr << "get_object\n";
+        results["get_object"] = runQueries(opts, 1, [&](size_t) {
+            auto m = mapperCall(bus, "GetObject");
+            m.append(tree.path(rng() % opts.objects), Interfaces{});
+            return bus.call(m).unpack<ObjectInfo>().size();
+        });
+
+        std::cerr << "subtree_group\n";
+        results["subtree_group"] = runQueries(
+            opts, std::min(opts.per_group, opts.objects), [&](size_t) {
+                auto m = mapperCall(bus, "GetSubTree");
+                // The last group may be short; stay clear of it.
+                auto groups = std::max<size_t>(opts.objects / opts.per_group,
+                                               1);
+                m.append(tree.group(rng() % groups), int32_t{0},
+                         Interfaces{bench::ObjectTree::interface});
+                return bus.call(m).unpack<SubTree>().size();
+            });
+
+        std::cerr << "subtree_paths_rare\n";
+        results["subtree_paths_rare"] =
+            runQueries(opts, tree.rare(), [&](size_t) {
+                auto m = mapperCall(bus, "GetSubTreePaths");
+                m.append(treeRoot, int32_t{0},
+                         Interfaces{bench::ObjectTree::rare_interface});
+                return bus.call(m).unpack<Interfaces>().size();
+            });
+
+        try
+        {
+            auto m = bus.new_method_call(
+                mapperService, "/xyz/openbmc_project/debug/methods",
+                "org.freedesktop.DBus.Properties", "Get");
+            m.append("xyz.openbmc_project.Debug.MethodStats",
+                     "HandlerTimeUs");
+            using Summary =
+                std::map<std::string, std::map<std::string, double>>;
+            results["mapper_handler_time_us"] = std::get<Summary>(
+                bus.call(m).unpack<std::variant<Summary>>());
+        }
+        catch (const sdbusplus::exception::SdBusError& e)
+        {
+            std::cerr << "MethodStats: " << e.what() << "\n";
+        }
+    }
+
+    stop = true;
+    server.join();
+
+    std::cout << nlohmann::json{{"benchmark", "object-mapper"},
+                                {"objects", opts.objects},
+                                {"per_group", opts.per_group},
+                                {"rare_every", opts.rare_every},
+                                {"queries", opts.queries},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    return indexed ? 0 : 1;
+}
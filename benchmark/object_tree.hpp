@@ -0,0 +1,235 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/slot.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+
+/** A large synthetic object tree, served without per-object registration.
+ *
+ *  Objects are <root>/group<g>/item<i>, `per_group` to a group.  Every item
+ *  implements `interface`, and every `rare_every`th one `rare_interface`
+ *  too.  Both are fallback vtables resolved by parsing the path, and a node
+ *  enumerator lists the tree, so a hundred thousand objects cost no more
+ *  memory than ten and show up in GetManagedObjects and Introspect like
+ *  any others.  An object manager is added at "/".
+ */
+class ObjectTree
+{
+  public:
+    static constexpr auto interface = "bench.ObjectTree.Item";
+    static constexpr auto rare_interface = "bench.ObjectTree.Rare";
+
+    ObjectTree() = delete;
+    ObjectTree(const ObjectTree&) = delete;
+    ObjectTree& operator=(const ObjectTree&) = delete;
+    ObjectTree(ObjectTree&&) = delete;
+    ObjectTree& operator=(ObjectTree&&) = delete;
+    ~ObjectTree() = default;
+
+    ObjectTree(sdbusplus::bus_t& bus, std::string root, size_t objects,
+               size_t per_group = 100, size_t rare_every = 1000) :
+        root_(std::move(root)), objects_(objects),
+        per_group_(std::max<size_t>(per_group, 1)),
+        rare_every_(std::max<size_t>(rare_every, 1))
+    {
+        sd_bus_slot* s = nullptr;
+        check(sd_bus_add_object_manager(bus.get(), &s, "/"),
+              "sd_bus_add_object_manager");
+        slots_.emplace_back(s);
+
+        check(sd_bus_add_fallback_vtable(bus.get(), &s, root_.c_str(),
+                                         interface, vtable, findItem, this),
+              "sd_bus_add_fallback_vtable");
+        slots_.emplace_back(s);
+
+        check(sd_bus_add_fallback_vtable(bus.get(), &s, root_.c_str(),
+                                         rare_interface, vtable, findRare,
+                                         this),
+              "sd_bus_add_fallback_vtable");
+        slots_.emplace_back(s);
+
+        check(sd_bus_add_node_enumerator(bus.get(), &s, root_.c_str(),
+                                         enumerate, this),
+              "sd_bus_add_node_enumerator");
+        slots_.emplace_back(s);
+    }
+
+    const std::string& root() const
+    {
+        return root_;
+    }
+
+    size_t objects() const
+    {
+        return objects_;
+    }
+
+    size_t groups() const
+    {
+        return (objects_ + per_group_ - 1) / per_group_;
+    }
+
+    /** @return - How many objects implement rare_interface. */
+    size_t rare() const
+    {
+        return objects_ ? (objects_ - 1) / rare_every_ + 1 : 0;
+    }
+
+    std::string group(size_t g) const
+    {
+        return root_ + "/group" + std::to_string(g);
+    }
+
+    std::string path(size_t i) const
+    {
+        return group(i / per_group_) + "/item" +
+               std::to_string(i % per_group_);
+    }
+
+  private:
+    static constexpr sdbusplus::vtable::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::end(),
+    };
+
+    static void check(int r, const char* what)
+    {
+        if (r < 0)
+        {
+            throw sdbusplus::exception::SdBusError(-r, what);
+        }
+    }
+
+    /* Parse a decimal number following `prefix` at the front of `s`. */
+    static std::optional<size_t> number(std::string_view& s,
+                                        std::string_view prefix)
+    {
+        if (!s.starts_with(prefix))
+        {
+            return std::nullopt;
+        }
+        s.remove_prefix(prefix.size());
+        size_t n = 0;
+        auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), n);
+        if (ec != std::errc{} || end == s.data())
+        {
+            return std::nullopt;
+        }
+        s.remove_prefix(end - s.data());
+        return n;
+    }
+
+    /* The item index of `path`, if it is one. */
+    std::optional<size_t> item(std::string_view path) const
+    {
+        if (!path.starts_with(root_))
+        {
+            return std::nullopt;
+        }
+        path.remove_prefix(root_.size());
+
+        auto g = number(path, "/group");
+        auto i = g ? number(path, "/item") : std::nullopt;
+        if (!i || !path.empty() || *i >= per_group_)
+        {
+            return std::nullopt;
+        }
+
+        auto n = *g * per_group_ + *i;
+        if (n >= objects_)
+        {
+            return std::nullopt;
+        }
+        return n;
+    }
+
+    static int findItem(sd_bus*, const char* path, const char*, void* data,
+                        void** found, sd_bus_error*)
+    {
+        auto* self = static_cast<ObjectTree*>(data);
+        *found = self;
+        return self->item(path) ? 1 : 0;
+    }
+
+    static int findRare(sd_bus*, const char* path, const char*, void* data,
+                        void** found, sd_bus_error*)
+    {
+        auto* self = static_cast<ObjectTree*>(data);
+        auto i = self->item(path);
+        *found = self;
+        return i && *i % self->rare_every_ == 0 ? 1 : 0;
+    }
+
+    /* The groups under the root, or the items under a group. */
+    static int enumerate(sd_bus*, const char* prefix, void* data,
+                         char*** nodes, sd_bus_error*)
+    {
+        auto* self = static_cast<ObjectTree*>(data);
+        std::vector<std::string> paths;
+
+        std::string_view p = prefix;
+        if (p == self->root_ || self->root_.starts_with(p))
+        {
+            for (size_t g = 0; g < self->groups(); ++g)
+            {
+                paths.emplace_back(self->group(g));
+            }
+            for (size_t i = 0; i < self->objects_; ++i)
+            {
+                paths.emplace_back(self->path(i));
+            }
+        }
+        else if (p.starts_with(self->root_))
+        {
+            p.remove_prefix(self->root_.size());
+            auto g = number(p, "/group");
+            if (g && p.empty())
+            {
+                for (size_t i = *g * self->per_group_;
+                     i < std::min((*g + 1) * self->per_group_, self->objects_);
+                     ++i)
+                {
+                    paths.emplace_back(self->path(i));
+                }
+            }
+        }
+
+        auto** strv =
+            static_cast<char**>(calloc(paths.size() + 1, sizeof(char*)));
+        if (strv == nullptr)
+        {
+            return -ENOMEM;
+        }
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            strv[i] = strdup(paths[i].c_str());
+        }
+        *nodes = strv;
+        return 0;
+    }
+
+    std::string root_;
+    size_t objects_;
+    size_t per_group_;
+    size_t rare_every_;
+    std::vector<sdbusplus::slot_t> slots_;
+};
+
+} // namespace bench
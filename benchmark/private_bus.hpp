@@ -0,0 +1,168 @@
+#pragma once
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <sdbusplus/bus.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace bench
+{
+
+/** A child process which is terminated when this object is destroyed. */
+class ChildProcess
+{
+  public:
+    ChildProcess() = delete;
+    ChildProcess(const ChildProcess&) = delete;
+    ChildProcess& operator=(const ChildProcess&) = delete;
+    ChildProcess(ChildProcess&&) = delete;
+    ChildProcess& operator=(ChildProcess&&) = delete;
+
+    /** @brief Fork and exec a program.
+     *  @param[in] argv - Program followed by its arguments.
+     */
+    explicit ChildProcess(const std::vector<std::string>& argv)
+    {
+        std::vector<char*> args;
+        for (const auto& a : argv)
+        {
+            args.push_back(const_cast<char*>(a.c_str()));
+        }
+        args.push_back(nullptr);
+
+        pid_ = fork();
+        if (pid_ < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "fork");
+        }
+        if (pid_ == 0)
+        {
+            execvp(args[0], args.data());
+            _exit(127);
+        }
+    }
+
+    ~ChildProcess()
+    {
+        kill(pid_, SIGTERM);
+        waitpid(pid_, nullptr, 0);
+    }
+
+    pid_t pid() const
+    {
+        return pid_;
+    }
+
+  private:
+    pid_t pid_ = -1;
+};
+
+/** A dbus-daemon owned by the benchmark.
+ *
+ *  The daemon is started with the session configuration and listens on a
+ *  fresh socket under /tmp.  Once it is up, DBUS_STARTER_ADDRESS,
+ *  DBUS_SESSION_BUS_ADDRESS and DBUS_SYSTEM_BUS_ADDRESS all point at it, so
+ *  `new_default()`, `new_system()` and every child process spawned afterwards
+ *  end up on the private bus instead of the host's.
+ */
+class PrivateBus
+{
+  public:
+    PrivateBus() : PrivateBus(readyPipe()) {}
+
+    const std::string& address() const
+    {
+        return address_;
+    }
+
+    pid_t daemonPid() const
+    {
+        return daemon_.pid();
+    }
+
+  private:
+    struct Pipe
+    {
+        int read;
+        int write;
+    };
+
+    static Pipe readyPipe()
+    {
+        int fds[2];
+        if (pipe(fds) < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "pipe");
+        }
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        return {fds[0], fds[1]};
+    }
+
+    explicit PrivateBus(Pipe p) :
+        daemon_({"dbus-daemon", "--session", "--nofork",
+                 "--address=unix:tmpdir=/tmp",
+                 "--print-address=" + std::to_string(p.write)})
+    {
+        close(p.write);
+
+        char c = 0;
+        while (read(p.read, &c, 1) == 1 && c != '\n')
+        {
+            address_ += c;
+        }
+        close(p.read);
+
+        if (address_.empty())
+        {
+            throw std::runtime_error("dbus-daemon did not report an address");
+        }
+
+        setenv("DBUS_STARTER_ADDRESS", address_.c_str(), 1);
+        setenv("DBUS_SESSION_BUS_ADDRESS", address_.c_str(), 1);
+        setenv("DBUS_SYSTEM_BUS_ADDRESS", address_.c_str(), 1);
+        unsetenv("DBUS_STARTER_BUS_TYPE");
+    }
+
+    ChildProcess daemon_;
+    std::string address_;
+};
+
+/** @brief Wait for a well-known name to be (un)owned on the default bus.
+ *  @param[in] name - The bus name to wait for.
+ *  @param[in] timeout - How long to keep polling.
+ *  @param[in] owned - Wait for the name to appear (true) or vanish (false).
+ *  @return - true if the name reached the requested state in time.
+ */
+inline bool waitForName(const std::string& name,
+                        std::chrono::milliseconds timeout, bool owned = true)
+{
+    auto b = sdbusplus::bus::new_default();
+    auto until = std::chrono::steady_clock::now() + timeout;
+
+    while (std::chrono::steady_clock::now() < until)
+    {
+        auto m = b.new_method_call("org.freedesktop.DBus",
+                                   "/org/freedesktop/DBus",
+                                   "org.freedesktop.DBus", "NameHasOwner");
+        m.append(name);
+        if (b.call(m).unpack<bool>() == owned)
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+} // namespace bench
@@ -0,0 +1,145 @@
+#include "alloc_counter.hpp"
+#include "private_bus.hpp"
+
+#include <bench/PropertyDispatch/common.hpp>
+#include <bench/PropertyDispatch/server.hpp>
+#include <benchmark/benchmark.h>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** Decodes a GetAll reply of bench.PropertyDispatch's 64 properties into
+ *  its generated properties_t, three ways:
+ *
+ *    vector_linear - unpack a std::vector of name and PropertiesVariant
+ *                    pairs, then find each name with a chain of compares,
+ *                    as generated clients used to,
+ *    vector_slot   - the same vector, with each name found through
+ *                    property_slot(), as the generated properties() now
+ *                    does,
+ *    in_place      - the generated read_properties(), which walks the
+ *                    a{sv} without copying names or building variants.
+ *
+ *  The vector cases only find each value; they do not copy it into
+ *  properties_t, which flatters them slightly.  Each case runs on a reply
+ *  holding just the interface's properties (/0) and on one followed by 16
+ *  unknown properties (/16).  "allocs_per_decode" counts operator new
+ *  calls per decode.
+ */
+
+using PropertyDispatch = sdbusplus::common::bench::PropertyDispatch;
+namespace details = sdbusplus::common::bench::details;
+using Entries =
+    std::vector<std::pair<std::string, PropertyDispatch::PropertiesVariant>>;
+
+static sdbusplus::bus_t* bus = nullptr;
+
+/* A sealed GetAll reply: every property, then 'unknown' others. */
+static sdbusplus::message_t reply(size_t unknown)
+{
+    sdbusplus::server::bench::PropertyDispatch server(*bus,
+                                                      "/bench/properties");
+
+    Entries entries;
+    for (auto name : details::propertySlotsPropertyDispatch)
+    {
+        entries.emplace_back(std::string{name},
+                             server.getPropertyByName(name));
+    }
+    for (size_t i = 0; i < unknown; ++i)
+    {
+        entries.emplace_back("VendorSpecificReading" + std::to_string(i),
+                             1.0);
+    }
+
+    auto m = bus->new_method_call("bench.Properties", "/bench/properties",
+                                  "org.freedesktop.DBus.Properties", "GetAll");
+    m.append(entries);
+    if (auto r = sd_bus_message_seal(m.get(), 1, 0); r < 0)
+    {
+        throw sdbusplus::exception::SdBusError(-r, "sd_bus_message_seal");
+    }
+    return m;
+}
+
+static void vectorLinear(sdbusplus::message_t& m,
+                         PropertyDispatch::properties_t&)
+{
+    for (const auto& [name, value] : m.unpack<Entries>())
+    {
+        for (auto slot : details::propertySlotsPropertyDispatch)
+        {
+            if (name == slot)
+            {
+                benchmark::DoNotOptimize(value);
+                break;
+            }
+        }
+    }
+}
+
+static void vectorSlot(sdbusplus::message_t& m,
+                       PropertyDispatch::properties_t&)
+{
+    for (const auto& [name, value] : m.unpack<Entries>())
+    {
+        if (PropertyDispatch::property_slot(name))
+        {
+            benchmark::DoNotOptimize(value);
+        }
+    }
+}
+
+static void inPlace(sdbusplus::message_t& m,
+                    PropertyDispatch::properties_t& result)
+{
+    PropertyDispatch::read_properties(m, result);
+}
+
+template <typename Decode>
+static void decode(benchmark::State& state, Decode d)
+{
+    auto unknown = static_cast<size_t>(state.range(0));
+    auto m = reply(unknown);
+
+    bench::allocations::countThisThread();
+    auto before = bench::allocations::totals();
+    for (auto _ : state)
+    {
+        sd_bus_message_rewind(m.get(), true);
+        PropertyDispatch::properties_t result;
+        d(m, result);
+        benchmark::DoNotOptimize(result);
+    }
+    auto after = bench::allocations::totals();
+    bench::allocations::countThisThread(false);
+
+    state.counters["allocs_per_decode"] =
+        benchmark::Counter(static_cast<double>(after.count - before.count),
+                           benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(static_cast<int64_t>(
+        state.iterations() *
+        (details::propertySlotsPropertyDispatch.size() + unknown)));
+}
+
+BENCHMARK_CAPTURE(decode, vector_linear, vectorLinear)->Arg(0)->Arg(16);
+BENCHMARK_CAPTURE(decode, vector_slot, vectorSlot)->Arg(0)->Arg(16);
+BENCHMARK_CAPTURE(decode, in_place, inPlace)->Arg(0)->Arg(16);
+
+int main(int argc, char** argv)
+{
+    bench::PrivateBus privateBus;
+    auto b = sdbusplus::bus::new_default();
+    bus = &b;
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <bench/PropertyDispatch/common.hpp>
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/** Compares the generated perfect-hash property lookup against the chain of
+ *  string compares that setPropertyByName/getPropertyByName used to emit.
+ */
+
+using PropertyDispatch = sdbusplus::common::bench::PropertyDispatch;
+namespace details = sdbusplus::common::bench::details;
+
+// One compare per property until a match, like the old
+// 'if (_name == "...")' chain.
+static std::optional<size_t> linearChain(const std::string& name)
+{
+    for (size_t i = 0; i < details::propertySlotsPropertyDispatch.size(); ++i)
+    {
+        if (name == details::propertySlotsPropertyDispatch[i])
+        {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+static std::optional<size_t> perfectHash(const std::string& name)
+{
+    return PropertyDispatch::property_slot(name);
+}
+
+/* Look up every property once, plus one unknown name, per iteration. */
+template <typename Lookup>
+static void dispatchAll(benchmark::State& state, Lookup lookup)
+{
+    std::vector<std::string> names(
+        details::propertySlotsPropertyDispatch.begin(),
+        details::propertySlotsPropertyDispatch.end());
+    names.emplace_back("NotAProperty");
+
+    for (auto _ : state)
+    {
+        for (const auto& n : names)
+        {
+            benchmark::DoNotOptimize(lookup(n));
+        }
+    }
+    state.SetItemsProcessed(
+        static_cast<int64_t>(state.iterations() * names.size()));
+}
+
+BENCHMARK_CAPTURE(dispatchAll, linear_chain, linearChain);
+BENCHMARK_CAPTURE(dispatchAll, perfect_hash, perfectHash);
+
+BENCHMARK_MAIN();
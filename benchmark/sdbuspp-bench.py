@@ -0,0 +1,301 @@
+#!/usr/bin/env python3
+
+"""Wall time of sdbus++ code generation, one process per output against
+--batch.
+
+Two trees are generated: the calculator's YAML and a synthetic tree of
+--interfaces interfaces, each with properties, an enum, methods and a
+signal.  For each tree:
+
+    per_process        - one sdbus++ process per interface and output, as
+                         sdbus++-gen-meson used to run; measured on
+                         --sample interfaces and projected to the whole
+                         tree,
+    per_process_cached - the same, sharing a cache directory that already
+                         holds the compiled templates and parsed YAML,
+    batch              - one 'sdbus++ --batch --jobs 1', cold cache,
+    cached             - 'batch' again from a clean output directory, with
+                         the templates and YAML it cached: a clean build
+                         with $SDBUSPP_CACHE_DIR set,
+    parallel           - one 'sdbus++ --batch --jobs <--jobs>', cold cache,
+    warm               - 'parallel' again on its cache: every output
+                         unchanged,
+    one_changed        - 'parallel' again after one YAML changed.
+
+With --history, one line per run is appended to that file, holding the
+commit and every mode's ms_per_interface for the synthetic tree, and the
+change from the previous line is printed; keep the file across commits to
+track the generator's cost over time.
+
+usage: sdbuspp-bench.py [--sdbuspp <path>] [--calculator <yaml-dir>]
+                        [--interfaces <n>] [--sample <n>] [--jobs <n>]
+                        [--history <file>]
+"""
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+OUTPUTS = [
+    ("common-header", "common.hpp"),
+    ("server-header", "server.hpp"),
+    ("server-cpp", "server.cpp"),
+    ("client-header", "client.hpp"),
+    ("aserver-header", "aserver.hpp"),
+]
+
+
+def synthesize(root, count):
+    """Write 'count' interfaces under root/bench/synthetic."""
+    d = os.path.join(root, "bench", "synthetic")
+    os.makedirs(d, exist_ok=True)
+    for i in range(count):
+        with open(os.path.join(d, "Iface%03d.interface.yaml" % i), "w") as f:
+            f.write(
+                """description: Synthetic interface %(i)d.
+properties:
+    - name: Name
+      type: string
+      description: A name.
+    - name: Value
+      type: int64
+      description: A value.
+    - name: Limits
+      type: dict[string, struct[double, double]]
+      description: Per-channel limits.
+    - name: Mode
+      type: enum[self.Mode]
+      default: Idle
+      description: The mode.
+methods:
+    - name: Reset
+      description: Reset the value.
+    - name: Scale
+      parameters:
+          - name: Factor
+            type: double
+            description: The factor.
+      returns:
+          - name: Result
+            type: int64
+            description: The scaled value.
+signals:
+    - name: Changed
+      properties:
+          - name: Value
+            type: int64
+            description: The new value.
+      description: The value changed.
+enumerations:
+    - name: Mode
+      description: Modes.
+      values:
+          - name: Idle
+            description: Idle.
+          - name: Busy
+            description: Busy.
+"""
+                % {"i": i}
+            )
+    return ["bench.synthetic.Iface%03d" % i for i in range(count)]
+
+
+def batchfile(path, outdir, items):
+    with open(path, "w") as f:
+        for item in items:
+            for process, output in OUTPUTS:
+                f.write(
+                    "interface %s %s %s\n"
+                    % (
+                        process,
+                        item,
+                        os.path.join(outdir, item.replace(".", "/"), output),
+                    )
+                )
+
+
+def timed(cmd, **kwargs):
+    start = time.monotonic()
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL, **kwargs)
+    return time.monotonic() - start
+
+
+def measure(sdbuspp, root, items, sample, jobs, work):
+    result = {"interfaces": len(items), "outputs": len(items) * len(OUTPUTS)}
+
+    # One process per output, on a sample.
+    sampled = items[:sample]
+
+    def per_process(name, cache):
+        elapsed = 0.0
+        for item in sampled:
+            for process, _ in OUTPUTS:
+                elapsed += timed(
+                    [sdbuspp, "-r", root, "interface", process, item],
+                    env=dict(os.environ, SDBUSPP_CACHE_DIR=cache),
+                )
+        per_output = elapsed / max(1, len(sampled) * len(OUTPUTS))
+        result[name] = {
+            "sampled_interfaces": len(sampled),
+            "ms_per_output": per_output * 1000,
+            "ms_per_interface": per_output * 1000 * len(OUTPUTS),
+            "projected_s": per_output * result["outputs"],
+        }
+
+    per_process("per_process", "")
+    # The first pass fills the cache; time the second.
+    cache = os.path.join(work, "cache-per-process")
+    per_process("per_process_cached", cache)
+    per_process("per_process_cached", cache)
+
+    jobsfile = os.path.join(work, "jobs")
+    batchfile(jobsfile, os.path.join(work, "out"), items)
+
+    def batch(name, cache, n):
+        result[name] = {
+            "s": timed(
+                [sdbuspp, "-r", root, "--batch", jobsfile, "--jobs", str(n)]
+                + ["--cache-dir", os.path.join(work, cache)]
+            )
+        }
+        result[name]["ms_per_interface"] = (
+            result[name]["s"] * 1000 / max(1, len(items))
+        )
+
+    batch("batch", "cache-batch", 1)
+
+    # Forget the outputs, keep the compiled templates and parsed YAML.
+    shutil.rmtree(os.path.join(work, "out"))
+    shutil.rmtree(os.path.join(work, "cache-batch", "stamps"))
+    batch("cached", "cache-batch", 1)
+
+    shutil.rmtree(os.path.join(work, "out"))
+    batch("parallel", "cache-parallel", jobs)
+    batch("warm", "cache-parallel", jobs)
+
+    # Change one interface's YAML; only its outputs are regenerated.
+    first = os.path.join(root, items[0].replace(".", "/") + ".interface.yaml")
+    with open(first) as f:
+        original = f.read()
+    try:
+        with open(first, "w") as f:
+            f.write(original + "# changed\n")
+        batch("one_changed", "cache-parallel", jobs)
+    finally:
+        with open(first, "w") as f:
+            f.write(original)
+
+    return result
+
+
+def commit(path):
+    try:
+        return subprocess.run(
+            ["git", "-C", path, "describe", "--always", "--dirty"],
+            check=True,
+            capture_output=True,
+            text=True,
+        ).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def record(history, commit, results):
+    """Append this run to 'history' and report against the previous one."""
+    entry = {
+        "commit": commit,
+        "time": int(time.time()),
+        "interfaces": results["interfaces"],
+        "ms_per_interface": {
+            mode: r["ms_per_interface"]
+            for mode, r in results.items()
+            if isinstance(r, dict) and "ms_per_interface" in r
+        },
+    }
+
+    previous = None
+    try:
+        with open(history) as f:
+            lines = [line for line in f if line.strip()]
+            if lines:
+                previous = json.loads(lines[-1])
+    except (OSError, ValueError):
+        pass
+
+    with open(history, "a") as f:
+        f.write(json.dumps(entry) + "\n")
+
+    if not previous or previous.get("interfaces") != entry["interfaces"]:
+        return
+    for mode, ms in sorted(entry["ms_per_interface"].items()):
+        before = previous["ms_per_interface"].get(mode)
+        if before:
+            print(
+                "%-20s %9.2f ms/interface  %+6.1f%% since %s"
+                % (mode, ms, (ms - before) * 100 / before, previous["commit"]),
+                file=sys.stderr,
+            )
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument(
+        "--sdbuspp", default=os.path.join(here, "..", "tools", "sdbus++")
+    )
+    parser.add_argument(
+        "--calculator", default=os.path.join(here, "..", "calculator", "yaml")
+    )
+    parser.add_argument("--interfaces", type=int, default=500)
+    parser.add_argument("--sample", type=int, default=20)
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--history")
+    args = parser.parse_args()
+
+    results = {}
+    with tempfile.TemporaryDirectory() as work:
+        # A copy, since 'one_changed' edits the YAML.
+        calculator = os.path.join(work, "calculator")
+        shutil.copytree(args.calculator, os.path.join(calculator, "yaml"))
+        print("calculator", file=sys.stderr)
+        results["calculator"] = measure(
+            args.sdbuspp,
+            os.path.join(calculator, "yaml"),
+            ["net.poettering.Calculator"],
+            args.sample,
+            args.jobs,
+            calculator,
+        )
+
+        synthetic = os.path.join(work, "synthetic")
+        yaml = os.path.join(synthetic, "yaml")
+        items = synthesize(yaml, args.interfaces)
+        print("synthetic", file=sys.stderr)
+        results["synthetic"] = measure(
+            args.sdbuspp, yaml, items, args.sample, args.jobs, synthetic
+        )
+
+    revision = commit(here)
+    if args.history:
+        record(args.history, revision, results["synthetic"])
+
+    print(
+        json.dumps(
+            {
+                "benchmark": "sdbuspp",
+                "commit": revision,
+                "jobs": args.jobs,
+                "results": results,
+            },
+            indent=4,
+        )
+    )
+
+
+if __name__ == "__main__":
+    main()
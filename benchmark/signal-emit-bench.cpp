@@ -0,0 +1,264 @@
+#include "private_bus.hpp"
+
+#include <nlohmann/json.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/signal_receiver.hpp>
+#include <sdbusplus/server/signal_burst.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/** Emitter cost of a high-rate signal stream.
+ *
+ *  --signals HelloSignal(s key, s value) signals are sent round-robin over
+ *  --keys keys, to a receiver on its own connection that counts them:
+ *
+ *    per-signal - emit-signal/emit_signal.cpp's approach: new_signal, append
+ *                 std::string copies, signal_send, for every signal,
+ *    burst      - sdbusplus::server::signal_burst, string_view arguments,
+ *                 --burst signals queued per flush(),
+ *    prebuilt   - one signal per key built up front with
+ *                 signal_burst::prebuilt() and queued again each time.
+ *
+ *  usage: signal-emit-bench [--signals <n>] [--keys <n>] [--burst <n>]
+ *                           [--high-water <n>]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto path = "/com/example/Demo";
+constexpr auto interface = "com.example.Demo";
+constexpr auto member = "HelloSignal";
+constexpr auto value = "Hello from sdbusplus!";
+
+struct Options
+{
+    size_t signals = 200000;
+    size_t keys = 64;
+    size_t burst = 256;
+    size_t high_water = 4096;
+};
+
+std::chrono::nanoseconds threadCpu()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds(ts.tv_sec) +
+           std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+/* Count signals on a separate connection until `expected` arrived or the
+ * stream stalls. */
+void receive(size_t expected, std::atomic<size_t>& received,
+             std::atomic<bool>& ready)
+{
+    auto bus = sdbusplus::bus::new_default();
+    sdbusplus::bus::signal_receiver r(bus);
+    size_t n = 0;
+
+    r.subscribe<std::string_view, std::string_view>(
+        {.path = path, .interface = interface, .member = member},
+        [&n](std::string_view, std::string_view) { ++n; });
+
+    auto ping = bus.new_method_call("org.freedesktop.DBus",
+                                    "/org/freedesktop/DBus",
+                                    "org.freedesktop.DBus.Peer", "Ping");
+    bus.call(ping);
+    ready = true;
+
+    auto idleLimit = std::chrono::seconds(2);
+    auto lastProgress = Clock::now();
+    while (n < expected && Clock::now() - lastProgress < idleLimit)
+    {
+        if (r.drain())
+        {
+            lastProgress = Clock::now();
+        }
+        bus.wait(uint64_t{100000});
+    }
+    received = n;
+}
+
+template <typename Emit>
+nlohmann::json runCase(const Options& opts,
+                       const std::vector<std::string>& keys, Emit&& emit)
+{
+    std::atomic<size_t> received = 0;
+    std::atomic<bool> ready = false;
+    std::thread receiver(receive, opts.signals, std::ref(received),
+                         std::ref(ready));
+    while (!ready)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto bus = sdbusplus::bus::new_default();
+    sdbusplus::server::signal_burst burst(bus, opts.high_water);
+
+    auto cpuStart = threadCpu();
+    auto start = Clock::now();
+    emit(bus, burst, keys);
+    bus.flush();
+    auto wall = Clock::now() - start;
+    auto cpu = threadCpu() - cpuStart;
+
+    receiver.join();
+
+    const auto& stats = burst.stats();
+    auto seconds = std::chrono::duration<double>(wall).count();
+    return {
+        {"sent", opts.signals},
+        {"received", received.load()},
+        {"emitter_cpu_ms",
+         std::chrono::duration<double, std::milli>(cpu).count()},
+        {"cpu_us_per_signal",
+         std::chrono::duration<double, std::micro>(cpu).count() /
+             static_cast<double>(opts.signals)},
+        {"signals_per_sec", seconds > 0 ? opts.signals / seconds : 0},
+        {"bursts", stats.bursts},
+        {"backpressure", stats.backpressure},
+        {"max_queued", stats.max_queued},
+        {"blocked", stats.blocked},
+    };
+}
+
+nlohmann::json runPerSignal(const Options& opts,
+                            const std::vector<std::string>& keys)
+{
+    return runCase(opts, keys,
+                   [&opts](sdbusplus::bus_t& bus,
+                           sdbusplus::server::signal_burst&,
+                           const std::vector<std::string>& keys) {
+                       for (size_t i = 0; i < opts.signals; ++i)
+                       {
+                           auto s = bus.new_signal(path, interface, member);
+                           s.append(keys[i % keys.size()], std::string(value));
+                           s.signal_send();
+                       }
+                   });
+}
+
+nlohmann::json runBurst(const Options& opts,
+                        const std::vector<std::string>& keys)
+{
+    return runCase(
+        opts, keys,
+        [&opts](sdbusplus::bus_t&, sdbusplus::server::signal_burst& burst,
+                const std::vector<std::string>& keys) {
+            for (size_t i = 0; i < opts.signals; ++i)
+            {
+                burst.queue(path, interface, member,
+                            std::string_view(keys[i % keys.size()]), value);
+                if (burst.pending() >= opts.burst)
+                {
+                    burst.flush();
+                }
+            }
+            burst.flush();
+        });
+}
+
+nlohmann::json runPrebuilt(const Options& opts,
+                           const std::vector<std::string>& keys)
+{
+    return runCase(
+        opts, keys,
+        [&opts](sdbusplus::bus_t&, sdbusplus::server::signal_burst& burst,
+                const std::vector<std::string>& keys) {
+            std::vector<sdbusplus::message_t> signals;
+            for (const auto& k : keys)
+            {
+                signals.emplace_back(burst.prebuilt(
+                    path, interface, member, std::string_view(k), value));
+            }
+
+            for (size_t i = 0; i < opts.signals; ++i)
+            {
+                burst.queue(signals[i % signals.size()]);
+                if (burst.pending() >= opts.burst)
+                {
+                    burst.flush();
+                }
+            }
+            burst.flush();
+        });
+}
+
+int main(int argc, const char* argv[])
+{
+    Options opts;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--signals" && i + 1 < argc)
+        {
+            opts.signals = std::stoul(argv[++i]);
+        }
+        else if (arg == "--keys" && i + 1 < argc)
+        {
+            opts.keys = std::stoul(argv[++i]);
+        }
+        else if (arg == "--burst" && i + 1 < argc)
+        {
+            opts.burst = std::stoul(argv[++i]);
+        }
+        else if (arg == "--high-water" && i + 1 < argc)
+        {
+            opts.high_water = std::stoul(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--signals <n>] [--keys <n>] [--burst <n>]"
+                         " [--high-water <n>]\n";
+            return -1;
+        }
+    }
+    opts.keys = std::max<size_t>(opts.keys, 1);
+    opts.burst = std::max<size_t>(opts.burst, 1);
+
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < opts.keys; ++i)
+    {
+        keys.emplace_back("sensor" + std::to_string(i));
+    }
+
+    bench::PrivateBus privateBus;
+
+    nlohmann::json results = nlohmann::json::array();
+
+    std::cerr << "per-signal\n";
+    auto perSignal = runPerSignal(opts, keys);
+    perSignal["emitter"] = "per-signal";
+    results.push_back(std::move(perSignal));
+
+    std::cerr << "burst\n";
+    auto burst = runBurst(opts, keys);
+    burst["emitter"] = "burst";
+    results.push_back(std::move(burst));
+
+    std::cerr << "prebuilt\n";
+    auto prebuilt = runPrebuilt(opts, keys);
+    prebuilt["emitter"] = "prebuilt";
+    results.push_back(std::move(prebuilt));
+
+    std::cout << nlohmann::json{{"benchmark", "signal-emit"},
+                                {"signals", opts.signals},
+                                {"keys", opts.keys},
+                                {"burst", opts.burst},
+                                {"high_water", opts.high_water},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,270 @@
+#include "private_bus.hpp"
+
+#include <nlohmann/json.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/bus/signal_receiver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+
+/** Receiver cost for a high-rate signal stream, the way
+ *  emit-signal/receive_signal.cpp reads it against the signal_receiver fast
+ *  path.
+ *
+ *  An emitter thread sends --signals HelloSignal signals the way
+ *  emit-signal/emit_signal.cpp does (new_signal, append std::string,
+ *  signal_send), round-robin over --keys values of arg0, at up to --rate
+ *  signals/s.  The receiver wants --subscribed of those keys:
+ *
+ *    simple - one interface/member match; every payload is read into a
+ *             std::string and filtered in the process, one message per
+ *             process_discard()/wait() cycle,
+ *    fast   - one signal_receiver subscription per key with an arg0 rule,
+ *             so the daemon filters; payloads as std::string_view; every
+ *             queued message dispatched per wakeup.
+ *
+ *  usage: signal-receive-bench [--signals <n>] [--keys <n>]
+ *                              [--subscribed <n>] [--rate <n/s>]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto path = "/com/example/Demo";
+constexpr auto interface = "com.example.Demo";
+constexpr auto member = "HelloSignal";
+
+struct Options
+{
+    size_t signals = 200000;
+    size_t keys = 2000;
+    size_t subscribed = 200;
+    size_t rate = 100000;
+};
+
+std::string key(size_t i)
+{
+    return "sensor" + std::to_string(i);
+}
+
+std::chrono::nanoseconds threadCpu()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds(ts.tv_sec) +
+           std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+/* Emit like emit_signal.cpp, paced to opts.rate. */
+void emit(const Options& opts)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto start = Clock::now();
+
+    for (size_t i = 0; i < opts.signals; ++i)
+    {
+        auto s = bus.new_signal(path, interface, member);
+        s.append(key(i % opts.keys), "value " + std::to_string(i));
+        s.signal_send();
+
+        if (opts.rate && i % 64 == 63)
+        {
+            bus.flush();
+            std::this_thread::sleep_until(
+                start + std::chrono::nanoseconds(std::chrono::seconds(1)) *
+                            (i + 1) / opts.rate);
+        }
+    }
+    bus.flush();
+}
+
+/* Signals a receiver interested in the first opts.subscribed keys gets. */
+size_t expected(const Options& opts)
+{
+    size_t full = opts.signals / opts.keys;
+    size_t rest = opts.signals % opts.keys;
+    return full * opts.subscribed + std::min(rest, opts.subscribed);
+}
+
+template <typename Setup, typename Receive>
+nlohmann::json runCase(const Options& opts, Setup&& setup, Receive&& receive)
+{
+    auto bus = sdbusplus::bus::new_default();
+    size_t received = 0;
+    uint64_t wakeups = 0;
+
+    auto state = setup(bus, received);
+
+    // Make sure the daemon has every match before anything is sent.
+    auto ping = bus.new_method_call("org.freedesktop.DBus",
+                                    "/org/freedesktop/DBus",
+                                    "org.freedesktop.DBus.Peer", "Ping");
+    bus.call(ping);
+
+    auto want = expected(opts);
+    auto cpuStart = threadCpu();
+    auto start = Clock::now();
+    std::thread emitter(emit, std::cref(opts));
+
+    auto idleLimit = std::chrono::seconds(2);
+    auto lastProgress = Clock::now();
+    while (received < want && Clock::now() - lastProgress < idleLimit)
+    {
+        auto before = received;
+        receive(bus, *state);
+        ++wakeups;
+        if (received != before)
+        {
+            lastProgress = Clock::now();
+        }
+        bus.wait(uint64_t{100000});
+    }
+
+    auto wall = Clock::now() - start;
+    auto cpu = threadCpu() - cpuStart;
+    emitter.join();
+
+    auto seconds = std::chrono::duration<double>(wall).count();
+    return {
+        {"received", received},
+        {"expected", want},
+        {"wakeups", wakeups},
+        {"signals_per_wakeup",
+         wakeups ? static_cast<double>(received) / wakeups : 0},
+        {"receiver_cpu_ms",
+         std::chrono::duration<double, std::milli>(cpu).count()},
+        {"cpu_us_per_signal",
+         received ? std::chrono::duration<double, std::micro>(cpu).count() /
+                        static_cast<double>(received)
+                  : 0},
+        {"signals_per_sec", seconds > 0 ? received / seconds : 0},
+    };
+}
+
+nlohmann::json runSimple(const Options& opts)
+{
+    struct State
+    {
+        std::unordered_set<std::string> wanted;
+        std::unique_ptr<sdbusplus::bus::match_t> match;
+    };
+
+    return runCase(
+        opts,
+        [&opts](sdbusplus::bus_t& bus, size_t& received) {
+            auto s = std::make_unique<State>();
+            for (size_t i = 0; i < opts.subscribed; ++i)
+            {
+                s->wanted.insert(key(i));
+            }
+            s->match = std::make_unique<sdbusplus::bus::match_t>(
+                bus,
+                "type='signal',interface='com.example.Demo',"
+                "member='HelloSignal',path='/com/example/Demo'",
+                [&received, &wanted = s->wanted](sdbusplus::message_t& msg) {
+                    std::string k;
+                    std::string v;
+                    msg.read(k, v);
+                    if (wanted.contains(k))
+                    {
+                        ++received;
+                    }
+                });
+            return s;
+        },
+        [](sdbusplus::bus_t& bus, State&) { bus.process_discard(); });
+}
+
+nlohmann::json runFast(const Options& opts)
+{
+    return runCase(
+        opts,
+        [&opts](sdbusplus::bus_t& bus, size_t& received) {
+            auto r = std::make_unique<sdbusplus::bus::signal_receiver>(bus);
+            for (size_t i = 0; i < opts.subscribed; ++i)
+            {
+                r->subscribe<std::string_view, std::string_view>(
+                    {
+                        .path = path,
+                        .interface = interface,
+                        .member = member,
+                        .args = {{0, key(i)}},
+                    },
+                    [&received](std::string_view, std::string_view) {
+                        ++received;
+                    });
+            }
+            return r;
+        },
+        [](sdbusplus::bus_t&, sdbusplus::bus::signal_receiver& r) {
+            r.drain();
+        });
+}
+
+int main(int argc, const char* argv[])
+{
+    Options opts;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--signals" && i + 1 < argc)
+        {
+            opts.signals = std::stoul(argv[++i]);
+        }
+        else if (arg == "--keys" && i + 1 < argc)
+        {
+            opts.keys = std::stoul(argv[++i]);
+        }
+        else if (arg == "--subscribed" && i + 1 < argc)
+        {
+            opts.subscribed = std::stoul(argv[++i]);
+        }
+        else if (arg == "--rate" && i + 1 < argc)
+        {
+            opts.rate = std::stoul(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--signals <n>] [--keys <n>] [--subscribed <n>]"
+                         " [--rate <n/s>]\n";
+            return -1;
+        }
+    }
+    opts.keys = std::max<size_t>(opts.keys, 1);
+    opts.subscribed = std::min(opts.subscribed, opts.keys);
+
+    bench::PrivateBus privateBus;
+
+    nlohmann::json results = nlohmann::json::array();
+
+    std::cerr << "simple\n";
+    auto simple = runSimple(opts);
+    simple["receiver"] = "simple";
+    results.push_back(std::move(simple));
+
+    std::cerr << "fast\n";
+    auto fast = runFast(opts);
+    fast["receiver"] = "fast";
+    results.push_back(std::move(fast));
+
+    std::cout << nlohmann::json{{"benchmark", "signal-receive"},
+                                {"signals", opts.signals},
+                                {"keys", opts.keys},
+                                {"subscribed", opts.subscribed},
+                                {"rate", opts.rate},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+#include "latency.hpp"
+#include "private_bus.hpp"
+
+#include <net/poettering/Calculator/common.hpp>
+#include <nlohmann/json.hpp>
+#include <sdbusplus/bus.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <variant>
+#include <vector>
+
+/** calculator-server built from the default sdbus++ server-cpp output and
+ *  from 'sdbus++ --static-marshal'.
+ *
+ *  For each build it reports:
+ *
+ *    binary_bytes - the executable's size,
+ *    startup_us   - from fork to the service name being owned, over --runs
+ *                   starts,
+ *    operations   - per operation, --calls synchronous calls: their latency
+ *                   and the server's CPU time per call (from
+ *                   /proc/<pid>/schedstat).
+ *
+ *  usage: static-marshal-bench [--calls <n>] [--runs <n>]
+ *                              <variant>=<server-binary>...
+ */
+
+using Clock = std::chrono::steady_clock;
+using Calculator = sdbusplus::common::net::poettering::Calculator;
+
+/* CPU time 'pid' has been scheduled for. */
+std::chrono::nanoseconds cpuTime(pid_t pid)
+{
+    std::ifstream f("/proc/" + std::to_string(pid) + "/schedstat");
+    uint64_t ns = 0;
+    f >> ns;
+    return std::chrono::nanoseconds(ns);
+}
+
+bool nameOwned(sdbusplus::bus_t& b)
+{
+    auto m = b.new_method_call("org.freedesktop.DBus", "/org/freedesktop/DBus",
+                               "org.freedesktop.DBus", "NameHasOwner");
+    m.append(Calculator::default_service);
+    return b.call(m).unpack<bool>();
+}
+
+/* Start 'binary' 'runs' times, timing each until it owns its name. */
+nlohmann::json startup(sdbusplus::bus_t& b, const std::string& binary,
+                       size_t runs)
+{
+    bench::LatencyRecorder recorder;
+    auto start = Clock::now();
+
+    for (size_t i = 0; i < runs; ++i)
+    {
+        {
+            auto begin = Clock::now();
+            bench::ChildProcess server({binary});
+
+            // Poll without sleeping; a round trip is far shorter than a
+            // start.
+            auto until = begin + std::chrono::seconds(5);
+            bool owned = false;
+            while (!(owned = nameOwned(b)) && Clock::now() < until)
+            {}
+            if (owned)
+            {
+                recorder.record(Clock::now() - begin);
+            }
+            else
+            {
+                recorder.error();
+            }
+        }
+
+        // The next start must not see this one's name.
+        bench::waitForName(Calculator::default_service,
+                           std::chrono::seconds(5), false);
+    }
+
+    return recorder.summary(Clock::now() - start)["latency_us"];
+}
+
+const std::map<std::string, std::function<void(sdbusplus::bus_t&)>>
+    operations = {
+        {"Multiply",
+         [](sdbusplus::bus_t& b) {
+             auto m = b.new_method_call(
+                 Calculator::default_service, Calculator::instance_path,
+                 Calculator::interface, "Multiply");
+             m.append(int64_t(7), int64_t(6));
+             b.call(m).unpack<int64_t>();
+         }},
+        {"LastResult.Get",
+         [](sdbusplus::bus_t& b) {
+             auto m = b.new_method_call(
+                 Calculator::default_service, Calculator::instance_path,
+                 "org.freedesktop.DBus.Properties", "Get");
+             m.append(Calculator::interface,
+                      Calculator::property_names::last_result);
+             b.call(m).unpack<std::variant<int64_t>>();
+         }},
+        {"LastResult.Set",
+         [](sdbusplus::bus_t& b) {
+             auto m = b.new_method_call(
+                 Calculator::default_service, Calculator::instance_path,
+                 "org.freedesktop.DBus.Properties", "Set");
+             m.append(Calculator::interface,
+                      Calculator::property_names::last_result,
+                      std::variant<int64_t>(1234));
+             b.call(m);
+         }},
+};
+
+/* Make 'calls' calls of each operation against a running server. */
+nlohmann::json perCall(sdbusplus::bus_t& b, pid_t server, size_t calls)
+{
+    nlohmann::json results = nlohmann::json::object();
+
+    for (const auto& [name, op] : operations)
+    {
+        bench::LatencyRecorder recorder;
+        auto cpuStart = cpuTime(server);
+        auto start = Clock::now();
+
+        for (size_t i = 0; i < calls; ++i)
+        {
+            auto begin = Clock::now();
+            try
+            {
+                op(b);
+                recorder.record(Clock::now() - begin);
+            }
+            catch (const std::exception&)
+            {
+                recorder.error();
+            }
+        }
+
+        auto r = recorder.summary(Clock::now() - start);
+        r["server_cpu_ns_per_call"] =
+            static_cast<double>((cpuTime(server) - cpuStart).count()) /
+            static_cast<double>(std::max<size_t>(calls, 1));
+        results[name] = std::move(r);
+    }
+
+    return results;
+}
+
+int main(int argc, const char* argv[])
+{
+    size_t calls = 20000;
+    size_t runs = 50;
+    std::vector<std::pair<std::string, std::string>> servers;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--calls" && i + 1 < argc)
+        {
+            calls = std::stoul(argv[++i]);
+        }
+        else if (arg == "--runs" && i + 1 < argc)
+        {
+            runs = std::stoul(argv[++i]);
+        }
+        else if (auto eq = arg.find('='); eq != std::string::npos)
+        {
+            servers.emplace_back(arg.substr(0, eq), arg.substr(eq + 1));
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--calls <n>] [--runs <n>]"
+                         " <variant>=<server-binary>...\n";
+            return -1;
+        }
+    }
+
+    bench::PrivateBus bus;
+    auto b = sdbusplus::bus::new_default();
+    nlohmann::json results = nlohmann::json::object();
+
+    for (const auto& [variant, binary] : servers)
+    {
+        std::cerr << variant << "\n";
+
+        auto& r = results[variant];
+        r["binary_bytes"] = std::filesystem::file_size(binary);
+        r["startup_us"] = startup(b, binary, runs);
+
+        {
+            bench::ChildProcess server({binary});
+            if (!bench::waitForName(Calculator::default_service,
+                                    std::chrono::seconds(5)))
+            {
+                std::cerr << variant << ": " << Calculator::default_service
+                          << " never appeared\n";
+                return 1;
+            }
+            r["operations"] = perCall(b, server.pid(), calls);
+        }
+        bench::waitForName(Calculator::default_service,
+                           std::chrono::seconds(5), false);
+    }
+
+    std::cout << nlohmann::json{{"benchmark", "static-marshal"},
+                                {"calls", calls},
+                                {"runs", runs},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    return 0;
+}
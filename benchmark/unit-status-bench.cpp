@@ -0,0 +1,245 @@
+#include "latency.hpp"
+#include "private_bus.hpp"
+
+#include <nlohmann/json.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message/native_types.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+/** Cost of checking many units' states, three ways, against systemd1-mock.
+ *
+ *  Every sweep checks all --units units:
+ *
+ *    per_unit_connection - a new connection and a ListUnitsByNames per
+ *                          unit,
+ *    batched_call        - one ListUnitsByNames naming every unit, on one
+ *                          connection,
+ *    unit_status         - GetUnitStatus naming every unit, answered by
+ *                          unit-status from its table.
+ *
+ *  unit_status_cold is unit-status's first sweep, which fills the table.
+ *  update_latency is the time from StopUnit on the mock until unit-status
+ *  reports the unit inactive, which it learns from PropertiesChanged.
+ *
+ *  usage: unit-status-bench --unit-status <unit-status>
+ *                           --mock <systemd1-mock> [--units <n>]
+ *                           [--sweeps <n>]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto systemdService = "org.freedesktop.systemd1";
+constexpr auto systemdPath = "/org/freedesktop/systemd1";
+constexpr auto managerInterface = "org.freedesktop.systemd1.Manager";
+constexpr auto statusService = "com.example.UnitStatus";
+constexpr auto statusPath = "/com/example/UnitStatus";
+constexpr auto statusInterface = "com.example.UnitStatus";
+
+using ListUnitsEntry =
+    std::tuple<std::string, std::string, std::string, std::string,
+               std::string, std::string, sdbusplus::message::object_path,
+               uint32_t, std::string, sdbusplus::message::object_path>;
+using StatusMap =
+    std::map<std::string, std::tuple<std::string, std::string, std::string>>;
+
+struct Options
+{
+    std::string unit_status;
+    std::string mock;
+    size_t units = 500;
+    size_t sweeps = 20;
+};
+
+/* Time `sweep` `sweeps` times; it returns the number of units seen. */
+nlohmann::json runSweeps(size_t sweeps, size_t expected,
+                         const std::function<size_t()>& sweep)
+{
+    bench::LatencyRecorder recorder;
+    auto start = Clock::now();
+
+    for (size_t i = 0; i < sweeps; ++i)
+    {
+        auto sweepStart = Clock::now();
+        try
+        {
+            if (sweep() != expected)
+            {
+                recorder.error();
+                continue;
+            }
+            recorder.record(Clock::now() - sweepStart);
+        }
+        catch (const sdbusplus::exception::SdBusError&)
+        {
+            recorder.error();
+        }
+    }
+
+    return recorder.summary(Clock::now() - start);
+}
+
+size_t listUnitsByNames(sdbusplus::bus_t& bus,
+                        const std::vector<std::string>& names)
+{
+    auto m = bus.new_method_call(systemdService, systemdPath,
+                                 managerInterface, "ListUnitsByNames");
+    m.append(names);
+    return bus.call(m).unpack<std::vector<ListUnitsEntry>>().size();
+}
+
+StatusMap getUnitStatus(sdbusplus::bus_t& bus,
+                        const std::vector<std::string>& names)
+{
+    auto m = bus.new_method_call(statusService, statusPath, statusInterface,
+                                 "GetUnitStatus");
+    m.append(names);
+    return bus.call(m).unpack<StatusMap>();
+}
+
+int main(int argc, const char* argv[])
+{
+    Options opts;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--unit-status" && i + 1 < argc)
+        {
+            opts.unit_status = argv[++i];
+        }
+        else if (arg == "--mock" && i + 1 < argc)
+        {
+            opts.mock = argv[++i];
+        }
+        else if (arg == "--units" && i + 1 < argc)
+        {
+            opts.units = std::stoul(argv[++i]);
+        }
+        else if (arg == "--sweeps" && i + 1 < argc)
+        {
+            opts.sweeps = std::stoul(argv[++i]);
+        }
+        else
+        {
+            opts.mock.clear();
+            break;
+        }
+    }
+    if (opts.unit_status.empty() || opts.mock.empty() || opts.units == 0)
+    {
+        std::cerr << "usage: " << argv[0]
+                  << " --unit-status <unit-status> --mock <systemd1-mock>"
+                     " [--units <n>] [--sweeps <n>]\n";
+        return -1;
+    }
+
+    bench::PrivateBus privateBus;
+
+    bench::ChildProcess mock(
+        {opts.mock, "--units", std::to_string(opts.units)});
+    if (!bench::waitForName(systemdService, std::chrono::seconds(10)))
+    {
+        std::cerr << "systemd1-mock did not start\n";
+        return 1;
+    }
+    bench::ChildProcess unitStatus({opts.unit_status});
+    if (!bench::waitForName(statusService, std::chrono::seconds(10)))
+    {
+        std::cerr << "unit-status did not start\n";
+        return 1;
+    }
+
+    std::vector<std::string> names;
+    for (size_t i = 0; i < opts.units; ++i)
+    {
+        names.push_back("mock" + std::to_string(i) + ".service");
+    }
+
+    auto bus = sdbusplus::bus::new_default();
+    nlohmann::json results = nlohmann::json::object();
+
+    std::cerr << "per_unit_connection\n";
+    results["per_unit_connection"] =
+        runSweeps(opts.sweeps, opts.units, [&names] {
+            size_t n = 0;
+            for (const auto& name : names)
+            {
+                auto b = sdbusplus::bus::new_default();
+                n += listUnitsByNames(b, {name});
+            }
+            return n;
+        });
+
+    std::cerr << "batched_call\n";
+    results["batched_call"] = runSweeps(opts.sweeps, opts.units, [&] {
+        return listUnitsByNames(bus, names);
+    });
+
+    std::cerr << "unit_status\n";
+    results["unit_status_cold"] = runSweeps(1, opts.units, [&] {
+        return getUnitStatus(bus, names).size();
+    });
+    results["unit_status"] = runSweeps(opts.sweeps, opts.units, [&] {
+        return getUnitStatus(bus, names).size();
+    });
+
+    // Stop units one at a time and wait for unit-status to notice.
+    std::cerr << "update_latency\n";
+    bench::LatencyRecorder updates;
+    auto updateStart = Clock::now();
+    for (size_t i = 0; i < std::min<size_t>(opts.units, 50); ++i)
+    {
+        auto start = Clock::now();
+        auto m = bus.new_method_call(systemdService, systemdPath,
+                                     managerInterface, "StopUnit");
+        m.append(names[i], "replace");
+        bus.call(m);
+
+        bool seen = false;
+        while (!seen && Clock::now() - start < std::chrono::seconds(5))
+        {
+            auto r = getUnitStatus(bus, {names[i]});
+            seen = std::get<1>(r[names[i]]) == "inactive";
+        }
+        if (seen)
+        {
+            updates.record(Clock::now() - start);
+        }
+        else
+        {
+            updates.error();
+        }
+    }
+    results["update_latency"] = updates.summary(Clock::now() - updateStart);
+
+    nlohmann::json counters = nlohmann::json::object();
+    for (const auto* p : {"Hits", "Misses", "SystemdCalls", "Updates"})
+    {
+        auto m = bus.new_method_call(statusService, statusPath,
+                                     "org.freedesktop.DBus.Properties", "Get");
+        m.append(statusInterface, p);
+        counters[p] = std::get<uint64_t>(
+            bus.call(m).unpack<std::variant<uint64_t>>());
+    }
+    results["unit_status_counters"] = counters;
+
+    std::cout << nlohmann::json{{"benchmark", "unit-status"},
+                                {"units", opts.units},
+                                {"sweeps", opts.sweeps},
+                                {"results", results}}
+                     .dump(4)
+              << std::endl;
+
+    return updates.errors() == 0 ? 0 : 1;
+}
@@ -1,5 +1,7 @@
 #include <net/poettering/Calculator/aserver.hpp>
 #include <sdbusplus/async.hpp>
+#include <sdbusplus/server/admission.hpp>
+#include <sdbusplus/server/method_stats.hpp>
 
 #include <iostream>
 
@@ -41,7 +43,8 @@ class Calculator :
         co_return;
     }
 
-    auto get_property(owner_t) const
+    // Returning a reference lets the property be appended without a copy.
+    const auto& get_property(owner_t) const
     {
         std::cout << " get_property on owner\n";
         return owner_;
@@ -62,7 +65,21 @@ int main()
     sdbusplus::async::context ctx;
     sdbusplus::server::manager_t manager{ctx, path};
 
+    // Per-method call counts and latency percentiles, readable with
+    // busctl introspect <service> /xyz/openbmc_project/debug/methods
+    sdbusplus::server::method_stats stats;
+    sdbusplus::server::method_stats_object statsObject{ctx.get_bus(), stats};
+
+    // Answer callers beyond these limits with LimitsExceeded; the queue
+    // depth is published under /xyz/openbmc_project/debug/admission.
+    sdbusplus::server::admission_control admission{
+        {.per_method = 64, .per_sender = 16, .queue = 32}};
+    sdbusplus::server::admission_object admissionObject{ctx.get_bus(),
+                                                        admission};
+
     Calculator c{ctx, path};
+    c.record_method_stats(&stats);
+    c.limit_method_calls(&admission);
 
     ctx.spawn([](sdbusplus::async::context& ctx) -> sdbusplus::async::task<> {
         ctx.request_name(Calculator::default_service);
@@ -1,12 +1,20 @@
 #include <net/poettering/Calculator/client.hpp>
 #include <sdbusplus/async.hpp>
+#include <sdbusplus/async/deadline.hpp>
+#include <sdbusplus/async/signal_hub.hpp>
 
+#include <chrono>
 #include <iostream>
+#include <tuple>
+#include <vector>
 
-auto startup(sdbusplus::async::context& ctx) -> sdbusplus::async::task<>
-{
-    using Calculator = sdbusplus::client::net::poettering::Calculator<>;
+using Calculator = sdbusplus::client::net::poettering::Calculator<>;
+using PropertyCache =
+    sdbusplus::async::property_cache<Calculator::PropertiesVariant>;
 
+auto startup(sdbusplus::async::context& ctx, PropertyCache& cache)
+    -> sdbusplus::async::task<>
+{
     auto c = Calculator(ctx)
                  .service(Calculator::default_service)
                  .path(Calculator::instance_path);
@@ -32,8 +40,20 @@ auto startup(sdbusplus::async::context& ctx) -> sdbusplus::async::task<>
     }
 
     {
+        // Subscribe to Cleared, twice: both share one match through the hub.
+        sdbusplus::async::signal_hub hub(ctx);
+        auto cleared = c.cleared(hub, Calculator::default_service,
+                                 Calculator::instance_path);
+        auto logged = c.cleared(
+            hub, Calculator::default_service, Calculator::instance_path,
+            [](int64_t last) { std::cout << "Cleared " << last << std::endl; });
+
         // Call the Clear method.
         co_await c.clear();
+
+        auto _ = co_await cleared.next();
+        std::cout << "Should be 42: " << _ << std::endl;
+        std::cout << "Matches: " << hub.matches() << std::endl;
     }
 
     {
@@ -66,13 +86,84 @@ auto startup(sdbusplus::async::context& ctx) -> sdbusplus::async::task<>
         std::cout << "Should be 'client': " << _.owner << std::endl;
     }
 
+    {
+        // Read through a cache: only the first GetAll reaches the server,
+        // and PropertiesChanged keeps the cached LastResult current.
+        auto _ = co_await c.properties(cache);
+        std::cout << "Should be 'client': " << _.owner << std::endl;
+        co_await c.last_result(4321);
+        auto last = co_await c.last_result(cache);
+        std::cout << "Should be 4321: " << last << std::endl;
+        std::cout << "Cache hits: " << cache.stats().hits
+                  << ", misses: " << cache.stats().misses << std::endl;
+    }
+
+    {
+        // Give the call a deadline: past it, the call fails with ETIMEDOUT
+        // and its pending reply is dropped.  The caller counts timeouts and
+        // cancellations apart from other errors.
+        sdbusplus::async::deadline_caller caller(
+            ctx, Calculator::default_service, Calculator::instance_path);
+        auto d = sdbusplus::async::deadline::after(std::chrono::seconds(1));
+        auto _ = co_await c.multiply(caller, d, 7, 6);
+        std::cout << "Should be 42: " << _ << std::endl;
+
+        // GetAll through the caller, decoded in place into properties_t.
+        auto all = co_await c.properties(caller, d);
+        std::cout << "Should be 42: " << all.last_result << std::endl;
+        std::cout << "Timeouts: " << caller.stats().timeouts
+                  << ", cancellations: " << caller.stats().cancellations
+                  << std::endl;
+    }
+
+    {
+        // Pipeline a batch of Multiply calls, keeping 4 in flight at a time.
+        std::vector<std::tuple<int64_t, int64_t>> args;
+        for (int64_t i = 1; i <= 8; ++i)
+        {
+            args.emplace_back(i, 6);
+        }
+        auto _ = co_await c.multiply_batch(std::move(args), 4);
+        for (const auto& r : _)
+        {
+            std::cout << "Batched multiply: " << *r.value << std::endl;
+        }
+    }
+
+    {
+        // Failures are reported per call; the rest of the batch still runs.
+        auto _ = co_await c.divide_batch({{42, 6}, {42, 0}, {42, 7}});
+        for (const auto& r : _)
+        {
+            if (r.ok())
+            {
+                std::cout << "Batched divide: " << *r.value << std::endl;
+                continue;
+            }
+            try
+            {
+                std::rethrow_exception(r.error);
+            }
+            catch (const std::exception& e)
+            {
+                std::cout << "Batched divide failed: " << e.what()
+                          << std::endl;
+            }
+        }
+    }
+
     co_return;
 }
 
 int main()
 {
     sdbusplus::async::context ctx;
-    ctx.spawn(startup(ctx));
+
+    // The cache's watches run on the context, so it must outlive run().
+    PropertyCache cache(ctx, Calculator::default_service,
+                        Calculator::instance_path, Calculator::interface);
+
+    ctx.spawn(startup(ctx, cache));
     ctx.spawn(
         sdbusplus::async::execution::just() |
         sdbusplus::async::execution::then([&ctx]() { ctx.request_stop(); }));
@@ -1,7 +1,10 @@
 #include <sdbusplus/async.hpp>
+#include <sdbusplus/async/deadline.hpp>
+#include <sdbusplus/message/stream.hpp>
 
 #include <iostream>
 #include <string>
+#include <tuple>
 #include <variant>
 #include <vector>
 
@@ -13,10 +16,14 @@ auto startup(sdbusplus::async::context& ctx) -> sdbusplus::async::task<>
                                  .path("/org/freedesktop/systemd1")
                                  .interface("org.freedesktop.systemd1.Manager");
 
-    // Call ListUnitFiles method.
-    using ret_type = std::vector<std::tuple<std::string, std::string>>;
-    for (auto& [file, status] :
-         co_await systemd.call<ret_type>(ctx, "ListUnitFiles"))
+    // Call ListUnitFiles method, printing each file as it is decoded
+    // instead of unpacking the whole reply into a vector first.
+    sdbusplus::async::deadline_caller caller(ctx, "org.freedesktop.systemd1",
+                                             "/org/freedesktop/systemd1");
+    using file_stream = sdbusplus::message::array_stream<
+        std::tuple<std::string, std::string>>;
+    for (auto& [file, status] : co_await caller.call<file_stream>(
+             "org.freedesktop.systemd1.Manager", "ListUnitFiles", {}))
     {
         std::cout << file << " " << status << std::endl;
     }
@@ -1,10 +1,38 @@
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/message.hpp>
+#include <sdbusplus/server/signal_burst.hpp>
 
 #include <unistd.h>
 #include <iostream>
+#include <string>
+#include <string_view>
+
+// Queue `count` signals and send them back to back with one flush.
+int emitBurst(sdbusplus::bus_t& bus, size_t count) {
+    sdbusplus::server::signal_burst burst(bus);
+
+    for (size_t i = 0; i < count; ++i) {
+        // String literals are appended as-is, without a std::string.
+        burst.queue("/com/example/Demo", "com.example.Demo", "HelloSignal",
+                    "Hello from sdbusplus!");
+    }
+    burst.flush();
+    bus.flush();
+
+    const auto& stats = burst.stats();
+    std::cout << stats.sent << " signals sent, " << stats.backpressure
+              << " waited for the socket (at most " << stats.max_queued
+              << " queued).\n";
+    return 0;
+}
+
+// usage: emit_signal [--burst <count>]
+int main(int argc, char** argv) {
+    if (argc > 2 && std::string_view(argv[1]) == "--burst") {
+        auto bus = sdbusplus::bus::new_default();
+        return emitBurst(bus, std::stoul(argv[2]));
+    }
 
-int main() {
     // Connect to the system bus
     // auto bus = sdbusplus::bus::new_system();
     auto bus = sdbusplus::bus::new_default(); // or sdbusplus::bus::new_session();
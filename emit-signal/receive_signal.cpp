@@ -1,13 +1,15 @@
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/bus/match_multiplexer.hpp>
+#include <sdbusplus/bus/signal_receiver.hpp>
 
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
-int main() {
-    // Connect to the session bus
-    auto bus = sdbusplus::bus::new_default();
-
+// Receive with one match and one message per wakeup.
+int receiveSimple(sdbusplus::bus_t& bus) {
     // Match rule
     const std::string matchRule =
         "type='signal',"
@@ -34,3 +36,75 @@ int main() {
 
     return 0;
 }
+
+// Receive with a typed subscription: the rule is built from a spec, the
+// payload arrives as a string_view into the message, and every queued
+// message is dispatched per wakeup.
+int receiveFast(sdbusplus::bus_t& bus) {
+    sdbusplus::bus::signal_receiver receiver(bus);
+
+    receiver.subscribe<std::string_view>(
+        {
+            .path_namespace = "/com/example",
+            .interface = "com.example.Demo",
+            .member = "HelloSignal",
+        },
+        [](std::string_view message) {
+            std::cout << "Received signal: " << message << std::endl;
+        });
+
+    std::cout << "Listening for HelloSignal (fast)..." << std::endl;
+
+    receiver.run([] { return false; });
+
+    return 0;
+}
+
+// Receive through a match multiplexer: the per-object subscriptions under
+// /com/example share one path_namespace rule on the bus daemon, and each
+// signal is routed to its object's handler in the process.
+int receiveMultiplexed(sdbusplus::bus_t& bus) {
+    sdbusplus::bus::match_multiplexer mux(
+        bus, {.path_namespaces = {"/com/example"}});
+
+    std::vector<sdbusplus::bus::match_multiplexer::subscription> subs;
+    for (const auto* path : {"/com/example/Demo", "/com/example/Demo2"}) {
+        subs.emplace_back(mux.subscribe(
+            {
+                .path = path,
+                .interface = "com.example.Demo",
+                .member = "HelloSignal",
+            },
+            [path](sdbusplus::message_t& msg) {
+                std::string message;
+                msg.read(message);
+                std::cout << "Received signal on " << path << ": "
+                          << message << std::endl;
+            }));
+    }
+
+    std::cout << "Listening for HelloSignal on " << mux.subscriptions()
+              << " objects with " << mux.broker_rules() << " match rule(s)..."
+              << std::endl;
+
+    while (true) {
+        bus.process_discard();
+        bus.wait();
+    }
+
+    return 0;
+}
+
+// usage: receive_signal [--fast | --multiplexed]
+int main(int argc, char** argv) {
+    // Connect to the session bus
+    auto bus = sdbusplus::bus::new_default();
+
+    if (argc > 1 && std::string_view(argv[1]) == "--fast") {
+        return receiveFast(bus);
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--multiplexed") {
+        return receiveMultiplexed(bus);
+    }
+    return receiveSimple(bus);
+}
@@ -3,6 +3,7 @@
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/asio/object_server.hpp>
 #include <sdbusplus/asio/property.hpp>
+#include <sdbusplus/asio/property_cache.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/unpack_properties.hpp>
 
@@ -193,10 +194,74 @@ class Application
             });
     }
 
+    /* Read through a property_cache: the first GetAll goes to the bus, the
+     * second is served from memory, and after Goodbyes is set the cache
+     * already holds the new value from the PropertiesChanged signal. */
+    void asyncGetAllPropertiesCached()
+    {
+        cache_.getAllProperties(
+            demoServiceName, demoObjectPath, demoInterfaceName,
+            [this](const boost::system::error_code ec,
+                   const PropertyCache::properties_t&) {
+                if (ec)
+                {
+                    logSystemErrorCode(ec);
+                    return;
+                }
+                cache_.getAllProperties(
+                    demoServiceName, demoObjectPath, demoInterfaceName,
+                    [this](const boost::system::error_code ec,
+                           const PropertyCache::properties_t&) {
+                        if (ec)
+                        {
+                            logSystemErrorCode(ec);
+                            return;
+                        }
+                        setGoodbyesThenReadCached();
+                    });
+            });
+    }
+
+    void setGoodbyesThenReadCached()
+    {
+        sdbusplus::asio::setProperty(
+            bus_, demoServiceName, demoObjectPath, demoInterfaceName,
+            propertyGoodbyesName, std::string("See you"),
+            [this](const boost::system::error_code ec) {
+                if (ec)
+                {
+                    logSystemErrorCode(ec);
+                    return;
+                }
+                cache_.getProperty<std::string>(
+                    demoServiceName, demoObjectPath, demoInterfaceName,
+                    propertyGoodbyesName,
+                    [this](const boost::system::error_code ec,
+                           const std::string& goodbyes) {
+                        if (ec)
+                        {
+                            logSystemErrorCode(ec);
+                            return;
+                        }
+                        const auto& stats = cache_.stats();
+                        std::cout << "cached goodbyes: " << goodbyes << "\n";
+                        std::cout << "cache hits: " << stats.hits
+                                  << ", misses: " << stats.misses
+                                  << ", invalidations: " << stats.invalidations
+                                  << "\n";
+                    });
+            });
+    }
+
   private:
+    using PropertyCache = sdbusplus::asio::property_cache<
+        std::variant<std::monostate, std::string, uint32_t>>;
+
     sdbusplus::asio::connection& bus_;
     sdbusplus::asio::object_server& objServer_;
 
+    PropertyCache cache_{bus_};
+
     std::unique_ptr<sdbusplus::asio::dbus_interface> demo_;
     std::string greetings_ = "Hello";
     std::string goodbyes_ = "Bye";
@@ -223,6 +288,7 @@ int main(int, char**)
     boost::asio::post(ioc,
                       [&app] { app.asyncGetAllPropertiesStringTypeOnly(); });
     boost::asio::post(ioc, [&app] { app.asyncGetAllProperties(); });
+    boost::asio::post(ioc, [&app] { app.asyncGetAllPropertiesCached(); });
 
     ioc.run();
 
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <boost/asio/append.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/system/error_code.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/deadline.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cerrno>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace sdbusplus::asio
+{
+
+namespace details
+{
+
+/* Timeouts and cancellation as asio reports them, so callers can test
+ * against asio::error as for any other asio operation. */
+inline boost::system::error_code deadline_error(int error)
+{
+    if (error == ECANCELED)
+    {
+        return boost::asio::error::operation_aborted;
+    }
+    if (error == ETIMEDOUT)
+    {
+        return boost::asio::error::timed_out;
+    }
+    return boost::system::errc::make_error_code(
+        static_cast<boost::system::errc::errc_t>(error));
+}
+
+/* A call in flight.  It owns its reply slot, and frees itself and the slot
+ * when it completes, whether by reply, timeout or cancellation. */
+template <typename Handler>
+class pending_call
+{
+  public:
+    pending_call(connection& conn, Handler&& handler,
+                 bus::call_metrics& metrics) :
+        _conn(conn), _handler(std::move(handler)), _metrics(metrics)
+    {}
+
+    /* Send `m`, or fail at once if the deadline has passed. */
+    void start(message_t& m, const bus::deadline& d)
+    {
+        _metrics.started();
+
+        auto r = -ETIMEDOUT;
+        if (!d.expired())
+        {
+            r = sd_bus_call_async(_conn.get(), &_slot, m.get(),
+                                  &pending_call::reply, this,
+                                  d.timeout_usec());
+        }
+        if (r < 0)
+        {
+            // Never sent; the handler must not run inside the initiation.
+            _metrics.finished(-r);
+            post(-r);
+            return;
+        }
+
+        auto cancel = boost::asio::get_associated_cancellation_slot(_handler);
+        if (cancel.is_connected())
+        {
+            cancel.assign([this](boost::asio::cancellation_type) {
+                if (_slot == nullptr)
+                {
+                    return;
+                }
+                // Drop the reply now; complete once out of the signal.
+                _slot = sd_bus_slot_unref(_slot);
+                _metrics.finished(ECANCELED);
+                post(ECANCELED);
+            });
+        }
+    }
+
+  private:
+    static int reply(sd_bus_message* m, void* data, sd_bus_error*) noexcept
+    {
+        auto* self = static_cast<pending_call*>(data);
+        auto msg = message_t(m);
+        auto error = msg.is_method_error() ? sd_bus_message_get_errno(m) : 0;
+
+        self->_slot = sd_bus_slot_unref(self->_slot);
+        self->_metrics.finished(error);
+        self->complete(error, std::move(msg));
+        return 0;
+    }
+
+    void post(int error)
+    {
+        boost::asio::post(_conn.get_io_context(),
+                          [this, error] { complete(error, message_t{}); });
+    }
+
+    void complete(int error, message_t&& msg)
+    {
+        boost::asio::get_associated_cancellation_slot(_handler).clear();
+
+        boost::system::error_code ec;
+        if (error != 0)
+        {
+            ec = deadline_error(error);
+        }
+        auto handler = std::move(_handler);
+        delete this;
+        boost::asio::dispatch(
+            boost::asio::append(std::move(handler), ec, std::move(msg)));
+    }
+
+    connection& _conn;
+    Handler _handler;
+    bus::call_metrics& _metrics;
+    sd_bus_slot* _slot = nullptr;
+};
+
+} // namespace details
+
+/** @brief connection::async_send() against a deadline.
+ *
+ *  The call fails with asio::error::timed_out once `d` passes, without
+ *  being sent if it already has.  If the handler's cancellation slot is
+ *  signalled first, the pending reply is released at once and the handler
+ *  gets asio::error::operation_aborted; a reply arriving later is dropped
+ *  by sd-bus.  Each outcome is counted in `metrics`.
+ *
+ *  @param[in] conn - The connection to send on.
+ *  @param[in] m - The method call.
+ *  @param[in] d - Deadline for the reply.
+ *  @param[in] metrics - Counters for the outcome.
+ *  @param[in] token - Completion token for
+ *                     void(boost::system::error_code, message_t).
+ */
+template <typename CompletionToken>
+auto async_send_until(connection& conn, message_t& m, bus::deadline d,
+                      bus::call_metrics& metrics, CompletionToken&& token)
+{
+    using sig_t = void(boost::system::error_code, message_t);
+
+    return boost::asio::async_initiate<CompletionToken, sig_t>(
+        [&conn, &m, d, &metrics](auto handler) {
+            (new details::pending_call<decltype(handler)>(
+                 conn, std::move(handler), metrics))
+                ->start(m, d);
+        },
+        token);
+}
+
+/** @brief connection::yield_method_call() against a deadline.
+ *
+ *  As async_send_until(), so a cancelled coroutine releases its pending
+ *  reply at once.  On any error `ec` is set and a default value returned.
+ */
+template <typename... RetTypes, typename... InputArgs>
+auto yield_method_call_until(
+    connection& conn, boost::asio::yield_context yield,
+    boost::system::error_code& ec, bus::deadline d, bus::call_metrics& metrics,
+    const std::string& service, const std::string& objpath,
+    const std::string& interf, const std::string& method,
+    const InputArgs&... a)
+{
+    message_t m;
+    try
+    {
+        m = conn.new_method_call(service.c_str(), objpath.c_str(),
+                                 interf.c_str(), method.c_str());
+        m.append(a...);
+    }
+    catch (const exception::SdBusError& e)
+    {
+        ec = details::deadline_error(e.get_errno());
+    }
+
+    if (!ec)
+    {
+        auto r = async_send_until(conn, m, d, metrics, yield[ec]);
+        if (!ec)
+        {
+            try
+            {
+                if constexpr (sizeof...(RetTypes) != 0)
+                {
+                    return r.template unpack<RetTypes...>();
+                }
+                else
+                {
+                    return;
+                }
+            }
+            catch (const exception::SdBusError& e)
+            {
+                ec = details::deadline_error(e.get_errno());
+            }
+        }
+    }
+
+    if constexpr (sizeof...(RetTypes) == 0)
+    {
+        return;
+    }
+    else if constexpr (sizeof...(RetTypes) == 1)
+    {
+        return std::tuple_element_t<0, std::tuple<RetTypes...>>{};
+    }
+    else
+    {
+        return std::tuple<RetTypes...>{};
+    }
+}
+
+} // namespace sdbusplus::asio
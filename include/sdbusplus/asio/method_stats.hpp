@@ -0,0 +1,90 @@
+#pragma once
+
+#include <boost/callable_traits.hpp>
+#include <sdbusplus/asio/object_server.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/method_stats.hpp>
+
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sdbusplus::asio
+{
+
+namespace details
+{
+
+/* The raw message among a handler's arguments, if it takes one. */
+template <typename... Args>
+sd_bus_message* find_message(Args&... args)
+{
+    sd_bus_message* m = nullptr;
+    (
+        [&](auto& a) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(a)>,
+                                         sdbusplus::message_t>)
+            {
+                m = a.get();
+            }
+        }(args),
+        ...);
+    return m;
+}
+
+template <typename Handler, typename... Args>
+auto timed(server::method_stats::counters& c, Handler&& handler,
+           std::type_identity<std::tuple<Args...>>)
+{
+    using result_t = boost::callable_traits::return_type_t<Handler>;
+
+    return [&c, handler = std::forward<Handler>(handler)](
+               Args... args) mutable -> result_t {
+        server::method_timer timer(&c, find_message(args...));
+        timer.started();
+        try
+        {
+            return handler(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            timer.failed();
+            throw;
+        }
+    };
+}
+
+} // namespace details
+
+/** @brief Wrap a dbus_interface method handler so each call is timed.
+ *
+ *  The wrapper takes the same arguments as `handler`, so register_method()
+ *  deduces the same D-Bus signature.  Calls, thrown errors and the handler
+ *  time are recorded in `c`; the queue wait too when the handler takes the
+ *  sdbusplus::message_t, though the handler is entered from the callback, so
+ *  it stays near zero.  For a yield_context handler the handler time
+ *  includes the time it is suspended.
+ */
+template <typename Handler>
+auto timed(server::method_stats::counters& c, Handler&& handler)
+{
+    return details::timed(c, std::forward<Handler>(handler),
+                          std::type_identity<
+                              boost::callable_traits::args_t<Handler>>{});
+}
+
+/** @brief register_method() with the handler timed into `stats` under
+ *         "<interface>.<name>".
+ */
+template <typename Handler>
+bool register_timed_method(dbus_interface& iface,
+                           server::method_stats& stats,
+                           const std::string& name, Handler&& handler)
+{
+    return iface.register_method(
+        name, timed(stats.method(iface.get_interface_name(), name),
+                    std::forward<Handler>(handler)));
+}
+
+} // namespace sdbusplus::asio
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/asio/object_server.hpp>
+#include <sdbusplus/server/property_batch.hpp>
+
+#include <chrono>
+#include <string>
+
+namespace sdbusplus::asio
+{
+
+/** @brief Coalesces dbus_interface::signal_property() on an io_context.
+ *
+ *  Call `signal_property(iface, name)` here instead of on the interface.
+ *  With a zero window the queued changes are flushed on the next turn of
+ *  the io_context, so a burst of updates made from one handler becomes one
+ *  PropertiesChanged per interface.  A non-zero window holds changes for up
+ *  to that long before flushing.
+ *
+ *  The batch must outlive the io_context's pending handlers.
+ */
+class property_batch : public sdbusplus::server::property_batch
+{
+  public:
+    /** @brief Construct a batch for a connection.
+     *  @param[in] io - The io_context the connection runs on.
+     *  @param[in] conn - The connection to emit on.
+     *  @param[in] window - How long to hold changes; zero for one tick.
+     */
+    property_batch(boost::asio::io_context& io, connection& conn,
+                   std::chrono::milliseconds window = {}) :
+        sdbusplus::server::property_batch(conn, [this] { schedule_flush(); }),
+        _io(io), _timer(io), _window(window)
+    {}
+
+    /** @brief Queue a PropertiesChanged for `name` on `iface`. */
+    void signal_property(dbus_interface& iface, const std::string& name)
+    {
+        mark(iface.get_object_path(), iface.get_interface_name(), name);
+    }
+
+  private:
+    void schedule_flush()
+    {
+        if (_window.count() == 0)
+        {
+            boost::asio::post(_io, [this] { flush(); });
+            return;
+        }
+
+        _timer.expires_after(_window);
+        _timer.async_wait([this](const boost::system::error_code& ec) {
+            if (!ec)
+            {
+                flush();
+            }
+        });
+    }
+
+    boost::asio::io_context& _io;
+    boost::asio::steady_timer _timer;
+    std::chrono::milliseconds _window;
+};
+
+} // namespace sdbusplus::asio
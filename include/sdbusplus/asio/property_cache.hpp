@@ -0,0 +1,271 @@
+#pragma once
+
+#include <boost/asio/post.hpp>
+#include <boost/system/error_code.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/asio/property.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/message/native_types.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace sdbusplus::asio
+{
+
+/** @brief Caching front end for getAllProperties() and getProperty().
+ *
+ *  The first read of an object subscribes to its PropertiesChanged and
+ *  InterfacesRemoved, and to NameOwnerChanged of its service, before the
+ *  bus call is made.  Later reads are answered from memory, posted to the
+ *  io_context so handlers are never invoked re-entrantly.  Changed values
+ *  are updated in place; invalidated properties, removed interfaces and a
+ *  new owner of the service cause the next read to go to the bus.
+ *
+ *  @tparam VariantType - std::variant of the property types to cache.
+ */
+template <typename VariantType>
+class property_cache
+{
+  public:
+    using properties_t = std::vector<std::pair<std::string, VariantType>>;
+
+    /** Counters since construction. */
+    struct statistics
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        /** Times an object's cached values were dropped. */
+        uint64_t invalidations = 0;
+    };
+
+    property_cache() = delete;
+    property_cache(const property_cache&) = delete;
+    property_cache& operator=(const property_cache&) = delete;
+    property_cache(property_cache&&) = delete;
+    property_cache& operator=(property_cache&&) = delete;
+    ~property_cache() = default;
+
+    explicit property_cache(connection& conn) : _conn(conn) {}
+
+    /** @brief Cached sdbusplus::asio::getAllProperties().
+     *
+     *  The handler is called as handler(ec, const properties_t&).
+     */
+    template <typename Handler>
+    void getAllProperties(const std::string& service, const std::string& path,
+                          const std::string& interface, Handler&& handler)
+    {
+        auto& e = entry(service, path, interface);
+        if (e.complete)
+        {
+            ++_stats.hits;
+            properties_t values(e.values.begin(), e.values.end());
+            boost::asio::post(
+                _conn.get_io_context(),
+                [handler = std::forward<Handler>(handler),
+                 values = std::move(values)]() mutable {
+                    handler(boost::system::error_code{}, values);
+                });
+            return;
+        }
+        ++_stats.misses;
+
+        sdbusplus::asio::getAllProperties(
+            _conn, service, path, interface,
+            [this, key = key_t{service, path, interface},
+             gen = e.generation, handler = std::forward<Handler>(handler)](
+                const boost::system::error_code& ec,
+                const properties_t& values) mutable {
+                if (!ec)
+                {
+                    if (auto i = _entries.find(key);
+                        i != _entries.end() && i->second.generation == gen)
+                    {
+                        i->second.values =
+                            std::map<std::string, VariantType>(values.begin(),
+                                                               values.end());
+                        i->second.complete = true;
+                    }
+                }
+                handler(ec, values);
+            });
+    }
+
+    /** @brief Cached sdbusplus::asio::getProperty().
+     *
+     *  The handler is called as handler(ec, const T&).
+     */
+    template <typename T, typename Handler>
+    void getProperty(const std::string& service, const std::string& path,
+                     const std::string& interface, const std::string& property,
+                     Handler&& handler)
+    {
+        auto& e = entry(service, path, interface);
+        if (auto i = e.values.find(property);
+            i != e.values.end() && std::holds_alternative<T>(i->second))
+        {
+            ++_stats.hits;
+            boost::asio::post(_conn.get_io_context(),
+                              [handler = std::forward<Handler>(handler),
+                               value = std::get<T>(i->second)]() mutable {
+                                  handler(boost::system::error_code{}, value);
+                              });
+            return;
+        }
+        ++_stats.misses;
+
+        sdbusplus::asio::getProperty<T>(
+            _conn, service, path, interface, property,
+            [this, key = key_t{service, path, interface}, property,
+             gen = e.generation, handler = std::forward<Handler>(handler)](
+                const boost::system::error_code& ec, const T& value) mutable {
+                if (!ec)
+                {
+                    if (auto i = _entries.find(key);
+                        i != _entries.end() && i->second.generation == gen)
+                    {
+                        i->second.values.insert_or_assign(property, value);
+                    }
+                }
+                handler(ec, value);
+            });
+    }
+
+    const statistics& stats() const noexcept
+    {
+        return _stats;
+    }
+
+  private:
+    using key_t = std::tuple<std::string, std::string, std::string>;
+
+    struct entry_t
+    {
+        std::map<std::string, VariantType> values;
+        bool complete = false;
+        uint64_t generation = 0;
+        std::unique_ptr<bus::match_t> changed;
+        std::unique_ptr<bus::match_t> removed;
+    };
+
+    /* Find or create an entry, subscribing before it is first read. */
+    entry_t& entry(const std::string& service, const std::string& path,
+                   const std::string& interface)
+    {
+        auto [i, inserted] =
+            _entries.try_emplace(key_t{service, path, interface});
+        if (!inserted)
+        {
+            return i->second;
+        }
+
+        auto& e = i->second;
+        key_t key = i->first;
+
+        e.changed = std::make_unique<bus::match_t>(
+            _conn,
+            bus::match::rules::propertiesChanged(path, interface) +
+                bus::match::rules::sender(service),
+            [this, key](message_t& m) { onPropertiesChanged(key, m); });
+
+        e.removed = std::make_unique<bus::match_t>(
+            _conn,
+            bus::match::rules::type::signal() +
+                bus::match::rules::sender(service) +
+                bus::match::rules::interface(
+                    "org.freedesktop.DBus.ObjectManager") +
+                bus::match::rules::member("InterfacesRemoved") +
+                bus::match::rules::argNpath(0, path),
+            [this, key](message_t& m) { onInterfacesRemoved(key, m); });
+
+        if (!_owners.contains(service))
+        {
+            _owners.emplace(
+                service,
+                std::make_unique<bus::match_t>(
+                    _conn, bus::match::rules::nameOwnerChanged(service),
+                    [this, service](message_t&) {
+                        for (auto& [key, e] : _entries)
+                        {
+                            if (std::get<0>(key) == service)
+                            {
+                                invalidate(key);
+                            }
+                        }
+                    }));
+        }
+
+        return e;
+    }
+
+    void onPropertiesChanged(const key_t& key, message_t& m)
+    {
+        auto& e = _entries.at(key);
+        try
+        {
+            auto [iface, updates, invalidated] =
+                m.unpack<std::string, std::map<std::string, VariantType>,
+                         std::vector<std::string>>();
+
+            for (auto& [name, value] : updates)
+            {
+                e.values.insert_or_assign(name, std::move(value));
+            }
+            for (const auto& name : invalidated)
+            {
+                e.values.erase(name);
+                e.complete = false;
+            }
+        }
+        catch (const std::exception&)
+        {
+            // A type outside VariantType; refetch rather than guess.
+            invalidate(key);
+        }
+    }
+
+    void onInterfacesRemoved(const key_t& key, message_t& m)
+    {
+        try
+        {
+            auto [object, interfaces] =
+                m.unpack<sdbusplus::message::object_path,
+                         std::vector<std::string>>();
+            if (std::ranges::find(interfaces, std::get<2>(key)) ==
+                interfaces.end())
+            {
+                return;
+            }
+        }
+        catch (const std::exception&)
+        {
+            // Malformed; drop the entry rather than trust it.
+        }
+        invalidate(key);
+    }
+
+    void invalidate(const key_t& key)
+    {
+        auto& e = _entries.at(key);
+        e.values.clear();
+        e.complete = false;
+        ++e.generation;
+        ++_stats.invalidations;
+    }
+
+    connection& _conn;
+    std::map<key_t, entry_t> _entries;
+    std::map<std::string, std::unique_ptr<bus::match_t>> _owners;
+    statistics _stats;
+};
+
+} // namespace sdbusplus::asio
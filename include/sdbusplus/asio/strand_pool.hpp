@@ -0,0 +1,151 @@
+#pragma once
+
+#ifdef BOOST_ASIO_DISABLE_THREADS
+#error "strand_pool needs Boost.Asio threads; configure with -Dasio-threads=enabled"
+#endif
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace sdbusplus::asio
+{
+
+/** @brief Worker threads for sdbusplus::asio::object_server method handlers.
+ *
+ *  sd-bus is not thread-safe, so the connection and its io_context stay on
+ *  one thread.  A yield_context method handler hands its work to `run()`,
+ *  which executes it on a worker thread and resumes the handler on the bus
+ *  thread with the result; the reply is sent from there as usual.
+ *
+ *  Work is serialized per key (typically the object path) on a strand, so
+ *  handlers of one object never race each other while different objects
+ *  run in parallel.  The work itself must not touch the connection, nor
+ *  state the bus thread also uses: return the result and store it once
+ *  run() has resumed.
+ *
+ *  run() and strand() are only called from the bus thread.
+ */
+class strand_pool
+{
+  public:
+    using executor_type = boost::asio::thread_pool::executor_type;
+    using strand_type = boost::asio::strand<executor_type>;
+
+    strand_pool() = delete;
+    strand_pool(const strand_pool&) = delete;
+    strand_pool& operator=(const strand_pool&) = delete;
+    strand_pool(strand_pool&&) = delete;
+    strand_pool& operator=(strand_pool&&) = delete;
+
+    /** @brief Start `threads` worker threads. */
+    explicit strand_pool(std::size_t threads) : _pool(threads) {}
+
+    ~strand_pool()
+    {
+        _pool.join();
+    }
+
+    /** @brief The strand work for `key` is serialized on. */
+    strand_type& strand(std::string_view key)
+    {
+        auto i = _strands.find(key);
+        if (i == _strands.end())
+        {
+            i = _strands
+                    .emplace(std::string(key),
+                             boost::asio::make_strand(_pool.get_executor()))
+                    .first;
+        }
+        return i->second;
+    }
+
+    /** @brief Run `f` on the strand for `key`, suspending the caller.
+     *
+     *  @param[in] key - Serialization key, ex. the object path.
+     *  @param[in] yield - The method handler's yield_context.
+     *  @param[in] f - Work to run on a worker thread.
+     *
+     *  @return - Whatever `f` returns; an exception thrown by `f` is
+     *            rethrown here, on the bus thread.
+     */
+    template <typename F>
+    auto run(std::string_view key, boost::asio::yield_context yield, F&& f)
+        -> std::invoke_result_t<F>
+    {
+        using R = std::invoke_result_t<F>;
+        using value_t = std::conditional_t<std::is_void_v<R>, std::monostate, R>;
+        using outcome_t =
+            std::variant<std::monostate, value_t, std::exception_ptr>;
+
+        auto outcome = boost::asio::async_initiate<boost::asio::yield_context,
+                                                   void(outcome_t)>(
+            [](auto handler, strand_type& strand, auto f) {
+                // Keeps the bus io_context running until we resume it.
+                auto work = boost::asio::make_work_guard(handler);
+
+                boost::asio::post(
+                    strand, [handler = std::move(handler), f = std::move(f),
+                             work = std::move(work)]() mutable {
+                        outcome_t result;
+                        try
+                        {
+                            if constexpr (std::is_void_v<R>)
+                            {
+                                std::invoke(f);
+                            }
+                            else
+                            {
+                                result.template emplace<1>(std::invoke(f));
+                            }
+                        }
+                        catch (...)
+                        {
+                            result.template emplace<2>(
+                                std::current_exception());
+                        }
+
+                        auto ex = work.get_executor();
+                        boost::asio::post(
+                            ex, [handler = std::move(handler),
+                                 result = std::move(result)]() mutable {
+                                std::move(handler)(std::move(result));
+                            });
+                    });
+            },
+            yield, std::ref(strand(key)), std::forward<F>(f));
+
+        if (auto e = std::get_if<2>(&outcome))
+        {
+            std::rethrow_exception(*e);
+        }
+        if constexpr (!std::is_void_v<R>)
+        {
+            return std::get<1>(std::move(outcome));
+        }
+    }
+
+    executor_type get_executor() noexcept
+    {
+        return _pool.get_executor();
+    }
+
+  private:
+    boost::asio::thread_pool _pool;
+    std::map<std::string, strand_type, std::less<>> _strands;
+};
+
+} // namespace sdbusplus::asio
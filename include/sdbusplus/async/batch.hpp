@@ -0,0 +1,127 @@
+#pragma once
+
+#include <sdbusplus/async/execution.hpp>
+#include <sdbusplus/async/task.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sdbusplus::async
+{
+
+/** Outcome of a single call within a batch. */
+template <typename T>
+struct batch_result
+{
+    /** The reply, if the call succeeded. */
+    std::optional<T> value = std::nullopt;
+    /** The exception raised by the call, if it failed. */
+    std::exception_ptr error = nullptr;
+
+    bool ok() const noexcept
+    {
+        return !error;
+    }
+};
+
+template <>
+struct batch_result<void>
+{
+    std::exception_ptr error = nullptr;
+
+    bool ok() const noexcept
+    {
+        return !error;
+    }
+};
+
+namespace details
+{
+
+template <typename R, typename Args, typename Fn>
+struct batch_state
+{
+    std::vector<Args> args;
+    Fn fn;
+    std::vector<batch_result<R>> results;
+    size_t next = 0;
+};
+
+/* Pull the next pending call until none remain.  Every worker shares the
+ * same cursor, so the number of workers bounds the calls in flight. */
+template <typename R, typename Args, typename Fn>
+auto batch_worker(batch_state<R, Args, Fn>& s) -> task<>
+{
+    for (auto i = s.next++; i < s.args.size(); i = s.next++)
+    {
+        try
+        {
+            if constexpr (std::is_void_v<R>)
+            {
+                co_await std::apply(s.fn, std::move(s.args[i]));
+            }
+            else
+            {
+                s.results[i].value =
+                    co_await std::apply(s.fn, std::move(s.args[i]));
+            }
+        }
+        catch (...)
+        {
+            s.results[i].error = std::current_exception();
+        }
+    }
+}
+
+/* Run 'count' workers concurrently as a tree of two-way when_alls. */
+template <typename R, typename Args, typename Fn>
+auto batch_workers(batch_state<R, Args, Fn>& s, size_t count) -> task<>
+{
+    if (count <= 1)
+    {
+        co_await batch_worker(s);
+        co_return;
+    }
+
+    co_await execution::when_all(batch_workers(s, count / 2),
+                                 batch_workers(s, count - count / 2));
+}
+
+} // namespace details
+
+/** @brief Pipeline a batch of calls on a single context.
+ *
+ *  Invokes `fn(args[i]...)` for every entry in `args`, keeping at most
+ *  `window` of the returned senders outstanding at once.  A failing call does
+ *  not affect the others; its exception is stored in the matching result.
+ *
+ *  @tparam R - The value type produced by each call.
+ *  @param[in] args - One argument tuple per call.
+ *  @param[in] window - Maximum number of calls in flight.
+ *  @param[in] fn - Callable returning the sender for a single call.
+ *
+ *  @return - A task producing one batch_result per call, in request order.
+ */
+template <typename R, typename Args, typename Fn>
+auto batch(std::vector<Args> args, size_t window, Fn fn)
+    -> task<std::vector<batch_result<R>>>
+{
+    details::batch_state<R, Args, Fn> s{std::move(args), std::move(fn), {}};
+    s.results.resize(s.args.size());
+
+    if (!s.args.empty())
+    {
+        co_await details::batch_workers(
+            s, std::clamp<size_t>(window, 1, s.args.size()));
+    }
+
+    co_return std::move(s.results);
+}
+
+} // namespace sdbusplus::async
@@ -0,0 +1,611 @@
+#pragma once
+
+#include <sdbusplus/async/batch.hpp>
+#include <sdbusplus/async/context.hpp>
+#include <sdbusplus/async/execution.hpp>
+#include <sdbusplus/async/proxy.hpp>
+#include <sdbusplus/async/task.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/utility/introspection.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace sdbusplus::async
+{
+
+/** How crawl() walks a service. */
+struct crawl_options
+{
+    /** Where to start. */
+    std::string root = "/";
+    /** Most Introspect calls in flight, across every service crawled. */
+    size_t concurrency = 16;
+    /** Keep the methods, signals and properties of each interface. */
+    bool members = true;
+    /** Keep org.freedesktop.DBus.{Peer,Introspectable,Properties}, which
+     *  every sd-bus object has. */
+    bool standard_interfaces = false;
+};
+
+namespace details
+{
+struct crawl_builder;
+} // namespace details
+
+/** @brief The object tree of one connection, as crawl() found it.
+ *
+ *  Compact by construction: paths share one buffer, each interface is
+ *  described once however many objects implement it, and objects with the
+ *  same set of interfaces share one copy of that set.  Objects are sorted
+ *  by path.  Paths with no interfaces (only children) are not objects.
+ */
+class object_model
+{
+  public:
+    struct method
+    {
+        std::string name;
+        std::string in;
+        std::string out;
+    };
+
+    struct signal
+    {
+        std::string name;
+        std::string signature;
+    };
+
+    struct property
+    {
+        std::string name;
+        std::string type;
+        std::string access;
+    };
+
+    struct interface_info
+    {
+        std::string name;
+        std::vector<method> methods;
+        std::vector<signal> signals;
+        std::vector<property> properties;
+    };
+
+    /** Counters for the crawl that built the model. */
+    struct statistics
+    {
+        /** Introspect calls made. */
+        uint64_t calls = 0;
+        /** Calls that failed. */
+        uint64_t errors = 0;
+        /** Replies that were not valid introspection XML. */
+        uint64_t parse_errors = 0;
+        /** Child nodes not crawled because they were already queued. */
+        uint64_t duplicates = 0;
+    };
+
+    /** @return - The unique name of the connection crawled. */
+    const std::string& owner() const noexcept
+    {
+        return _owner;
+    }
+
+    /** @return - The number of objects. */
+    size_t size() const noexcept
+    {
+        return _objects.size();
+    }
+
+    std::string_view path(size_t i) const
+    {
+        const auto& o = _objects[i];
+        return std::string_view(_paths).substr(o.offset, o.length);
+    }
+
+    /** @return - Ids, for interface(), of what object `i` implements. */
+    std::span<const uint32_t> interfaces(size_t i) const
+    {
+        return _sets[_objects[i].set];
+    }
+
+    const interface_info& interface(uint32_t id) const
+    {
+        return _interfaces[id];
+    }
+
+    /** @return - The number of distinct interfaces. */
+    size_t interface_count() const noexcept
+    {
+        return _interfaces.size();
+    }
+
+    /** @return - The number of distinct interface sets. */
+    size_t interface_sets() const noexcept
+    {
+        return _sets.size();
+    }
+
+    /** @return - The index of the object at `p`, if there is one. */
+    std::optional<size_t> find(std::string_view p) const
+    {
+        auto it = std::ranges::lower_bound(
+            _objects, p, std::less<>{},
+            [this](const object& o) {
+                return std::string_view(_paths).substr(o.offset, o.length);
+            });
+        if (it == _objects.end() || path(it - _objects.begin()) != p)
+        {
+            return std::nullopt;
+        }
+        return it - _objects.begin();
+    }
+
+    const statistics& stats() const noexcept
+    {
+        return _stats;
+    }
+
+  private:
+    friend struct details::crawl_builder;
+
+    struct object
+    {
+        uint32_t offset;
+        uint32_t length;
+        uint32_t set;
+    };
+
+    std::string _owner;
+    std::string _paths;
+    std::vector<object> _objects;
+    std::vector<std::vector<uint32_t>> _sets;
+    std::vector<interface_info> _interfaces;
+    statistics _stats;
+};
+
+namespace details
+{
+
+/* Builds one object_model from Introspect replies. */
+struct crawl_builder
+{
+    crawl_builder(std::string owner, const crawl_options& opts) : opts(opts)
+    {
+        model._owner = std::move(owner);
+    }
+
+    /* Record one object's reply and queue its children. */
+    void add(std::string_view path, std::string_view xml,
+             std::deque<std::pair<crawl_builder*, std::string>>& queue)
+    {
+        current = {};
+        in = nullptr;
+        children.clear();
+
+        if (!utility::parse_introspection(xml, *this))
+        {
+            ++model._stats.parse_errors;
+            return;
+        }
+
+        if (!current.empty())
+        {
+            std::ranges::sort(current);
+            auto [it, added] = sets.try_emplace(
+                current, static_cast<uint32_t>(model._sets.size()));
+            if (added)
+            {
+                model._sets.push_back(current);
+            }
+            model._objects.push_back(
+                {static_cast<uint32_t>(model._paths.size()),
+                 static_cast<uint32_t>(path.size()), it->second});
+            model._paths += path;
+        }
+
+        for (const auto& c : children)
+        {
+            std::string child;
+            if (c.starts_with('/'))
+            {
+                child = c;
+            }
+            else
+            {
+                child = path == "/" ? std::string() : std::string(path);
+                child += '/';
+                child += c;
+            }
+
+            if (visited.insert(child).second)
+            {
+                queue.emplace_back(this, std::move(child));
+            }
+            else
+            {
+                ++model._stats.duplicates;
+            }
+        }
+    }
+
+    object_model::statistics& stats() noexcept
+    {
+        return model._stats;
+    }
+
+    /* Finish: objects sorted by path. */
+    std::shared_ptr<const object_model> finish()
+    {
+        const auto& paths = model._paths;
+        std::ranges::sort(model._objects, std::less<>{},
+                          [&paths](const object_model::object& o) {
+                              return std::string_view(paths).substr(o.offset,
+                                                                    o.length);
+                          });
+        return std::make_shared<const object_model>(std::move(model));
+    }
+
+    /* parse_introspection() handler. */
+    void child(std::string_view name)
+    {
+        if (!name.empty())
+        {
+            children.emplace_back(name);
+        }
+    }
+
+    bool interface(std::string_view name)
+    {
+        in = nullptr;
+
+        if (!opts.standard_interfaces &&
+            (name == "org.freedesktop.DBus.Peer" ||
+             name == "org.freedesktop.DBus.Introspectable" ||
+             name == "org.freedesktop.DBus.Properties"))
+        {
+            return false;
+        }
+
+        auto [it, added] = ids.try_emplace(
+            std::string(name), static_cast<uint32_t>(ids.size()));
+        current.push_back(it->second);
+        if (!added)
+        {
+            // Described already; skip the members.
+            return false;
+        }
+
+        auto& info = model._interfaces.emplace_back();
+        info.name = name;
+        if (!opts.members)
+        {
+            return false;
+        }
+        described = &info;
+        return true;
+    }
+
+    void member(utility::introspection_member kind, std::string_view name)
+    {
+        if (kind == utility::introspection_member::method)
+        {
+            auto& m = described->methods.emplace_back();
+            m.name = name;
+            in = &m.in;
+            out = &m.out;
+        }
+        else
+        {
+            auto& s = described->signals.emplace_back();
+            s.name = name;
+            in = &s.signature;
+            out = &s.signature;
+        }
+    }
+
+    void arg(std::string_view type, std::string_view direction)
+    {
+        if (in == nullptr)
+        {
+            return;
+        }
+        *(direction == "out" ? out : in) += type;
+    }
+
+    void property(std::string_view name, std::string_view type,
+                  std::string_view access)
+    {
+        described->properties.push_back(
+            {std::string(name), std::string(type), std::string(access)});
+    }
+
+    const crawl_options& opts;
+    object_model model;
+    std::unordered_map<std::string, uint32_t> ids;
+    std::map<std::vector<uint32_t>, uint32_t> sets;
+    std::unordered_set<std::string> visited;
+
+    /* State for the reply being parsed. */
+    std::vector<uint32_t> current;
+    std::vector<std::string> children;
+    object_model::interface_info* described = nullptr;
+    std::string* in = nullptr;
+    std::string* out = nullptr;
+};
+
+struct crawl_state;
+
+/* A worker waiting for the queue to refill. */
+struct crawl_idle
+{
+    struct cancel
+    {
+        crawl_idle* self;
+
+        void operator()() noexcept;
+    };
+
+    crawl_state& s;
+    std::coroutine_handle<> h = nullptr;
+    std::optional<execution::inplace_stop_callback<cancel>> on_stop;
+    bool stopped = false;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle);
+
+    /** @return - false if stopped rather than woken. */
+    bool await_resume() noexcept
+    {
+        on_stop.reset();
+        return !stopped;
+    }
+};
+
+struct crawl_state
+{
+    context& ctx;
+    std::deque<std::pair<crawl_builder*, std::string>> queue;
+    /** Introspect calls awaiting their reply. */
+    size_t in_flight = 0;
+    std::vector<crawl_idle*> idle;
+
+    /* Resume up to `n` idle workers; each takes a path or idles again. */
+    void wake(size_t n)
+    {
+        while (n-- && !idle.empty())
+        {
+            auto* w = idle.back();
+            idle.pop_back();
+            w->h.resume();
+        }
+    }
+};
+
+inline void crawl_idle::cancel::operator()() noexcept
+{
+    std::erase(self->s.idle, self);
+    self->stopped = true;
+    self->h.resume();
+}
+
+template <typename Promise>
+bool crawl_idle::await_suspend(std::coroutine_handle<Promise> handle)
+{
+    auto token =
+        execution::get_stop_token(execution::get_env(handle.promise()));
+    if (token.stop_requested())
+    {
+        stopped = true;
+        return false;
+    }
+
+    h = handle;
+    s.idle.push_back(this);
+    on_stop.emplace(std::move(token), cancel{this});
+    return true;
+}
+
+/* Introspect queued paths until the crawl is over: nothing queued and no
+ * call in flight.  Every worker shares the queue, so the number of workers
+ * bounds the calls in flight; one that finds the queue empty while others
+ * await replies idles until those replies queue more. */
+inline auto crawl_worker(crawl_state& s) -> task<>
+{
+    while (true)
+    {
+        if (s.queue.empty())
+        {
+            if (!s.in_flight)
+            {
+                s.wake(s.idle.size());
+                co_return;
+            }
+            if (!co_await crawl_idle{s})
+            {
+                co_await execution::just_stopped();
+            }
+            continue;
+        }
+
+        auto [b, path] = std::move(s.queue.front());
+        s.queue.pop_front();
+
+        ++b->stats().calls;
+        ++s.in_flight;
+        std::string xml;
+        try
+        {
+            xml = co_await proxy()
+                      .service(b->model.owner())
+                      .path(path)
+                      .interface("org.freedesktop.DBus.Introspectable")
+                      .call<std::string>(s.ctx, "Introspect");
+        }
+        catch (const std::exception&)
+        {
+            --s.in_flight;
+            ++b->stats().errors;
+            continue;
+        }
+        --s.in_flight;
+
+        b->add(path, xml, s.queue);
+        // This worker takes one of the new paths; others take the rest.
+        if (!s.queue.empty())
+        {
+            s.wake(s.queue.size() - 1);
+        }
+    }
+}
+
+inline auto crawl_workers(crawl_state& s, size_t count) -> task<>
+{
+    if (count <= 1)
+    {
+        co_await crawl_worker(s);
+        co_return;
+    }
+
+    co_await execution::when_all(crawl_workers(s, count / 2),
+                                 crawl_workers(s, count - count / 2));
+}
+
+inline auto crawl_services(context& ctx, std::vector<std::string> services,
+                           crawl_options opts)
+    -> task<std::map<std::string, std::shared_ptr<const object_model>>>
+{
+    constexpr auto dbus = proxy()
+                              .service("org.freedesktop.DBus")
+                              .path("/org/freedesktop/DBus")
+                              .interface("org.freedesktop.DBus");
+
+    std::vector<std::tuple<std::string>> names;
+    for (const auto& s : services)
+    {
+        names.emplace_back(s);
+    }
+    auto owners = co_await batch<std::string>(
+        std::move(names), opts.concurrency, [&ctx, dbus](std::string name) {
+            return dbus.call<std::string>(ctx, "GetNameOwner", name);
+        });
+
+    std::map<std::string, std::unique_ptr<crawl_builder>> builders;
+    crawl_state state{ctx, {}};
+    for (size_t i = 0; i < services.size(); ++i)
+    {
+        // A unique name needs no lookup, and owns itself.
+        if (services[i].starts_with(':'))
+        {
+            owners[i].value = services[i];
+        }
+        if (!owners[i].value || builders.contains(*owners[i].value))
+        {
+            continue;
+        }
+
+        auto b = std::make_unique<crawl_builder>(*owners[i].value, opts);
+        b->visited.insert(opts.root);
+        state.queue.emplace_back(b.get(), opts.root);
+        builders.emplace(*owners[i].value, std::move(b));
+    }
+
+    // Every worker lives for the whole crawl, idling while the queue is
+    // empty, so a single root still fans out to opts.concurrency calls.
+    co_await crawl_workers(state, std::max<size_t>(opts.concurrency, 1));
+
+    std::map<std::string, std::shared_ptr<const object_model>> models;
+    for (auto& [owner, b] : builders)
+    {
+        models.emplace(owner, b->finish());
+    }
+
+    std::map<std::string, std::shared_ptr<const object_model>> result;
+    for (size_t i = 0; i < services.size(); ++i)
+    {
+        if (owners[i].value)
+        {
+            result.emplace(services[i], models.at(*owners[i].value));
+        }
+    }
+    co_return result;
+}
+
+inline auto crawl_service(context& ctx, std::string service,
+                          crawl_options opts)
+    -> task<std::shared_ptr<const object_model>>
+{
+    std::vector<std::string> services{std::move(service)};
+    auto models = co_await crawl_services(ctx, std::move(services),
+                                          std::move(opts));
+    if (models.empty())
+    {
+        throw exception::SdBusError(ENXIO, "GetNameOwner");
+    }
+    co_return models.begin()->second;
+}
+
+} // namespace details
+
+/** @brief Crawl the object trees of several services concurrently.
+ *
+ *  Every service's tree is walked with Introspect from `opts.root`, with at
+ *  most `opts.concurrency` calls in flight in total.  Replies are parsed
+ *  in one pass, and an interface's members only the first time it is
+ *  seen.  Names owned by the same connection are crawled once and share a
+ *  model, as does a path reached twice.
+ *
+ *  @return - A model for each service that could be resolved.
+ */
+inline auto crawl(context& ctx, std::vector<std::string> services,
+                  crawl_options opts)
+    -> task<std::map<std::string, std::shared_ptr<const object_model>>>
+{
+    return details::crawl_services(ctx, std::move(services), std::move(opts));
+}
+
+/* Overloads rather than default arguments: GCC 12 mis-destroys a default
+ * argument's temporaries when the call is inside a co_await. */
+inline auto crawl(context& ctx, std::vector<std::string> services)
+    -> task<std::map<std::string, std::shared_ptr<const object_model>>>
+{
+    return details::crawl_services(ctx, std::move(services), {});
+}
+
+/** @brief Crawl the object tree of one service.
+ *  @throw sdbusplus::exception::SdBusError - if the service has no owner.
+ */
+inline auto crawl(context& ctx, std::string service, crawl_options opts)
+    -> task<std::shared_ptr<const object_model>>
+{
+    return details::crawl_service(ctx, std::move(service), std::move(opts));
+}
+
+inline auto crawl(context& ctx, std::string service)
+    -> task<std::shared_ptr<const object_model>>
+{
+    return details::crawl_service(ctx, std::move(service), {});
+}
+
+} // namespace sdbusplus::async
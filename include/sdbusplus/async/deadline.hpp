@@ -0,0 +1,266 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/async/context.hpp>
+#include <sdbusplus/async/execution.hpp>
+#include <sdbusplus/async/task.hpp>
+#include <sdbusplus/bus/deadline.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/message/stream.hpp>
+
+#include <cerrno>
+#include <coroutine>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sdbusplus::async
+{
+
+using deadline = bus::deadline;
+
+namespace details
+{
+
+/* The reply to one method call.  The reply slot is owned here, not
+ * floating on the bus, so a stop request can release it on the spot
+ * instead of leaving it to wait for a reply nobody wants.  It stays put in
+ * the coroutine frame while wait()'s awaiter, which GCC 12 copies, points
+ * at it. */
+class pending_reply
+{
+  public:
+    pending_reply(sd_bus* bus, message_t& m, const deadline& d) :
+        _bus(bus), _call(m), _timeout(d.timeout_usec())
+    {}
+
+    pending_reply(const pending_reply&) = delete;
+    pending_reply& operator=(const pending_reply&) = delete;
+    pending_reply(pending_reply&&) = delete;
+    pending_reply& operator=(pending_reply&&) = delete;
+
+    ~pending_reply()
+    {
+        sd_bus_slot_unref(_slot);
+    }
+
+    struct awaiter
+    {
+        pending_reply* self;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> h)
+        {
+            return self->send(h, execution::get_stop_token(
+                                     execution::get_env(h.promise())));
+        }
+
+        /** @return - The reply, and 0 or the errno the call failed with. */
+        std::pair<message_t, int> await_resume() noexcept
+        {
+            self->_on_stop.reset();
+            return {std::move(self->_reply), self->_error};
+        }
+    };
+
+    awaiter wait() noexcept
+    {
+        return {this};
+    }
+
+  private:
+    struct cancel
+    {
+        pending_reply* self;
+
+        void operator()() noexcept
+        {
+            self->_slot = sd_bus_slot_unref(self->_slot);
+            self->_error = ECANCELED;
+            self->_waiter.resume();
+        }
+    };
+
+    /* Send the call; false, with _error set, to resume at once. */
+    template <typename Token>
+    bool send(std::coroutine_handle<> h, Token token)
+    {
+        if (token.stop_requested())
+        {
+            _error = ECANCELED;
+            return false;
+        }
+
+        auto r = sd_bus_call_async(_bus, &_slot, _call.get(),
+                                   &pending_reply::reply, this, _timeout);
+        if (r < 0)
+        {
+            _error = -r;
+            return false;
+        }
+
+        _waiter = h;
+        _on_stop.emplace(std::move(token), cancel{this});
+        return true;
+    }
+
+    static int reply(sd_bus_message* m, void* data, sd_bus_error*) noexcept
+    {
+        auto* self = static_cast<pending_reply*>(data);
+        self->_reply = message_t(m);
+        if (self->_reply.is_method_error())
+        {
+            self->_error = sd_bus_message_get_errno(m);
+        }
+        self->_waiter.resume();
+        return 0;
+    }
+
+    sd_bus* _bus;
+    message_t& _call;
+    uint64_t _timeout;
+    sd_bus_slot* _slot = nullptr;
+    std::coroutine_handle<> _waiter = nullptr;
+    std::optional<execution::inplace_stop_callback<cancel>> _on_stop;
+    message_t _reply;
+    int _error = 0;
+};
+
+template <typename... Rs>
+struct reply_type
+{
+    using type = std::tuple<Rs...>;
+};
+
+template <>
+struct reply_type<>
+{
+    using type = void;
+};
+
+template <typename R>
+struct reply_type<R>
+{
+    using type = R;
+};
+
+} // namespace details
+
+/** @brief Send a method call and wait for its reply until `d`.
+ *
+ *  Throws SdBusError with ETIMEDOUT once `d` passes, without sending the
+ *  call if it already has.  If the awaiting task is stopped first, the
+ *  pending reply is released at once and the task completes as stopped;
+ *  the stop must be requested from the context's thread.  Each outcome is
+ *  counted in `metrics`, which must outlive the call.
+ */
+inline auto call_until(context& ctx, message_t m, deadline d,
+                       bus::call_metrics& metrics) -> task<message_t>
+{
+    metrics.started();
+
+    auto error = ETIMEDOUT;
+    message_t reply;
+    if (!d.expired())
+    {
+        details::pending_reply pending(ctx.get_bus().get(), m, d);
+        std::tie(reply, error) = co_await pending.wait();
+    }
+    metrics.finished(error);
+
+    if (error == ECANCELED)
+    {
+        co_await execution::just_stopped();
+    }
+    if (error != 0)
+    {
+        throw exception::SdBusError(error, "sdbusplus::async::call_until");
+    }
+    co_return reply;
+}
+
+/** @brief Deadline-bounded method calls to one object.
+ *
+ *  Generated clients take a deadline_caller for the deadline overloads of
+ *  their methods, ex. `co_await c.multiply(caller, d, 7, 6)`, in the way
+ *  they take a property_cache; the caller supplies the object's address
+ *  and counts the outcomes.  It must outlive the calls made through it.
+ */
+class deadline_caller
+{
+  public:
+    deadline_caller() = delete;
+    deadline_caller(const deadline_caller&) = delete;
+    deadline_caller& operator=(const deadline_caller&) = delete;
+    deadline_caller(deadline_caller&&) = delete;
+    deadline_caller& operator=(deadline_caller&&) = delete;
+    ~deadline_caller() = default;
+
+    deadline_caller(context& ctx, std::string service, std::string path) :
+        _ctx(ctx), _service(std::move(service)), _path(std::move(path))
+    {}
+
+    /** @brief Call `interface`.`method` with `args` until `d`.
+     *  @tparam Rs - The reply's types; none to ignore it, message_t for the
+     *               reply itself, or message::array_stream<T> to walk an
+     *               array reply one element at a time.
+     */
+    template <typename... Rs, typename... Args>
+    auto call(const char* interface, const char* method, deadline d,
+              Args... args) -> task<typename details::reply_type<Rs...>::type>
+    {
+        auto m = _ctx.get_bus().new_method_call(
+            _service.c_str(), _path.c_str(), interface, method);
+        if constexpr (sizeof...(Args) != 0)
+        {
+            m.append(args...);
+        }
+
+        auto reply = co_await call_until(_ctx, std::move(m), d, _metrics);
+        if constexpr (std::is_same_v<std::tuple<Rs...>, std::tuple<message_t>>)
+        {
+            co_return reply;
+        }
+        else if constexpr (sizeof...(Rs) == 1 &&
+                           (message::is_array_stream<Rs>::value && ...))
+        {
+            co_return typename details::reply_type<Rs...>::type(reply);
+        }
+        else if constexpr (sizeof...(Rs) != 0)
+        {
+            co_return reply.template unpack<Rs...>();
+        }
+    }
+
+    const std::string& service() const noexcept
+    {
+        return _service;
+    }
+
+    const std::string& path() const noexcept
+    {
+        return _path;
+    }
+
+    bus::call_metrics::statistics stats() const noexcept
+    {
+        return _metrics.stats();
+    }
+
+  private:
+    context& _ctx;
+    std::string _service;
+    std::string _path;
+    bus::call_metrics _metrics;
+};
+
+} // namespace sdbusplus::async
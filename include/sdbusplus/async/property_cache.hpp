@@ -0,0 +1,219 @@
+#pragma once
+
+#include <sdbusplus/async/context.hpp>
+#include <sdbusplus/async/match.hpp>
+#include <sdbusplus/async/proxy.hpp>
+#include <sdbusplus/async/task.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message/native_types.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace sdbusplus::async
+{
+
+/** @brief Client-side cache of one object's properties on one interface.
+ *
+ *  Reads are served from memory once the cache holds a value; a miss falls
+ *  back to Get/GetAll on the bus.  The cache subscribes, before its first
+ *  call, to the object's PropertiesChanged, InterfacesRemoved and the
+ *  service's NameOwnerChanged, so it stays current without polling:
+ *  changed values are updated in place, invalidated ones are dropped, and a
+ *  removed interface or a restarted service empties it.
+ *
+ *  The cache must outlive the context's run(), like any spawned task.
+ *
+ *  @tparam Variant - std::variant of every property type on the interface,
+ *                    ex. the generated PropertiesVariant.
+ */
+template <typename Variant>
+class property_cache
+{
+  public:
+    /** Counters since construction. */
+    struct statistics
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        /** Times the whole cache was dropped. */
+        uint64_t invalidations = 0;
+    };
+
+    property_cache() = delete;
+    property_cache(const property_cache&) = delete;
+    property_cache& operator=(const property_cache&) = delete;
+    property_cache(property_cache&&) = delete;
+    property_cache& operator=(property_cache&&) = delete;
+    ~property_cache() = default;
+
+    property_cache(context& ctx, std::string service, std::string path,
+                   std::string interface) :
+        ctx(ctx), service(std::move(service)), path(std::move(path)),
+        interface(std::move(interface)),
+        changed(ctx, bus::match::rules::propertiesChanged(this->path,
+                                                          this->interface) +
+                         bus::match::rules::sender(this->service)),
+        removed(ctx, bus::match::rules::type::signal() +
+                         bus::match::rules::sender(this->service) +
+                         bus::match::rules::interface(
+                             "org.freedesktop.DBus.ObjectManager") +
+                         bus::match::rules::member("InterfacesRemoved") +
+                         bus::match::rules::argNpath(0, this->path)),
+        owner(ctx, bus::match::rules::nameOwnerChanged(this->service))
+    {
+        ctx.spawn(watch_changed());
+        ctx.spawn(watch_removed());
+        ctx.spawn(watch_owner());
+    }
+
+    /** @brief Get every property, from the cache when it is complete. */
+    auto get_all() -> task<std::map<std::string, Variant>>
+    {
+        if (complete)
+        {
+            ++counters.hits;
+            co_return values;
+        }
+        ++counters.misses;
+
+        auto gen = generation;
+        auto reply =
+            co_await make_proxy().template get_all_properties<Variant>(ctx);
+
+        std::map<std::string, Variant> fresh(reply.begin(), reply.end());
+        if (gen == generation)
+        {
+            values = fresh;
+            complete = true;
+        }
+        co_return fresh;
+    }
+
+    /** @brief Get one property, from the cache when it holds it. */
+    template <typename T>
+    auto get(std::string name) -> task<T>
+    {
+        if (auto i = values.find(name);
+            i != values.end() && std::holds_alternative<T>(i->second))
+        {
+            ++counters.hits;
+            co_return std::get<T>(i->second);
+        }
+        ++counters.misses;
+
+        auto gen = generation;
+        auto value =
+            co_await make_proxy().template get_property<T>(ctx, name);
+
+        if (gen == generation)
+        {
+            values.insert_or_assign(std::move(name), value);
+        }
+        co_return value;
+    }
+
+    /** @brief Drop every cached value. */
+    void invalidate()
+    {
+        values.clear();
+        complete = false;
+        ++generation;
+        ++counters.invalidations;
+    }
+
+    const statistics& stats() const noexcept
+    {
+        return counters;
+    }
+
+  private:
+    auto make_proxy() const
+    {
+        return proxy().service(service).path(path).interface(interface);
+    }
+
+    auto watch_changed() -> task<>
+    {
+        while (!ctx.stop_requested())
+        {
+            auto m = co_await changed.next();
+            try
+            {
+                auto [iface, updates, invalidated] =
+                    m.unpack<std::string, std::map<std::string, Variant>,
+                             std::vector<std::string>>();
+
+                for (auto& [name, value] : updates)
+                {
+                    values.insert_or_assign(name, std::move(value));
+                }
+                for (const auto& name : invalidated)
+                {
+                    values.erase(name);
+                    complete = false;
+                }
+            }
+            catch (const std::exception&)
+            {
+                // A type outside Variant; refetch rather than guess.
+                invalidate();
+            }
+        }
+    }
+
+    auto watch_removed() -> task<>
+    {
+        while (!ctx.stop_requested())
+        {
+            auto m = co_await removed.next();
+            try
+            {
+                auto [object, interfaces] =
+                    m.unpack<sdbusplus::message::object_path,
+                             std::vector<std::string>>();
+
+                if (std::ranges::find(interfaces, interface) ==
+                    interfaces.end())
+                {
+                    continue;
+                }
+            }
+            catch (const std::exception&)
+            {
+                // Malformed; drop the values rather than trust them.
+            }
+            invalidate();
+        }
+    }
+
+    auto watch_owner() -> task<>
+    {
+        while (!ctx.stop_requested())
+        {
+            co_await owner.next();
+            invalidate();
+        }
+    }
+
+    context& ctx;
+    std::string service;
+    std::string path;
+    std::string interface;
+
+    match changed;
+    match removed;
+    match owner;
+
+    std::map<std::string, Variant> values;
+    bool complete = false;
+    uint64_t generation = 0;
+    statistics counters;
+};
+
+} // namespace sdbusplus::async
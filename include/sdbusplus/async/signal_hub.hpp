@@ -0,0 +1,303 @@
+#pragma once
+
+#include <sdbusplus/async/context.hpp>
+#include <sdbusplus/async/execution.hpp>
+#include <sdbusplus/async/task.hpp>
+#include <sdbusplus/bus/match_multiplexer.hpp>
+#include <sdbusplus/bus/signal_receiver.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace sdbusplus::async
+{
+
+namespace details
+{
+
+/* Something fed by a shared match. */
+class signal_listener
+{
+  public:
+    virtual ~signal_listener() = default;
+
+    /** @return - false if the body did not match the listener's types. */
+    virtual bool deliver(message_t& m) = 0;
+};
+
+template <typename... Args>
+struct signal_value
+{
+    using type = std::tuple<Args...>;
+};
+
+template <>
+struct signal_value<>
+{
+    using type = void;
+};
+
+template <typename A>
+struct signal_value<A>
+{
+    using type = A;
+};
+
+} // namespace details
+
+/** @brief Signal matches on one context's connection, shared by rule.
+ *
+ *  Every signal_subscription made through the hub with the same rule
+ *  shares one match, so the bus daemon holds one AddMatch per distinct
+ *  rule however many subscribers there are, and a signal is decoded for
+ *  each subscriber from the one message.  The matches are a
+ *  bus::match_multiplexer's: `opts.path_namespaces` merges per-object
+ *  subscriptions under a subtree into one rule as well.
+ *
+ *  Generated clients take a signal_hub for their signal subscriptions,
+ *  ex. `auto s = c.cleared(hub, service, path)`.  The hub must outlive
+ *  its subscriptions.
+ */
+class signal_hub
+{
+  public:
+    /** Counters since construction. */
+    struct statistics
+    {
+        /** Subscriptions made. */
+        uint64_t subscriptions = 0;
+        /** Subscriptions that shared an installed match. */
+        uint64_t shared = 0;
+        /** Signals handed to a subscription. */
+        uint64_t delivered = 0;
+        /** Signals whose body did not match a subscription's types. */
+        uint64_t decode_errors = 0;
+        /** Signals whose callback threw. */
+        uint64_t handler_errors = 0;
+        /** AddMatch calls the bus daemon rejected. */
+        uint64_t match_failures = 0;
+    };
+
+    signal_hub() = delete;
+    signal_hub(const signal_hub&) = delete;
+    signal_hub& operator=(const signal_hub&) = delete;
+    signal_hub(signal_hub&&) = delete;
+    signal_hub& operator=(signal_hub&&) = delete;
+    ~signal_hub() = default;
+
+    explicit signal_hub(context& ctx,
+                        bus::match_multiplexer::options opts = {}) :
+        _mux(ctx.get_bus(), std::move(opts))
+    {}
+
+    /** @return - The match rules installed on the bus. */
+    size_t matches() const noexcept
+    {
+        return _mux.broker_rules();
+    }
+
+    statistics stats() const noexcept
+    {
+        auto s = _stats;
+        const auto& mux = _mux.stats();
+        s.subscriptions = mux.subscriptions;
+        s.shared = mux.shared;
+        s.match_failures = mux.match_failures;
+        return s;
+    }
+
+  private:
+    template <typename...>
+    friend class signal_subscription;
+
+    bus::match_multiplexer::subscription attach(const bus::signal_spec& spec,
+                                                details::signal_listener* l)
+    {
+        return _mux.subscribe(spec, [this, l](message_t& m) {
+            // Counted here rather than by the multiplexer, so the hub's
+            // stats tell decode errors from failed callbacks.
+            try
+            {
+                if (l->deliver(m))
+                {
+                    ++_stats.delivered;
+                }
+                else
+                {
+                    ++_stats.decode_errors;
+                }
+            }
+            catch (...)
+            {
+                ++_stats.handler_errors;
+            }
+        });
+    }
+
+    bus::match_multiplexer _mux;
+    statistics _stats;
+};
+
+/** @brief One subscriber to a signal, through a signal_hub.
+ *
+ *  Without a callback, signals are decoded into Args and queued from
+ *  construction on, and next() takes them in order.  With one, each signal
+ *  is decoded and handed to `callback(Args...)` as it is dispatched; an
+ *  exception from it is counted in the hub's `handler_errors` and goes no
+ *  further.
+ *  Either way the subscription ends when it is destroyed, which must not
+ *  happen while a task awaits next().
+ */
+template <typename... Args>
+class signal_subscription : private details::signal_listener
+{
+  public:
+    /** What next() yields: nothing, the one argument, or a tuple. */
+    using value_type = typename details::signal_value<Args...>::type;
+    using callback_type = std::function<void(Args...)>;
+
+    signal_subscription() = delete;
+    signal_subscription(const signal_subscription&) = delete;
+    signal_subscription& operator=(const signal_subscription&) = delete;
+    signal_subscription(signal_subscription&&) = delete;
+    signal_subscription& operator=(signal_subscription&&) = delete;
+
+    signal_subscription(signal_hub& hub, const bus::signal_spec& spec) :
+        _match(hub.attach(spec, this))
+    {}
+
+    signal_subscription(signal_hub& hub, const bus::signal_spec& spec,
+                        callback_type callback) :
+        _callback(std::move(callback)), _match(hub.attach(spec, this))
+    {}
+
+    ~signal_subscription() override = default;
+
+    /** @brief Take the oldest queued signal, waiting for one if need be.
+     *
+     *  If the awaiting task is stopped first, it completes as stopped; the
+     *  stop must be requested from the context's thread.
+     */
+    auto next() -> task<value_type>
+    {
+        if (!co_await waiter{this})
+        {
+            co_await execution::just_stopped();
+        }
+
+        if constexpr (sizeof...(Args) == 0)
+        {
+            _queue.pop_front();
+        }
+        else
+        {
+            auto v = std::move(_queue.front());
+            _queue.pop_front();
+            if constexpr (sizeof...(Args) == 1)
+            {
+                co_return std::get<0>(std::move(v));
+            }
+            else
+            {
+                co_return v;
+            }
+        }
+    }
+
+    /** @return - The signals queued and not yet taken. */
+    size_t pending() const noexcept
+    {
+        return _queue.size();
+    }
+
+  private:
+    struct cancel
+    {
+        signal_subscription* self;
+
+        void operator()() noexcept
+        {
+            self->_stopped = true;
+            self->_waiter.resume();
+        }
+    };
+
+    struct waiter
+    {
+        signal_subscription* self;
+
+        bool await_ready() const noexcept
+        {
+            return !self->_queue.empty();
+        }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> h)
+        {
+            auto token =
+                execution::get_stop_token(execution::get_env(h.promise()));
+            if (token.stop_requested())
+            {
+                self->_stopped = true;
+                return false;
+            }
+
+            self->_waiter = h;
+            self->_on_stop.emplace(std::move(token), cancel{self});
+            return true;
+        }
+
+        /** @return - false if stopped rather than given a signal. */
+        bool await_resume() noexcept
+        {
+            self->_on_stop.reset();
+            self->_waiter = nullptr;
+            return !std::exchange(self->_stopped, false);
+        }
+    };
+
+    bool deliver(message_t& m) override
+    {
+        std::tuple<Args...> args;
+        try
+        {
+            std::apply([&](auto&... a) { (m.read(a), ...); }, args);
+        }
+        catch (const exception::exception&)
+        {
+            return false;
+        }
+
+        if (_callback)
+        {
+            std::apply(_callback, std::move(args));
+            return true;
+        }
+
+        _queue.push_back(std::move(args));
+        if (_waiter)
+        {
+            // May destroy this subscription; touch nothing after.
+            _waiter.resume();
+        }
+        return true;
+    }
+
+    callback_type _callback;
+    std::deque<std::tuple<Args...>> _queue;
+    std::coroutine_handle<> _waiter = nullptr;
+    std::optional<execution::inplace_stop_callback<cancel>> _on_stop;
+    bool _stopped = false;
+    /* Last, so it is unsubscribed before the queue goes. */
+    bus::match_multiplexer::subscription _match;
+};
+
+} // namespace sdbusplus::async
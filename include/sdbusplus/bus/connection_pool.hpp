@@ -0,0 +1,293 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+#include <unistd.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace sdbusplus::bus
+{
+
+class connection_pool;
+
+/** @brief A connection on loan from a connection_pool.
+ *
+ *  The connection is the caller's alone until the lease is destroyed, when
+ *  it goes back to the pool unless it was marked broken.
+ */
+class connection_lease
+{
+  public:
+    connection_lease() = delete;
+    connection_lease(const connection_lease&) = delete;
+    connection_lease& operator=(const connection_lease&) = delete;
+    connection_lease& operator=(connection_lease&&) = delete;
+
+    connection_lease(connection_lease&& other) noexcept :
+        _pool(std::exchange(other._pool, nullptr)), _bus(std::move(other._bus)),
+        _broken(other._broken)
+    {}
+
+    inline ~connection_lease();
+
+    bus_t& operator*() noexcept
+    {
+        return *_bus;
+    }
+
+    bus_t* operator->() noexcept
+    {
+        return &*_bus;
+    }
+
+    /** @brief Do not return the connection to the pool. */
+    void broken() noexcept
+    {
+        _broken = true;
+    }
+
+  private:
+    friend class connection_pool;
+
+    connection_lease(connection_pool* pool, bus_t bus) :
+        _pool(pool), _bus(std::move(bus))
+    {}
+
+    connection_pool* _pool;
+    std::optional<bus_t> _bus;
+    bool _broken = false;
+};
+
+/** @brief A thread-safe pool of bus connections for synchronous calls.
+ *
+ *  A new connection costs a socket connect, SASL authentication and a Hello
+ *  round trip; a pooled one costs a mutex.  Connections are made lazily, at
+ *  most one per concurrent caller, and kept for reuse up to `max_idle`.
+ *
+ *  A connection is checked before it is lent out: anything queued on it
+ *  (NameAcquired, stray signals) is drained without blocking, which also
+ *  notices a hang-up from the broker, and it is dropped if it is no longer
+ *  open.  Connections made before a fork() are never lent out in the child.
+ *  call() and with() retry once, on a fresh connection, if a call fails
+ *  because the connection died, so a broker restart costs one reconnect
+ *  rather than an error.
+ */
+class connection_pool
+{
+  public:
+    /** Counters since construction. */
+    struct statistics
+    {
+        /** Connections made. */
+        uint64_t connects = 0;
+        /** Leases served by an idle connection. */
+        uint64_t reuses = 0;
+        /** Idle connections found closed and dropped. */
+        uint64_t dropped = 0;
+        /** Calls retried on a fresh connection after a disconnect. */
+        uint64_t retries = 0;
+    };
+
+    connection_pool() = delete;
+    connection_pool(const connection_pool&) = delete;
+    connection_pool& operator=(const connection_pool&) = delete;
+    connection_pool(connection_pool&&) = delete;
+    connection_pool& operator=(connection_pool&&) = delete;
+    ~connection_pool() = default;
+
+    /** @param[in] connect - Opens a new private connection, ex.
+     *                        bus::new_bus.  Not new_default() and the like:
+     *                        those return the calling thread's shared
+     *                        default bus, so two leases could drive one
+     *                        sd_bus at once.
+     *  @param[in] max_idle - Connections kept for reuse.
+     */
+    explicit connection_pool(std::function<bus_t()> connect,
+                             size_t max_idle = 4) :
+        _connect(std::move(connect)), _max_idle(max_idle), _pid(getpid())
+    {}
+
+    /** @return - The process-wide pool of new_bus() connections, to the
+     *            bus new_default() would pick. */
+    static connection_pool& default_pool()
+    {
+        static connection_pool p(&new_bus);
+        return p;
+    }
+
+    /** @return - The process-wide pool of new_system() connections. */
+    static connection_pool& system_pool()
+    {
+        static connection_pool p(&new_system);
+        return p;
+    }
+
+    /** @brief Borrow a connection, making one if none is idle. */
+    connection_lease acquire()
+    {
+        {
+            std::lock_guard lock(_lock);
+            forked();
+            while (!_idle.empty())
+            {
+                auto b = std::move(_idle.back());
+                _idle.pop_back();
+                if (healthy(b))
+                {
+                    ++_stats.reuses;
+                    return {this, std::move(b)};
+                }
+                ++_stats.dropped;
+            }
+            ++_stats.connects;
+        }
+        // Connect outside the lock; it is the slow part.
+        return {this, _connect()};
+    }
+
+    /** @brief Run `fn(bus_t&)` on a pooled connection.
+     *
+     *  If it throws because the connection was lost, it is run once more
+     *  on a new connection, so `fn` must be safe to repeat.
+     */
+    template <typename Fn>
+    auto with(Fn&& fn) -> decltype(fn(std::declval<bus_t&>()))
+    {
+        {
+            auto lease = acquire();
+            try
+            {
+                return fn(*lease);
+            }
+            catch (const exception::SdBusError& e)
+            {
+                if (!disconnected(e.get_errno()))
+                {
+                    throw;
+                }
+                lease.broken();
+            }
+        }
+
+        {
+            std::lock_guard lock(_lock);
+            ++_stats.retries;
+        }
+        auto lease = acquire();
+        return fn(*lease);
+    }
+
+    /** @brief Call a method on a pooled connection and unpack the reply.
+     *  @tparam Rs - The reply's types; none to ignore it.
+     */
+    template <typename... Rs, typename... Args>
+    auto call(const char* service, const char* path, const char* interface,
+              const char* method, const Args&... args)
+    {
+        return with([&](bus_t& b) {
+            auto m = b.new_method_call(service, path, interface, method);
+            if constexpr (sizeof...(Args) > 0)
+            {
+                m.append(args...);
+            }
+            auto reply = b.call(m);
+            if constexpr (sizeof...(Rs) > 0)
+            {
+                return reply.template unpack<Rs...>();
+            }
+        });
+    }
+
+    /** @return - The number of idle connections. */
+    size_t idle() const
+    {
+        std::lock_guard lock(_lock);
+        return _idle.size();
+    }
+
+    statistics stats() const
+    {
+        std::lock_guard lock(_lock);
+        return _stats;
+    }
+
+  private:
+    friend class connection_lease;
+
+    /* Errors that mean the connection itself is gone. */
+    static bool disconnected(int e) noexcept
+    {
+        return e == ENOTCONN || e == ECONNRESET || e == EPIPE ||
+               e == ESHUTDOWN;
+    }
+
+    /* Drain anything queued without blocking, then check it is open. */
+    static bool healthy(bus_t& b)
+    {
+        int r = 0;
+        do
+        {
+            r = sd_bus_process(b.get(), nullptr);
+        } while (r > 0);
+        return r >= 0 && sd_bus_is_open(b.get()) > 0;
+    }
+
+    /* A connection cannot be used on both sides of a fork(). */
+    void forked()
+    {
+        if (getpid() == _pid)
+        {
+            return;
+        }
+        _pid = getpid();
+        // Leak rather than close: the parent still owns the sockets' state.
+        for (auto& b : _idle)
+        {
+            b.release();
+        }
+        _idle.clear();
+    }
+
+    void release(bus_t bus, bool broken)
+    {
+        std::lock_guard lock(_lock);
+        if (getpid() != _pid)
+        {
+            bus.release();
+            return;
+        }
+        if (broken || _idle.size() >= _max_idle)
+        {
+            return;
+        }
+        _idle.push_back(std::move(bus));
+    }
+
+    std::function<bus_t()> _connect;
+    size_t _max_idle;
+    pid_t _pid;
+
+    mutable std::mutex _lock;
+    std::vector<bus_t> _idle;
+    statistics _stats;
+};
+
+connection_lease::~connection_lease()
+{
+    if (_pool != nullptr && _bus)
+    {
+        _pool->release(std::move(*_bus), _broken);
+    }
+}
+
+} // namespace sdbusplus::bus
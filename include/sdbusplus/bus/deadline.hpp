@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+
+namespace sdbusplus::bus
+{
+
+/** @brief The time by which a call, and everything it calls, must finish.
+ *
+ *  A deadline is an absolute time, so it can be handed down through nested
+ *  calls and each one sees only what is left of the budget; within() narrows
+ *  it for a single step.  A default-constructed deadline never expires and
+ *  leaves the bus's default method timeout in effect.
+ */
+class deadline
+{
+  public:
+    using clock = std::chrono::steady_clock;
+
+    constexpr deadline() = default;
+
+    explicit constexpr deadline(clock::time_point at) : _at(at), _set(true) {}
+
+    /** @return - A deadline `budget` from now. */
+    static deadline after(clock::duration budget)
+    {
+        return deadline(clock::now() + budget);
+    }
+
+    /** @return - This deadline, or `budget` from now if that is sooner. */
+    deadline within(clock::duration budget) const
+    {
+        auto at = clock::now() + budget;
+        return (_set && _at < at) ? *this : deadline(at);
+    }
+
+    bool is_set() const noexcept
+    {
+        return _set;
+    }
+
+    bool expired() const
+    {
+        return _set && clock::now() >= _at;
+    }
+
+    /** @return - Time left, or clock::duration::max() if never set. */
+    clock::duration remaining() const
+    {
+        if (!_set)
+        {
+            return clock::duration::max();
+        }
+        return std::max(_at - clock::now(), clock::duration::zero());
+    }
+
+    /** @return - Time left as an sd-bus timeout: 0 (the bus default) if
+     *            never set, otherwise at least 1us.
+     */
+    uint64_t timeout_usec() const
+    {
+        if (!_set)
+        {
+            return 0;
+        }
+        auto us =
+            std::chrono::ceil<std::chrono::microseconds>(remaining()).count();
+        return std::max<uint64_t>(static_cast<uint64_t>(us), 1);
+    }
+
+  private:
+    clock::time_point _at = {};
+    bool _set = false;
+};
+
+/** @brief Outcome counters for calls made against a deadline.
+ *
+ *  A timeout (the deadline passed, either before the call was sent or while
+ *  waiting for its reply) and a cancellation (the caller stopped waiting)
+ *  are counted apart from each other and from other errors, so an overload
+ *  shows up as timeouts rather than being lost among failures.  Counting is
+ *  a relaxed atomic add and safe from any thread.
+ */
+class call_metrics
+{
+  public:
+    struct statistics
+    {
+        /** Calls started. */
+        uint64_t calls = 0;
+        /** Calls answered with a method return. */
+        uint64_t replies = 0;
+        /** Calls that failed other than by timeout or cancellation. */
+        uint64_t errors = 0;
+        /** Calls whose deadline passed. */
+        uint64_t timeouts = 0;
+        /** Calls abandoned by their caller before a reply. */
+        uint64_t cancellations = 0;
+    };
+
+    void started() noexcept
+    {
+        _calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void replied() noexcept
+    {
+        _replies.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void failed() noexcept
+    {
+        _errors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void timed_out() noexcept
+    {
+        _timeouts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void cancelled() noexcept
+    {
+        _cancellations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** @brief Count a finished call by its errno, 0 for a reply. */
+    void finished(int error) noexcept
+    {
+        switch (error)
+        {
+            case 0:
+                replied();
+                break;
+            case ETIMEDOUT:
+                timed_out();
+                break;
+            case ECANCELED:
+                cancelled();
+                break;
+            default:
+                failed();
+                break;
+        }
+    }
+
+    statistics stats() const noexcept
+    {
+        return {_calls.load(std::memory_order_relaxed),
+                _replies.load(std::memory_order_relaxed),
+                _errors.load(std::memory_order_relaxed),
+                _timeouts.load(std::memory_order_relaxed),
+                _cancellations.load(std::memory_order_relaxed)};
+    }
+
+  private:
+    std::atomic<uint64_t> _calls = 0;
+    std::atomic<uint64_t> _replies = 0;
+    std::atomic<uint64_t> _errors = 0;
+    std::atomic<uint64_t> _timeouts = 0;
+    std::atomic<uint64_t> _cancellations = 0;
+};
+
+} // namespace sdbusplus::bus
@@ -0,0 +1,498 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/signal_receiver.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/slot.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sdbusplus::bus
+{
+
+/** @brief Signal matches of one connection, merged and routed locally.
+ *
+ *  Every bus::match_t is an AddMatch of its own, and the bus daemon tests
+ *  each message against every rule.  A multiplexer installs each distinct
+ *  rule once, refcounted by its subscriptions, and merges the per-object
+ *  subscriptions under a configured subtree into one `path_namespace` rule
+ *  per sender, interface and member.  Messages of a merged rule are routed
+ *  to their subscribers by a hash lookup on (path, interface, member).
+ *
+ *  A subscription is merged when it names a path under one of
+ *  `options::path_namespaces`, an interface and a member, and nothing else
+ *  but a sender.  Any other spec keeps a rule of its own.  Merging trades
+ *  broker rules for messages on the subtree that nobody here subscribed
+ *  to; stats() counts those as `unrouted`.
+ *
+ *  A rule is removed with its last subscription; one emptied from its own
+ *  dispatch is removed at the next subscribe or unsubscribe.  The
+ *  multiplexer must outlive its subscriptions.
+ */
+class match_multiplexer
+{
+  private:
+    struct subscriber;
+
+  public:
+    struct options
+    {
+        /** Subtrees whose per-object subscriptions share a rule. */
+        std::vector<std::string> path_namespaces;
+    };
+
+    /** Counters since construction. */
+    struct statistics
+    {
+        /** Subscriptions made. */
+        uint64_t subscriptions = 0;
+        /** Subscriptions that shared an installed rule. */
+        uint64_t shared = 0;
+        /** Messages received through the multiplexer's rules. */
+        uint64_t messages = 0;
+        /** Messages handed to a subscriber. */
+        uint64_t delivered = 0;
+        /** Deliveries whose handler threw. */
+        uint64_t handler_errors = 0;
+        /** Messages no subscriber wanted, the cost of merged rules. */
+        uint64_t unrouted = 0;
+        /** Time spent routing messages, handlers excluded. */
+        uint64_t dispatch_ns = 0;
+        /** AddMatch calls the bus daemon rejected. */
+        uint64_t match_failures = 0;
+    };
+
+    using handler_t = std::function<void(message_t&)>;
+
+    /** @brief One subscriber; unsubscribes when destroyed or reset(). */
+    class subscription
+    {
+      public:
+        subscription() = default;
+        subscription(const subscription&) = delete;
+        subscription& operator=(const subscription&) = delete;
+
+        subscription(subscription&& other) noexcept :
+            _mux(std::exchange(other._mux, nullptr)),
+            _s(std::exchange(other._s, nullptr))
+        {}
+
+        subscription& operator=(subscription&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                _mux = std::exchange(other._mux, nullptr);
+                _s = std::exchange(other._s, nullptr);
+            }
+            return *this;
+        }
+
+        ~subscription()
+        {
+            reset();
+        }
+
+        void reset() noexcept
+        {
+            if (_mux)
+            {
+                std::exchange(_mux, nullptr)->unsubscribe(_s);
+                _s = nullptr;
+            }
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return _mux != nullptr;
+        }
+
+      private:
+        friend class match_multiplexer;
+
+        subscription(match_multiplexer* mux, subscriber* s) :
+            _mux(mux), _s(s)
+        {}
+
+        match_multiplexer* _mux = nullptr;
+        subscriber* _s = nullptr;
+    };
+
+    match_multiplexer() = delete;
+    match_multiplexer(const match_multiplexer&) = delete;
+    match_multiplexer& operator=(const match_multiplexer&) = delete;
+    match_multiplexer(match_multiplexer&&) = delete;
+    match_multiplexer& operator=(match_multiplexer&&) = delete;
+    ~match_multiplexer() = default;
+
+    explicit match_multiplexer(bus_t& bus, options opts = {}) :
+        _bus(bus), _opts(std::move(opts))
+    {}
+
+    /** @brief Call `handler` with each signal matching `spec`.
+     *
+     *  The message is rewound for every subscriber.  Subscribing and
+     *  unsubscribing from a handler are allowed; a new subscriber sees the
+     *  next signal, not the one being dispatched.  An exception from
+     *  `handler` is counted in stats().handler_errors and goes no further.
+     */
+    [[nodiscard]] subscription subscribe(const signal_spec& spec,
+                                         handler_t handler)
+    {
+        prune();
+
+        auto ns = merge_namespace(spec);
+        auto broker = spec;
+        if (ns)
+        {
+            broker.path.clear();
+            broker.path_namespace = *ns;
+        }
+
+        // A spec naming the subtree itself can give the same rule string as
+        // the merged rule for it, but is not routed by path.
+        auto key = std::make_pair(broker.rule(), ns.has_value());
+        auto it = _rules.find(key);
+        if (it == _rules.end())
+        {
+            auto r = std::make_unique<broker_rule>();
+            r->mux = this;
+            r->rule = key.first;
+            r->routed = key.second;
+
+            sd_bus_slot* slot = nullptr;
+            auto ret = sd_bus_add_match_async(_bus.get(), &slot,
+                                              r->rule.c_str(), on_signal,
+                                              on_installed, r.get());
+            if (ret < 0)
+            {
+                throw exception::SdBusError(-ret, "sd_bus_add_match_async");
+            }
+            r->slot = slot_t{slot};
+            it = _rules.emplace(std::move(key), std::move(r)).first;
+        }
+        else
+        {
+            ++_stats.shared;
+        }
+        ++_stats.subscriptions;
+
+        auto& r = *it->second;
+        auto s = std::make_unique<subscriber>();
+        s->handler = std::move(handler);
+        s->owner = &r;
+        if (r.routed)
+        {
+            s->key = {spec.path, spec.interface, spec.member};
+        }
+
+        auto* p = s.get();
+        auto& targets = r.routes[p->key];
+        targets.push_back(std::move(s));
+        ++r.subscribers;
+        ++_subscribers;
+        return subscription(this, p);
+    }
+
+    /** @return - The match rules installed on the bus daemon. */
+    size_t broker_rules() const noexcept
+    {
+        return _rules.size();
+    }
+
+    /** @return - The live subscriptions. */
+    size_t subscriptions() const noexcept
+    {
+        return _subscribers;
+    }
+
+    const statistics& stats() const noexcept
+    {
+        return _stats;
+    }
+
+  private:
+    struct route_view
+    {
+        std::string_view path;
+        std::string_view interface;
+        std::string_view member;
+
+        bool operator==(const route_view&) const = default;
+    };
+
+    struct route_key
+    {
+        std::string path = {};
+        std::string interface = {};
+        std::string member = {};
+
+        operator route_view() const noexcept
+        {
+            return {path, interface, member};
+        }
+    };
+
+    /* Looked up with a route_view of the message, so routing a signal
+     * copies no strings. */
+    struct route_hash
+    {
+        using is_transparent = void;
+
+        size_t operator()(route_view v) const noexcept
+        {
+            std::hash<std::string_view> h;
+            auto r = h(v.path);
+            r ^= h(v.interface) + 0x9e3779b9 + (r << 6) + (r >> 2);
+            r ^= h(v.member) + 0x9e3779b9 + (r << 6) + (r >> 2);
+            return r;
+        }
+
+        size_t operator()(const route_key& k) const noexcept
+        {
+            return (*this)(route_view(k));
+        }
+    };
+
+    struct route_eq
+    {
+        using is_transparent = void;
+
+        bool operator()(route_view a, route_view b) const noexcept
+        {
+            return a == b;
+        }
+    };
+
+    struct broker_rule;
+
+    struct subscriber
+    {
+        handler_t handler;
+        broker_rule* owner = nullptr;
+        /** Empty for rules that are not routed. */
+        route_key key;
+        bool active = true;
+    };
+
+    struct broker_rule
+    {
+        match_multiplexer* mux;
+        std::string rule;
+        slot_t slot{nullptr};
+        /** Merged: subscribers by (path, interface, member).  Otherwise
+         *  all of them under the empty key. */
+        bool routed = false;
+        std::unordered_map<route_key,
+                           std::vector<std::unique_ptr<subscriber>>,
+                           route_hash, route_eq>
+            routes;
+        size_t subscribers = 0;
+    };
+
+    /* The configured subtree `spec` is merged into, if any; the longest
+     * one wins. */
+    std::optional<std::string> merge_namespace(const signal_spec& spec) const
+    {
+        if (spec.path.empty() || spec.interface.empty() ||
+            spec.member.empty() || !spec.path_namespace.empty() ||
+            !spec.args.empty() || !spec.arg_paths.empty() ||
+            !spec.arg0namespace.empty())
+        {
+            return std::nullopt;
+        }
+
+        std::optional<std::string> best;
+        for (const auto& ns : _opts.path_namespaces)
+        {
+            std::string_view path = spec.path;
+            bool under =
+                ns == "/" || path == ns ||
+                (path.starts_with(ns) && path.size() > ns.size() &&
+                 path[ns.size()] == '/');
+            if (under && (!best || ns.size() > best->size()))
+            {
+                best = ns;
+            }
+        }
+        return best;
+    }
+
+    void unsubscribe(subscriber* s) noexcept
+    {
+        if (_dispatching)
+        {
+            // Removed once the dispatch is over.
+            s->active = false;
+            _retired.push_back(s);
+            return;
+        }
+
+        auto* r = s->owner;
+        drop(s);
+        if (!r->subscribers)
+        {
+            _rules.erase({r->rule, r->routed});
+        }
+        prune();
+    }
+
+    /* Free `s`, leaving its rule in place. */
+    void drop(subscriber* s) noexcept
+    {
+        auto* r = s->owner;
+        auto it = r->routes.find(route_view(s->key));
+        std::erase_if(it->second,
+                      [s](const auto& p) { return p.get() == s; });
+        if (it->second.empty())
+        {
+            r->routes.erase(it);
+        }
+        --r->subscribers;
+        --_subscribers;
+    }
+
+    /* Remove the rules emptied during their own dispatch. */
+    void prune() noexcept
+    {
+        if (!_stale)
+        {
+            return;
+        }
+        _stale = false;
+        std::erase_if(_rules,
+                      [](const auto& r) { return !r.second->subscribers; });
+    }
+
+    static std::string_view view(const char* s) noexcept
+    {
+        return s ? std::string_view(s) : std::string_view();
+    }
+
+    static int on_signal(sd_bus_message* m, void* data, sd_bus_error*)
+    {
+        auto* r = static_cast<broker_rule*>(data);
+        auto& mux = *r->mux;
+        ++mux._stats.messages;
+
+        auto start = std::chrono::steady_clock::now();
+        route_view key{};
+        if (r->routed)
+        {
+            key = {view(sd_bus_message_get_path(m)),
+                   view(sd_bus_message_get_interface(m)),
+                   view(sd_bus_message_get_member(m))};
+        }
+        auto it = r->routes.find(key);
+        mux._stats.dispatch_ns += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+
+        if (it == r->routes.end())
+        {
+            ++mux._stats.unrouted;
+            return 0;
+        }
+
+        // Nodes of the route table stay put as it grows, and nothing is
+        // erased from it until the dispatch is over.
+        auto& targets = it->second;
+        message_t msg(m);
+
+        struct dispatch_guard
+        {
+            match_multiplexer& mux;
+
+            ~dispatch_guard()
+            {
+                if (!--mux._dispatching)
+                {
+                    mux.release();
+                }
+            }
+        };
+
+        ++mux._dispatching;
+        dispatch_guard guard{mux};
+
+        // Only those subscribed before the signal arrived.
+        auto n = targets.size();
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto* s = targets[i].get();
+            if (!s->active)
+            {
+                continue;
+            }
+
+            sd_bus_message_rewind(m, true);
+            ++mux._stats.delivered;
+            // Nothing may unwind into sd-bus.  An error return would stop
+            // sd-bus running the connection's other matches, so a failure
+            // is only counted.
+            try
+            {
+                s->handler(msg);
+            }
+            catch (...)
+            {
+                ++mux._stats.handler_errors;
+            }
+        }
+        return 0;
+    }
+
+    /* Free the subscribers unsubscribed during a dispatch. */
+    void release() noexcept
+    {
+        for (auto* s : std::exchange(_retired, {}))
+        {
+            auto* r = s->owner;
+            drop(s);
+            if (!r->subscribers)
+            {
+                // Removing the slot from its own callback is left to the
+                // next subscribe or unsubscribe.
+                _stale = true;
+            }
+        }
+    }
+
+    static int on_installed(sd_bus_message* m, void* data, sd_bus_error*)
+    {
+        if (sd_bus_message_is_method_error(m, nullptr))
+        {
+            ++static_cast<broker_rule*>(data)->mux->_stats.match_failures;
+        }
+        return 0;
+    }
+
+    bus_t& _bus;
+    options _opts;
+    /** By rule and whether it is routed. */
+    std::map<std::pair<std::string, bool>, std::unique_ptr<broker_rule>>
+        _rules;
+    std::vector<subscriber*> _retired;
+    size_t _subscribers = 0;
+    unsigned _dispatching = 0;
+    statistics _stats;
+    bool _stale = false;
+};
+
+} // namespace sdbusplus::bus
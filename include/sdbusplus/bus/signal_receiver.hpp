@@ -0,0 +1,339 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/message/types.hpp>
+#include <sdbusplus/slot.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sdbusplus::bus
+{
+
+/** @brief What a signal subscription matches, as a typed match rule.
+ *
+ *  Every field left empty is omitted from the rule.  The more precise the
+ *  rule, the fewer messages the bus daemon forwards at all: `args` become
+ *  argN='value' (ex. a sensor name in arg0), `path_namespace` selects a
+ *  subtree, and `arg0namespace` a dotted prefix such as a bus name.
+ */
+struct signal_spec
+{
+    std::string sender = {};
+    std::string path = {};
+    std::string path_namespace = {};
+    std::string interface = {};
+    std::string member = {};
+    /** argN='value', for string arguments. */
+    std::vector<std::pair<unsigned, std::string>> args = {};
+    /** argNpath='value', for object path arguments. */
+    std::vector<std::pair<unsigned, std::string>> arg_paths = {};
+    std::string arg0namespace = {};
+
+    /** @return - The D-Bus match rule for this spec. */
+    std::string rule() const
+    {
+        std::string r = "type='signal'";
+
+        auto add = [&r](std::string_view key, std::string_view value) {
+            if (value.empty())
+            {
+                return;
+            }
+            r += ',';
+            r += key;
+            r += "='";
+            // A quote is written as '\'' : close, escaped quote, reopen.
+            for (auto c : value)
+            {
+                if (c == '\'')
+                {
+                    r += "'\\''";
+                }
+                else
+                {
+                    r += c;
+                }
+            }
+            r += '\'';
+        };
+
+        add("sender", sender);
+        add("path", path);
+        add("path_namespace", path_namespace);
+        add("interface", interface);
+        add("member", member);
+        for (const auto& [n, value] : args)
+        {
+            add("arg" + std::to_string(n), value);
+        }
+        for (const auto& [n, value] : arg_paths)
+        {
+            add("arg" + std::to_string(n) + "path", value);
+        }
+        add("arg0namespace", arg0namespace);
+
+        return r;
+    }
+};
+
+/** @brief High-rate signal subscriber.
+ *
+ *  Subscriptions decode the signal body straight into the handler's
+ *  parameters: strings and object paths as std::string_view into the
+ *  message (valid for the duration of the call) and basic types with
+ *  sd_bus_message_read_basic, with no sdbusplus::message_t or std::string in
+ *  between.  Other types fall back to sdbusplus::message_t::read().
+ *
+ *  Matches are added asynchronously, so thousands of subscriptions do not
+ *  cost thousands of AddMatch round trips.  drain() dispatches every
+ *  message already queued on the connection in one go instead of one per
+ *  wakeup.
+ */
+class signal_receiver
+{
+  public:
+    /** Counters since construction. */
+    struct statistics
+    {
+        /** Signals handed to a handler. */
+        uint64_t delivered = 0;
+        /** Signals whose body did not match the handler's parameters. */
+        uint64_t decode_errors = 0;
+        /** Handlers that threw. */
+        uint64_t handler_errors = 0;
+        /** Calls to drain() that found work. */
+        uint64_t batches = 0;
+        /** Most messages dispatched by one drain(). */
+        uint64_t max_batch = 0;
+        /** AddMatch calls the bus daemon rejected. */
+        uint64_t match_failures = 0;
+    };
+
+    signal_receiver() = delete;
+    signal_receiver(const signal_receiver&) = delete;
+    signal_receiver& operator=(const signal_receiver&) = delete;
+    signal_receiver(signal_receiver&&) = delete;
+    signal_receiver& operator=(signal_receiver&&) = delete;
+    ~signal_receiver() = default;
+
+    explicit signal_receiver(bus_t& bus) : _bus(bus) {}
+
+    /** @brief Subscribe `handler(Args...)` to signals matching `spec`.
+     *
+     *  An exception thrown by `handler` is counted in `handler_errors` and
+     *  goes no further.
+     *
+     *  ex. subscribe<std::string_view, double>(spec, [](auto name, auto v) {})
+     */
+    template <typename... Args, typename Handler>
+    void subscribe(const signal_spec& spec, Handler&& handler)
+    {
+        static_assert(std::is_invocable_v<Handler&, Args...>,
+                      "Handler doesn't take the subscribed arguments.");
+
+        std::unique_ptr<subscription_base> s =
+            std::make_unique<subscription<Handler, Args...>>(
+                *this, std::forward<Handler>(handler));
+
+        sd_bus_slot* slot = nullptr;
+        auto r = sd_bus_add_match_async(
+            _bus.get(), &slot, spec.rule().c_str(),
+            subscription<Handler, Args...>::on_signal, on_installed, s.get());
+        if (r < 0)
+        {
+            throw exception::SdBusError(-r, "sd_bus_add_match_async");
+        }
+
+        s->slot = slot_t{slot};
+        _subscriptions.emplace_back(std::move(s));
+    }
+
+    /** @brief Dispatch every message queued on the connection.
+     *  @return - The number of messages processed.
+     */
+    size_t drain()
+    {
+        size_t n = 0;
+        while (true)
+        {
+            auto r = sd_bus_process(_bus.get(), nullptr);
+            if (r < 0)
+            {
+                throw exception::SdBusError(-r, "sd_bus_process");
+            }
+            if (r == 0)
+            {
+                break;
+            }
+            ++n;
+        }
+
+        if (n)
+        {
+            ++_stats.batches;
+            _stats.max_batch = std::max<uint64_t>(_stats.max_batch, n);
+        }
+        return n;
+    }
+
+    /** @brief Wait for messages and drain them until `done()` is true. */
+    template <typename Done>
+    void run(Done&& done, uint64_t timeout_us = UINT64_MAX)
+    {
+        while (!done())
+        {
+            drain();
+            if (done())
+            {
+                break;
+            }
+            _bus.wait(timeout_us);
+        }
+    }
+
+    const statistics& stats() const noexcept
+    {
+        return _stats;
+    }
+
+  private:
+    struct subscription_base
+    {
+        explicit subscription_base(signal_receiver& owner) : owner(owner) {}
+        virtual ~subscription_base() = default;
+
+        signal_receiver& owner;
+        slot_t slot{nullptr};
+    };
+
+    template <typename T>
+    static T read_arg(sd_bus_message* m)
+    {
+        if constexpr (std::is_same_v<T, std::string_view>)
+        {
+            // 's', 'o' and 'g' are read the same way; take any of them.
+            char type = 0;
+            const char* contents = nullptr;
+            auto r = sd_bus_message_peek_type(m, &type, &contents);
+            if (r <= 0)
+            {
+                throw exception::SdBusError(r ? -r : EBADMSG, "peek_type");
+            }
+            if (type != 's' && type != 'o' && type != 'g')
+            {
+                throw exception::SdBusError(EINVAL, "read_basic");
+            }
+
+            const char* s = nullptr;
+            r = sd_bus_message_read_basic(m, type, &s);
+            if (r <= 0)
+            {
+                throw exception::SdBusError(r ? -r : EBADMSG, "read_basic");
+            }
+            return s;
+        }
+        else if constexpr (std::is_same_v<T, bool>)
+        {
+            int v = 0;
+            auto r = sd_bus_message_read_basic(m, 'b', &v);
+            if (r <= 0)
+            {
+                throw exception::SdBusError(r ? -r : EBADMSG, "read_basic");
+            }
+            return v != 0;
+        }
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            T v{};
+            auto r = sd_bus_message_read_basic(
+                m, message::types::type_id<T>().front(), &v);
+            if (r <= 0)
+            {
+                throw exception::SdBusError(r ? -r : EBADMSG, "read_basic");
+            }
+            return v;
+        }
+        else
+        {
+            auto msg = message_t{m};
+            T v{};
+            msg.read(v);
+            return v;
+        }
+    }
+
+    template <typename Handler, typename... Args>
+    struct subscription : subscription_base
+    {
+        subscription(signal_receiver& owner, Handler&& h) :
+            subscription_base(owner), handler(std::forward<Handler>(h))
+        {}
+
+        static int on_signal(sd_bus_message* m [[maybe_unused]], void* data,
+                             sd_bus_error*)
+        {
+            auto self = static_cast<subscription*>(
+                static_cast<subscription_base*>(data));
+            auto& stats = self->owner._stats;
+
+            std::optional<std::tuple<Args...>> args;
+            try
+            {
+                // Braced initialization reads the arguments in order.
+                args.emplace(std::tuple<Args...>{read_arg<Args>(m)...});
+            }
+            catch (const exception::exception&)
+            {
+                ++stats.decode_errors;
+                return 0;
+            }
+
+            // Nothing may unwind through sd-bus's C frames.  An error return
+            // would make sd-bus stop matching the signal against the
+            // connection's other matches, so a failure is only counted.
+            ++stats.delivered;
+            try
+            {
+                std::apply(self->handler, std::move(*args));
+            }
+            catch (...)
+            {
+                ++stats.handler_errors;
+            }
+            return 0;
+        }
+
+        std::decay_t<Handler> handler;
+    };
+
+    static int on_installed(sd_bus_message* m, void* data, sd_bus_error*)
+    {
+        if (sd_bus_message_is_method_error(m, nullptr))
+        {
+            ++static_cast<subscription_base*>(data)
+                  ->owner._stats.match_failures;
+        }
+        return 0;
+    }
+
+    bus_t& _bus;
+    std::deque<std::unique_ptr<subscription_base>> _subscriptions;
+    statistics _stats;
+};
+
+} // namespace sdbusplus::bus
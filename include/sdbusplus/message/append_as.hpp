@@ -0,0 +1,179 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cstring>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace sdbusplus::message
+{
+
+namespace details
+{
+
+template <typename T>
+concept append_as_string = std::is_same_v<T, std::string>;
+
+template <typename T>
+concept append_as_dictionary = requires {
+    typename T::key_type;
+    typename T::mapped_type;
+};
+
+template <typename T>
+concept append_as_array =
+    std::ranges::input_range<T> && !append_as_string<T>;
+
+template <typename T>
+concept append_as_pair = requires {
+    typename T::first_type;
+    typename T::second_type;
+};
+
+/* The D-Bus element held by a declared container; maps hold dict-entries. */
+template <typename T>
+struct append_as_element
+{
+    using type = std::ranges::range_value_t<T>;
+};
+
+template <append_as_dictionary T>
+struct append_as_element<T>
+{
+    using type = std::pair<typename T::key_type, typename T::mapped_type>;
+};
+
+template <typename T>
+using append_as_element_t = typename append_as_element<T>::type;
+
+template <typename Declared, typename V>
+constexpr bool appendable_as()
+{
+    using Value = std::remove_cvref_t<V>;
+
+    if constexpr (std::is_same_v<Value, Declared>)
+    {
+        return true;
+    }
+    else if constexpr (append_as_string<Declared> &&
+                       std::is_convertible_v<const Value&, std::string_view>)
+    {
+        return true;
+    }
+    else if constexpr (append_as_array<Declared> &&
+                       std::ranges::input_range<const Value>)
+    {
+        return appendable_as<append_as_element_t<Declared>,
+                             std::ranges::range_reference_t<const Value>>();
+    }
+    else if constexpr (append_as_pair<Declared> && append_as_pair<Value>)
+    {
+        return appendable_as<typename Declared::first_type,
+                             decltype(std::declval<const Value&>().first)>() &&
+               appendable_as<typename Declared::second_type,
+                             decltype(std::declval<const Value&>().second)>();
+    }
+    else
+    {
+        return std::is_convertible_v<const Value&, Declared>;
+    }
+}
+
+inline void append_as_open(message_t& m, char type, const char* contents)
+{
+    auto r = sd_bus_message_open_container(m.get(), type, contents);
+    if (r < 0)
+    {
+        throw exception::SdBusError(-r, "sd_bus_message_open_container");
+    }
+}
+
+inline void append_as_close(message_t& m)
+{
+    auto r = sd_bus_message_close_container(m.get());
+    if (r < 0)
+    {
+        throw exception::SdBusError(-r, "sd_bus_message_close_container");
+    }
+}
+
+} // namespace details
+
+/** Whether a V can be appended with the D-Bus type of Declared. */
+template <typename Declared, typename V>
+concept appendable_as = details::appendable_as<Declared, V>();
+
+/** @brief Append a value with the D-Bus signature of another type.
+ *
+ *  Lets a property getter hand back a `const&` to its storage, or a view
+ *  such as `std::string_view`, a `std::span`, or a range of views, and have
+ *  it written straight into the message.  No intermediate `Declared` is
+ *  built.  A value of type `Declared` is passed to `message_t::append`
+ *  unchanged.
+ *
+ *  @tparam Declared - The property's declared C++ type, which determines
+ *                     the D-Bus signature.
+ *  @param[in] m - The message to append to.
+ *  @param[in] v - The value, or a view of it.
+ */
+template <typename Declared, typename V>
+    requires appendable_as<Declared, V>
+void append_as(message_t& m, const V& v)
+{
+    if constexpr (std::is_same_v<V, Declared>)
+    {
+        m.append(v);
+    }
+    else if constexpr (details::append_as_string<Declared> &&
+                       std::is_convertible_v<const V&, std::string_view>)
+    {
+        std::string_view s = v;
+        char* p = nullptr;
+
+        auto r = sd_bus_message_append_string_space(m.get(), s.size(), &p);
+        if (r < 0)
+        {
+            throw exception::SdBusError(-r,
+                                        "sd_bus_message_append_string_space");
+        }
+        std::memcpy(p, s.data(), s.size());
+    }
+    else if constexpr (details::append_as_array<Declared> &&
+                       std::ranges::input_range<const V>)
+    {
+        using element = details::append_as_element_t<Declared>;
+        constexpr auto contents = types::type_id<element>();
+
+        details::append_as_open(m, SD_BUS_TYPE_ARRAY, contents.data());
+        for (const auto& e : v)
+        {
+            append_as<element>(m, e);
+        }
+        details::append_as_close(m);
+    }
+    else if constexpr (details::append_as_pair<Declared> &&
+                       details::append_as_pair<V>)
+    {
+        using first = typename Declared::first_type;
+        using second = typename Declared::second_type;
+        constexpr auto contents = types::type_id<first, second>();
+
+        details::append_as_open(m, SD_BUS_TYPE_DICT_ENTRY, contents.data());
+        append_as<first>(m, v.first);
+        append_as<second>(m, v.second);
+        details::append_as_close(m);
+    }
+    else
+    {
+        m.append(static_cast<Declared>(v));
+    }
+}
+
+} // namespace sdbusplus::message
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cerrno>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sdbusplus::message
+{
+
+namespace details
+{
+
+template <typename T>
+struct arena_vector : std::false_type
+{};
+
+template <typename E>
+struct arena_vector<std::pmr::vector<E>> : std::true_type
+{};
+
+template <typename T>
+struct arena_pair : std::false_type
+{};
+
+template <typename A, typename B>
+struct arena_pair<std::pair<A, B>> : std::true_type
+{};
+
+template <typename T>
+struct arena_tuple : std::false_type
+{};
+
+template <typename... Ts>
+struct arena_tuple<std::tuple<Ts...>> : std::true_type
+{};
+
+inline int arena_check(int r, const char* what)
+{
+    if (r < 0)
+    {
+        throw exception::SdBusError(-r, what);
+    }
+    return r;
+}
+
+inline char arena_peek(sd_bus_message* m)
+{
+    char type = 0;
+    arena_check(sd_bus_message_peek_type(m, &type, nullptr),
+                "sd_bus_message_peek_type");
+    return type;
+}
+
+template <typename T>
+void arena_read(message_t& m, T& value)
+{
+    auto msg = m.get();
+
+    if constexpr (std::is_same_v<T, std::string_view> ||
+                  std::is_same_v<T, std::pmr::string>)
+    {
+        // Strings, object paths and signatures alike.
+        auto type = arena_peek(msg);
+        if (type != SD_BUS_TYPE_STRING && type != SD_BUS_TYPE_OBJECT_PATH &&
+            type != SD_BUS_TYPE_SIGNATURE)
+        {
+            throw exception::SdBusError(ENXIO, "sdbusplus::message::arena");
+        }
+
+        const char* s = nullptr;
+        arena_check(sd_bus_message_read_basic(msg, type, &s),
+                    "sd_bus_message_read_basic");
+        value = s;
+    }
+    else if constexpr (arena_vector<T>::value)
+    {
+        arena_check(
+            sd_bus_message_enter_container(msg, SD_BUS_TYPE_ARRAY, nullptr),
+            "sd_bus_message_enter_container");
+        while (arena_check(sd_bus_message_at_end(msg, false),
+                           "sd_bus_message_at_end") == 0)
+        {
+            // Built with the vector's allocator, so nested containers and
+            // strings land in the arena too.
+            arena_read(m, value.emplace_back());
+        }
+        arena_check(sd_bus_message_exit_container(msg),
+                    "sd_bus_message_exit_container");
+    }
+    else if constexpr (arena_pair<T>::value)
+    {
+        // A dict entry, or a two-member struct.
+        auto type = arena_peek(msg);
+        if (type != SD_BUS_TYPE_DICT_ENTRY && type != SD_BUS_TYPE_STRUCT)
+        {
+            throw exception::SdBusError(ENXIO, "sdbusplus::message::arena");
+        }
+
+        arena_check(sd_bus_message_enter_container(msg, type, nullptr),
+                    "sd_bus_message_enter_container");
+        arena_read(m, value.first);
+        arena_read(m, value.second);
+        arena_check(sd_bus_message_exit_container(msg),
+                    "sd_bus_message_exit_container");
+    }
+    else if constexpr (arena_tuple<T>::value)
+    {
+        arena_check(
+            sd_bus_message_enter_container(msg, SD_BUS_TYPE_STRUCT, nullptr),
+            "sd_bus_message_enter_container");
+        std::apply([&](auto&... v) { (arena_read(m, v), ...); }, value);
+        arena_check(sd_bus_message_exit_container(msg),
+                    "sd_bus_message_exit_container");
+    }
+    else
+    {
+        // Basic types, and anything else message_t knows how to read.
+        m.read(value);
+    }
+}
+
+} // namespace details
+
+/** @brief Unpack `m` with its containers and strings in `arena`.
+ *
+ *  A large reply unpacked into std::vector and std::string makes a heap
+ *  allocation per element and per string; ListUnits, ListUsers and
+ *  GetSubTree replies make thousands.  Here, the types spell out where
+ *  each value goes:
+ *
+ *    std::pmr::vector<T>   an array, allocated from `arena`,
+ *    std::pmr::string      a string, object path or signature, copied into
+ *                          `arena`,
+ *    std::string_view      the same, as a view into the message's buffer,
+ *    std::pair<K, V>       a dict entry (or two-member struct),
+ *    std::tuple<Ts...>     a struct,
+ *
+ *  and anything else, such as the basic types, is read by message_t::read()
+ *  as usual.  Nested containers are built with the enclosing container's
+ *  allocator, so a std::pmr::monotonic_buffer_resource over a reused buffer
+ *  decodes a reply of views without touching the heap at all.
+ *
+ *  The result must not outlive `arena`, nor, if it holds string_views, `m`.
+ *
+ *  ex. a ListUnits reply, keeping only the strings it needs:
+ *
+ *    std::pmr::monotonic_buffer_resource arena;
+ *    auto units = unpack_arena<std::pmr::vector<std::tuple<
+ *        std::string_view, std::string_view, std::string_view,
+ *        std::string_view, std::string_view, std::string_view,
+ *        std::string_view, uint32_t, std::string_view, std::string_view>>>(
+ *        reply, arena);
+ */
+template <typename... Ts>
+auto unpack_arena(message_t& m, std::pmr::memory_resource& arena)
+{
+    static_assert(sizeof...(Ts) > 0, "Nothing to unpack.");
+    std::pmr::polymorphic_allocator<> alloc(&arena);
+
+    if constexpr (sizeof...(Ts) == 1)
+    {
+        auto value = std::make_obj_using_allocator<Ts...>(alloc);
+        details::arena_read(m, value);
+        return value;
+    }
+    else
+    {
+        auto values = std::make_obj_using_allocator<std::tuple<Ts...>>(alloc);
+        std::apply([&](auto&... v) { (details::arena_read(m, v), ...); },
+                   values);
+        return values;
+    }
+}
+
+} // namespace sdbusplus::message
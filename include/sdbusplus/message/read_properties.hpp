@@ -0,0 +1,134 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/message/types.hpp>
+#include <sdbusplus/utility/tuple_to_array.hpp>
+
+#include <string_view>
+
+namespace sdbusplus::message
+{
+
+namespace details
+{
+
+inline int read_properties_check(int r, const char* what)
+{
+    if (r < 0)
+    {
+        throw exception::SdBusError(-r, what);
+    }
+    return r;
+}
+
+} // namespace details
+
+/** @brief One entry of an a{sv}, positioned at its value.
+ *
+ *  Handed to the read_properties() callback, which reads the values it
+ *  wants; a value left unread is skipped without being decoded.
+ */
+class property_value
+{
+  public:
+    property_value() = delete;
+    property_value(const property_value&) = delete;
+    property_value& operator=(const property_value&) = delete;
+    property_value(property_value&&) = delete;
+    property_value& operator=(property_value&&) = delete;
+    ~property_value() = default;
+
+    property_value(message_t& m, std::string_view name) : _m(m), _name(name)
+    {}
+
+    /** @brief Read the variant's content into `value`.
+     *
+     *  Throws UnpackPropertyError if the variant holds another type than
+     *  T's D-Bus type.
+     */
+    template <typename T>
+    void read(T& value)
+    {
+        static constexpr auto signature =
+            utility::tuple_to_array(types::type_id<T>());
+
+        auto m = _m.get();
+        if (details::read_properties_check(
+                sd_bus_message_verify_type(m, SD_BUS_TYPE_VARIANT,
+                                           signature.data()),
+                "sd_bus_message_verify_type") == 0)
+        {
+            throw exception::UnpackPropertyError(_name,
+                                                 UnpackErrorReason::wrongType);
+        }
+
+        details::read_properties_check(
+            sd_bus_message_enter_container(m, SD_BUS_TYPE_VARIANT,
+                                           signature.data()),
+            "sd_bus_message_enter_container");
+        _m.read(value);
+        details::read_properties_check(sd_bus_message_exit_container(m),
+                                       "sd_bus_message_exit_container");
+        _read = true;
+    }
+
+    bool consumed() const noexcept
+    {
+        return _read;
+    }
+
+  private:
+    message_t& _m;
+    std::string_view _name;
+    bool _read = false;
+};
+
+/** @brief Walk an a{sv} of properties, such as a GetAll reply, in place.
+ *
+ *  `f(name, value)` is called for each entry with the name as a view into
+ *  the message, so no name is copied and no intermediate container of
+ *  variants is built.  `f` reads the values it knows through
+ *  property_value::read(); the rest are skipped.
+ *
+ *  @param[in] m - The message, positioned at the array.
+ *  @param[in] f - Callable as `f(std::string_view, property_value&)`.
+ */
+template <typename F>
+void read_properties(message_t& m, F&& f)
+{
+    auto msg = m.get();
+
+    details::read_properties_check(
+        sd_bus_message_enter_container(msg, SD_BUS_TYPE_ARRAY, "{sv}"),
+        "sd_bus_message_enter_container");
+
+    while (details::read_properties_check(
+               sd_bus_message_enter_container(msg, SD_BUS_TYPE_DICT_ENTRY,
+                                              "sv"),
+               "sd_bus_message_enter_container") > 0)
+    {
+        const char* name = nullptr;
+        details::read_properties_check(
+            sd_bus_message_read_basic(msg, SD_BUS_TYPE_STRING, &name),
+            "sd_bus_message_read_basic");
+
+        property_value value(m, name);
+        f(std::string_view{name}, value);
+        if (!value.consumed())
+        {
+            details::read_properties_check(sd_bus_message_skip(msg, "v"),
+                                           "sd_bus_message_skip");
+        }
+
+        details::read_properties_check(sd_bus_message_exit_container(msg),
+                                       "sd_bus_message_exit_container");
+    }
+
+    details::read_properties_check(sd_bus_message_exit_container(msg),
+                                   "sd_bus_message_exit_container");
+}
+
+} // namespace sdbusplus::message
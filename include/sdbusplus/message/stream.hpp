@@ -0,0 +1,166 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/message/types.hpp>
+#include <sdbusplus/utility/tuple_to_array.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace sdbusplus::message
+{
+
+/** @brief An array in a message, decoded one element at a time.
+ *
+ *  Iterating an array_stream reads each element into the same T as the
+ *  iterator reaches it, so a reply of thousands of elements is walked
+ *  without building a container of them and the first element is seen
+ *  without waiting for the last to be decoded.  The stream holds a
+ *  reference to the message, so it may outlive the message_t it was made
+ *  from, and shares its read position: once the last element is read the
+ *  message is positioned after the array.  It can be iterated once.
+ *
+ *  ex.
+ *    for (auto& [file, status] :
+ *         stream<std::tuple<std::string, std::string>>(reply))
+ */
+template <typename T>
+class array_stream
+{
+  public:
+    class iterator
+    {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        explicit iterator(array_stream* s) : _s(s) {}
+
+        T& operator*() const
+        {
+            return _s->_value;
+        }
+
+        T* operator->() const
+        {
+            return &_s->_value;
+        }
+
+        iterator& operator++()
+        {
+            _s->next();
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        bool operator==(std::default_sentinel_t) const
+        {
+            return _s->_done;
+        }
+
+      private:
+        array_stream* _s = nullptr;
+    };
+
+    array_stream() = delete;
+    array_stream(const array_stream&) = delete;
+    array_stream& operator=(const array_stream&) = delete;
+    array_stream(array_stream&&) = default;
+    array_stream& operator=(array_stream&&) = default;
+    ~array_stream() = default;
+
+    /** @brief Enter the array of T at the message's read position.
+     *
+     *  Throws SdBusError with ENXIO if there is no such array.
+     */
+    explicit array_stream(message_t& m) : _m(m.get())
+    {
+        static constexpr auto signature =
+            utility::tuple_to_array(types::type_id<T>());
+
+        auto r = sd_bus_message_enter_container(_m.get(), SD_BUS_TYPE_ARRAY,
+                                                signature.data());
+        if (r <= 0)
+        {
+            throw exception::SdBusError(r < 0 ? -r : ENXIO,
+                                        "sd_bus_message_enter_container");
+        }
+    }
+
+    iterator begin()
+    {
+        if (!_started)
+        {
+            _started = true;
+            next();
+        }
+        return iterator(this);
+    }
+
+    std::default_sentinel_t end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+  private:
+    void next()
+    {
+        auto msg = _m.get();
+        auto r = sd_bus_message_at_end(msg, false);
+        if (r < 0)
+        {
+            throw exception::SdBusError(-r, "sd_bus_message_at_end");
+        }
+        if (r > 0)
+        {
+            r = sd_bus_message_exit_container(msg);
+            if (r < 0)
+            {
+                throw exception::SdBusError(-r,
+                                            "sd_bus_message_exit_container");
+            }
+            _done = true;
+            return;
+        }
+
+        // message_t::read() may add to a container rather than replace it.
+        _value = T{};
+        _m.read(_value);
+    }
+
+    message_t _m;
+    T _value{};
+    bool _started = false;
+    bool _done = false;
+};
+
+template <typename T>
+struct is_array_stream : std::false_type
+{};
+
+template <typename T>
+struct is_array_stream<array_stream<T>> : std::true_type
+{};
+
+/** @brief Stream the array of T at `m`'s read position; see array_stream. */
+template <typename T>
+array_stream<T> stream(message_t& m)
+{
+    return array_stream<T>(m);
+}
+
+} // namespace sdbusplus::message
@@ -0,0 +1,370 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace sdbusplus::server
+{
+
+/** @brief Admission limits for async method calls.
+ *
+ *  An async method callback spawns a task and returns, so without a bound a
+ *  flood of calls becomes an unbounded set of coroutines, each holding its
+ *  message until it is answered.  admission_control caps, as calls admitted
+ *  and not yet answered, each method's total and each sender's total, and
+ *  caps the calls admitted but not yet started (the queue).  A call over any
+ *  limit is answered at once with `busy_error` rather than queued, so the
+ *  caller learns to back off instead of timing out.
+ *
+ *  Method callbacks and their tasks run on the context's thread, as does
+ *  admission; nothing here is locked.
+ */
+class admission_control
+{
+  public:
+    /** The reply to a call over a limit; sd-bus maps it to ENOBUFS. */
+    static constexpr auto busy_error = SD_BUS_ERROR_LIMITS_EXCEEDED;
+
+    /** A limit of 0 leaves that dimension unbounded. */
+    struct limits
+    {
+        /** Calls of one method in flight. */
+        size_t per_method = 0;
+        /** Calls from one sender in flight, across methods. */
+        size_t per_sender = 0;
+        /** Calls admitted whose handler has not yet started. */
+        size_t queue = 0;
+    };
+
+    /** One method's share of the limits. */
+    struct gate
+    {
+        admission_control* owner = nullptr;
+        std::string name;
+        size_t in_flight = 0;
+        uint64_t admitted = 0;
+        uint64_t rejected = 0;
+    };
+
+    struct statistics
+    {
+        size_t queued = 0;
+        size_t in_flight = 0;
+        uint64_t admitted = 0;
+        uint64_t rejected = 0;
+    };
+
+    admission_control() = delete;
+    admission_control(const admission_control&) = delete;
+    admission_control& operator=(const admission_control&) = delete;
+    admission_control(admission_control&&) = delete;
+    admission_control& operator=(admission_control&&) = delete;
+    ~admission_control() = default;
+
+    explicit admission_control(limits l) : _limits(l) {}
+
+    /** @brief The gate for `interface`.`member`, created on first use. */
+    gate& method(std::string_view interface, std::string_view member)
+    {
+        std::string key{interface};
+        key += '.';
+        key += member;
+
+        auto [i, inserted] = _index.try_emplace(std::move(key), nullptr);
+        if (inserted)
+        {
+            i->second = &_gates.emplace_back();
+            i->second->owner = this;
+            i->second->name = i->first;
+        }
+        return *i->second;
+    }
+
+    /** @brief Admit a call of `g` from `sender`, or count its rejection.
+     *  @return - Whether the call was admitted, and so now queued.
+     */
+    bool admit(gate& g, std::string_view sender)
+    {
+        auto s = _senders.find(sender);
+        auto from_sender = (s == _senders.end()) ? 0 : s->second;
+
+        if (over(g.in_flight, _limits.per_method) ||
+            over(from_sender, _limits.per_sender) ||
+            over(_queued, _limits.queue))
+        {
+            ++g.rejected;
+            ++_rejected;
+            return false;
+        }
+
+        if (s == _senders.end())
+        {
+            s = _senders.emplace(std::string{sender}, 0).first;
+        }
+        ++s->second;
+        ++g.in_flight;
+        ++g.admitted;
+        ++_in_flight;
+        ++_queued;
+        return true;
+    }
+
+    /** @brief An admitted call's handler has started. */
+    void started() noexcept
+    {
+        --_queued;
+    }
+
+    /** @brief An admitted call of `g` from `sender` has been answered. */
+    void finished(gate& g, std::string_view sender)
+    {
+        if (auto s = _senders.find(sender);
+            s != _senders.end() && --s->second == 0)
+        {
+            _senders.erase(s);
+        }
+        --g.in_flight;
+        --_in_flight;
+    }
+
+    const limits& limit() const noexcept
+    {
+        return _limits;
+    }
+
+    statistics stats() const noexcept
+    {
+        return {_queued, _in_flight, admitted(), _rejected};
+    }
+
+    /** @brief Call `f(name, gate)` for each method, in name order. */
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        for (const auto& [name, g] : _index)
+        {
+            f(name, *g);
+        }
+    }
+
+  private:
+    static bool over(size_t n, size_t limit) noexcept
+    {
+        return limit != 0 && n >= limit;
+    }
+
+    uint64_t admitted() const noexcept
+    {
+        uint64_t n = 0;
+        for (const auto& g : _gates)
+        {
+            n += g.admitted;
+        }
+        return n;
+    }
+
+    limits _limits;
+    size_t _queued = 0;
+    size_t _in_flight = 0;
+    uint64_t _rejected = 0;
+    std::map<std::string, gate*, std::less<>> _index;
+    std::deque<gate> _gates;
+    std::map<std::string, size_t, std::less<>> _senders;
+};
+
+/** @brief One call's place within an admission_control.
+ *
+ *  Constructed when the method callback is entered, which admits the call
+ *  or counts its rejection; a rejected call is answered with reject().  The
+ *  ticket moves into the call's task, which marks started() when it first
+ *  runs; destruction releases the call's place.  With a null `gate` every
+ *  call is admitted and every operation is a no-op, so callbacks can admit
+ *  unconditionally.
+ */
+class admission_ticket
+{
+  public:
+    admission_ticket(admission_control::gate* g, sd_bus_message* m) : _gate(g)
+    {
+        if (!_gate)
+        {
+            return;
+        }
+
+        const char* sender = m ? sd_bus_message_get_sender(m) : nullptr;
+        _sender = sender ? sender : "";
+        if (!_gate->owner->admit(*_gate, _sender))
+        {
+            _rejected = true;
+            _gate = nullptr;
+            return;
+        }
+        _queued = true;
+    }
+
+    admission_ticket(const admission_ticket&) = delete;
+    admission_ticket& operator=(const admission_ticket&) = delete;
+    admission_ticket& operator=(admission_ticket&&) = delete;
+
+    admission_ticket(admission_ticket&& other) noexcept :
+        _gate(std::exchange(other._gate, nullptr)),
+        _sender(std::move(other._sender)), _queued(other._queued),
+        _rejected(other._rejected)
+    {}
+
+    ~admission_ticket()
+    {
+        if (!_gate)
+        {
+            return;
+        }
+        started();
+        _gate->owner->finished(*_gate, _sender);
+    }
+
+    /** @return - Whether the call may proceed. */
+    explicit operator bool() const noexcept
+    {
+        return !_rejected;
+    }
+
+    /** @brief The handler is starting; the call leaves the queue. */
+    void started() noexcept
+    {
+        if (_gate && std::exchange(_queued, false))
+        {
+            _gate->owner->started();
+        }
+    }
+
+    /** @brief Answer a rejected call with admission_control::busy_error. */
+    int reject(sd_bus_error* error) const
+    {
+        return sd_bus_error_set(error, admission_control::busy_error,
+                                "Too many calls in flight; retry later.");
+    }
+
+  private:
+    admission_control::gate* _gate;
+    std::string _sender;
+    bool _queued = false;
+    bool _rejected = false;
+};
+
+/** @brief Publishes an admission_control as D-Bus properties.
+ *
+ *  The values are computed when read, so a client can poll QueueDepth and
+ *  back off before its calls are rejected:
+ *
+ *    QueueDepth     u       calls admitted whose handler has not started
+ *    InFlight       u       calls admitted and not yet answered
+ *    Rejected       t       calls answered with busy_error
+ *    Limits         a{su}   "PerMethod", "PerSender", "Queue" -> limit
+ *    MethodInFlight a{su}   "<interface>.<Member>" -> calls in flight
+ */
+class admission_object
+{
+  public:
+    static constexpr auto interface = "xyz.openbmc_project.Debug.Admission";
+    static constexpr auto default_path = "/xyz/openbmc_project/debug/admission";
+
+    admission_object(bus_t& bus, const admission_control& control,
+                     const char* path = default_path) :
+        _control(control), _interface(bus, path, interface, _vtable, this)
+    {}
+
+  private:
+    template <typename F>
+    static int reply(sd_bus_message* reply, void* context, F&& compute)
+    {
+        auto self = static_cast<admission_object*>(context);
+        try
+        {
+            auto m = sdbusplus::message_t{reply};
+            m.append(compute(self->_control));
+        }
+        catch (const std::exception&)
+        {
+            return -EINVAL;
+        }
+        return 1;
+    }
+
+    static int _get_queue_depth(sd_bus*, const char*, const char*,
+                                const char*, sd_bus_message* m,
+                                void* context, sd_bus_error*)
+    {
+        return reply(m, context, [](const admission_control& c) {
+            return static_cast<uint32_t>(c.stats().queued);
+        });
+    }
+
+    static int _get_in_flight(sd_bus*, const char*, const char*, const char*,
+                              sd_bus_message* m, void* context, sd_bus_error*)
+    {
+        return reply(m, context, [](const admission_control& c) {
+            return static_cast<uint32_t>(c.stats().in_flight);
+        });
+    }
+
+    static int _get_rejected(sd_bus*, const char*, const char*, const char*,
+                             sd_bus_message* m, void* context, sd_bus_error*)
+    {
+        return reply(m, context, [](const admission_control& c) {
+            return c.stats().rejected;
+        });
+    }
+
+    static int _get_limits(sd_bus*, const char*, const char*, const char*,
+                           sd_bus_message* m, void* context, sd_bus_error*)
+    {
+        return reply(m, context, [](const admission_control& c) {
+            const auto& l = c.limit();
+            return std::map<std::string, uint32_t>{
+                {"PerMethod", static_cast<uint32_t>(l.per_method)},
+                {"PerSender", static_cast<uint32_t>(l.per_sender)},
+                {"Queue", static_cast<uint32_t>(l.queue)},
+            };
+        });
+    }
+
+    static int _get_method_in_flight(sd_bus*, const char*, const char*,
+                                     const char*, sd_bus_message* m,
+                                     void* context, sd_bus_error*)
+    {
+        return reply(m, context, [](const admission_control& c) {
+            std::map<std::string, uint32_t> result;
+            c.for_each([&](const std::string& name, const auto& g) {
+                result.emplace(name, static_cast<uint32_t>(g.in_flight));
+            });
+            return result;
+        });
+    }
+
+    static constexpr sdbusplus::vtable_t _vtable[] = {
+        vtable::start(),
+        vtable::property("QueueDepth", "u", _get_queue_depth),
+        vtable::property("InFlight", "u", _get_in_flight),
+        vtable::property("Rejected", "t", _get_rejected),
+        vtable::property("Limits", "a{su}", _get_limits),
+        vtable::property("MethodInFlight", "a{su}", _get_method_in_flight),
+        vtable::end(),
+    };
+
+    const admission_control& _control;
+    interface_t _interface;
+};
+
+} // namespace sdbusplus::server
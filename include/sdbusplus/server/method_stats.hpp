@@ -0,0 +1,401 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace sdbusplus::server
+{
+
+/** @brief Lock-free log-linear latency histogram.
+ *
+ *  Values (nanoseconds) are counted in buckets 1/8th of a power of two wide,
+ *  like an HdrHistogram with 3 significant bits, so any percentile is within
+ *  12.5% of the true value.  record() is a few relaxed atomic adds and may
+ *  run concurrently with readers.
+ */
+class latency_histogram
+{
+  public:
+    static constexpr size_t sub_bits = 3;
+    static constexpr size_t sub_buckets = size_t{1} << sub_bits;
+    static constexpr size_t buckets = (64 - sub_bits + 1) * sub_buckets;
+
+    void record(std::chrono::nanoseconds d) noexcept
+    {
+        auto v = static_cast<uint64_t>(std::max<int64_t>(d.count(), 0));
+
+        _counts[index(v)].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(v, std::memory_order_relaxed);
+
+        auto max = _max.load(std::memory_order_relaxed);
+        while (v > max && !_max.compare_exchange_weak(
+                              max, v, std::memory_order_relaxed))
+        {}
+    }
+
+    uint64_t count() const noexcept
+    {
+        return _count.load(std::memory_order_relaxed);
+    }
+
+    /** @return - Mean in nanoseconds. */
+    double mean() const noexcept
+    {
+        auto n = count();
+        return n ? static_cast<double>(_sum.load(std::memory_order_relaxed)) /
+                       static_cast<double>(n)
+                 : 0;
+    }
+
+    /** @return - Largest recorded value in nanoseconds. */
+    uint64_t max() const noexcept
+    {
+        return _max.load(std::memory_order_relaxed);
+    }
+
+    /** @return - The p'th percentile (0 < p <= 1) in nanoseconds. */
+    uint64_t percentile(double p) const noexcept
+    {
+        auto n = count();
+        if (n == 0)
+        {
+            return 0;
+        }
+
+        auto rank = static_cast<uint64_t>(p * static_cast<double>(n));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < buckets; ++i)
+        {
+            seen += _counts[i].load(std::memory_order_relaxed);
+            if (seen > rank)
+            {
+                return std::min(midpoint(i), max());
+            }
+        }
+        return max();
+    }
+
+    static constexpr size_t index(uint64_t v) noexcept
+    {
+        if (v < sub_buckets)
+        {
+            return v;
+        }
+        auto e = static_cast<size_t>(std::bit_width(v)) - 1;
+        auto mantissa = (v >> (e - sub_bits)) & (sub_buckets - 1);
+        return (e - sub_bits + 1) * sub_buckets + mantissa;
+    }
+
+    static constexpr uint64_t midpoint(size_t i) noexcept
+    {
+        if (i < sub_buckets)
+        {
+            return i;
+        }
+        auto e = i / sub_buckets + sub_bits - 1;
+        auto mantissa = i % sub_buckets;
+        auto lower = (sub_buckets + mantissa) << (e - sub_bits);
+        return lower + (uint64_t{1} << (e - sub_bits)) / 2;
+    }
+
+  private:
+    std::array<std::atomic<uint64_t>, buckets> _counts{};
+    std::atomic<uint64_t> _count = 0;
+    std::atomic<uint64_t> _sum = 0;
+    std::atomic<uint64_t> _max = 0;
+};
+
+/** @brief Registry of per-method call counters and latency histograms.
+ *
+ *  Each method's counters are created once, under a lock, by method();
+ *  the returned reference stays valid for the registry's lifetime and is
+ *  updated without locking.
+ */
+class method_stats
+{
+  public:
+    struct counters
+    {
+        std::atomic<uint64_t> calls = 0;
+        std::atomic<uint64_t> errors = 0;
+        /** From the method callback being entered to the handler starting.
+         *  Only async handlers wait there, for their coroutine to be
+         *  scheduled; for synchronous ones it is near zero. */
+        latency_histogram queue_wait;
+        /** From the handler starting to the reply being sent. */
+        latency_histogram handler;
+    };
+
+    method_stats() = default;
+    method_stats(const method_stats&) = delete;
+    method_stats& operator=(const method_stats&) = delete;
+    method_stats(method_stats&&) = delete;
+    method_stats& operator=(method_stats&&) = delete;
+    ~method_stats() = default;
+
+    /** @brief The counters for `interface`.`member`, created on first use. */
+    counters& method(std::string_view interface, std::string_view member)
+    {
+        std::string key{interface};
+        key += '.';
+        key += member;
+
+        std::lock_guard lock(_lock);
+        auto [i, inserted] = _index.try_emplace(std::move(key), nullptr);
+        if (inserted)
+        {
+            i->second = &_counters.emplace_back();
+        }
+        return *i->second;
+    }
+
+    /** @brief Call `f(name, counters)` for each method, in name order. */
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        std::lock_guard lock(_lock);
+        for (const auto& [name, c] : _index)
+        {
+            f(name, *c);
+        }
+    }
+
+  private:
+    mutable std::mutex _lock;
+    std::map<std::string, counters*, std::less<>> _index;
+    std::deque<counters> _counters;
+};
+
+/** @brief Times one method call into a method_stats::counters.
+ *
+ *  Constructed when the method callback is entered.  started() marks the
+ *  handler beginning (immediately for synchronous handlers, when the
+ *  coroutine first runs for async ones); destruction marks the reply.  The
+ *  queue wait is measured from the callback being entered: dbus-daemon
+ *  connections carry no kernel receive time, so the time the message spent
+ *  in the socket and in sd-bus's read queue is not seen.  With a null
+ *  `counters` every operation is a no-op, so callbacks can time
+ *  unconditionally.
+ */
+class method_timer
+{
+  public:
+    using clock = std::chrono::steady_clock;
+
+    method_timer(method_stats::counters* c, sd_bus_message* m) noexcept :
+        _counters(c)
+    {
+        if (!_counters)
+        {
+            return;
+        }
+        _entered = clock::now();
+
+        // The receive time, on transports that stamp messages with it.
+        uint64_t usec = 0;
+        if (m && sd_bus_message_get_monotonic_usec(m, &usec) >= 0)
+        {
+            _received = std::chrono::microseconds(usec);
+        }
+    }
+
+    method_timer(const method_timer&) = delete;
+    method_timer& operator=(const method_timer&) = delete;
+    method_timer& operator=(method_timer&&) = delete;
+
+    method_timer(method_timer&& other) noexcept :
+        _counters(std::exchange(other._counters, nullptr)),
+        _entered(other._entered), _started(other._started),
+        _received(other._received), _failed(other._failed)
+    {}
+
+    ~method_timer()
+    {
+        if (!_counters)
+        {
+            return;
+        }
+        if (_started == clock::time_point{})
+        {
+            started();
+        }
+
+        _counters->handler.record(clock::now() - _started);
+        _counters->calls.fetch_add(1, std::memory_order_relaxed);
+        if (_failed)
+        {
+            _counters->errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /** @brief The handler is starting; record the time spent queued. */
+    void started() noexcept
+    {
+        if (!_counters)
+        {
+            return;
+        }
+        _started = clock::now();
+
+        std::chrono::nanoseconds wait = _started - _entered;
+        if (_received.count())
+        {
+            // CLOCK_MONOTONIC, the same clock as steady_clock on Linux.
+            wait = _started.time_since_epoch() - _received;
+        }
+        _counters->queue_wait.record(wait);
+    }
+
+    /** @brief The call is being answered with an error. */
+    void failed() noexcept
+    {
+        _failed = true;
+    }
+
+  private:
+    method_stats::counters* _counters;
+    clock::time_point _entered{};
+    clock::time_point _started{};
+    std::chrono::nanoseconds _received{};
+    bool _failed = false;
+};
+
+/** @brief Publishes a method_stats registry as D-Bus properties.
+ *
+ *  The values are computed when read, so `busctl get-property` or a scraper
+ *  always sees the current numbers:
+ *
+ *    Calls          a{st}       "<interface>.<Member>" -> calls
+ *    Errors         a{st}       "<interface>.<Member>" -> error replies
+ *    HandlerTimeUs  a{sa{sd}}   "<interface>.<Member>" -> {p50, p90, p99,
+ *    QueueWaitUs    a{sa{sd}}                             p999, max, mean}
+ *
+ *  QueueWaitUs is only meaningful for async handlers; see method_timer.
+ */
+class method_stats_object
+{
+  public:
+    static constexpr auto interface = "xyz.openbmc_project.Debug.MethodStats";
+    static constexpr auto default_path = "/xyz/openbmc_project/debug/methods";
+
+    method_stats_object(bus_t& bus, const method_stats& stats,
+                        const char* path = default_path) :
+        _stats(stats), _interface(bus, path, interface, _vtable, this)
+    {}
+
+  private:
+    using summary_t = std::map<std::string, std::map<std::string, double>>;
+
+    static summary_t summarize(const method_stats& stats,
+                               latency_histogram method_stats::counters::*h)
+    {
+        summary_t result;
+        stats.for_each([&](const std::string& name, const auto& c) {
+            const auto& hist = c.*h;
+            auto us = [](auto ns) { return static_cast<double>(ns) / 1000.0; };
+            result.emplace(
+                name, std::map<std::string, double>{
+                          {"p50", us(hist.percentile(0.50))},
+                          {"p90", us(hist.percentile(0.90))},
+                          {"p99", us(hist.percentile(0.99))},
+                          {"p999", us(hist.percentile(0.999))},
+                          {"max", us(hist.max())},
+                          {"mean", us(hist.mean())},
+                      });
+        });
+        return result;
+    }
+
+    static std::map<std::string, uint64_t> totals(
+        const method_stats& stats,
+        std::atomic<uint64_t> method_stats::counters::*n)
+    {
+        std::map<std::string, uint64_t> result;
+        stats.for_each([&](const std::string& name, const auto& c) {
+            result.emplace(name, (c.*n).load(std::memory_order_relaxed));
+        });
+        return result;
+    }
+
+    template <typename F>
+    static int reply(sd_bus_message* reply, void* context, F&& compute)
+    {
+        auto self = static_cast<method_stats_object*>(context);
+        try
+        {
+            auto m = sdbusplus::message_t{reply};
+            m.append(compute(self->_stats));
+        }
+        catch (const std::exception&)
+        {
+            return -EINVAL;
+        }
+        return 1;
+    }
+
+    static int _get_calls(sd_bus*, const char*, const char*, const char*,
+                          sd_bus_message* m, void* context, sd_bus_error*)
+    {
+        return reply(m, context, [](const method_stats& s) {
+            return totals(s, &method_stats::counters::calls);
+        });
+    }
+
+    static int _get_errors(sd_bus*, const char*, const char*, const char*,
+                           sd_bus_message* m, void* context, sd_bus_error*)
+    {
+        return reply(m, context, [](const method_stats& s) {
+            return totals(s, &method_stats::counters::errors);
+        });
+    }
+
+    static int _get_handler_time(sd_bus*, const char*, const char*,
+                                 const char*, sd_bus_message* m,
+                                 void* context, sd_bus_error*)
+    {
+        return reply(m, context, [](const method_stats& s) {
+            return summarize(s, &method_stats::counters::handler);
+        });
+    }
+
+    static int _get_queue_wait(sd_bus*, const char*, const char*, const char*,
+                               sd_bus_message* m, void* context, sd_bus_error*)
+    {
+        return reply(m, context, [](const method_stats& s) {
+            return summarize(s, &method_stats::counters::queue_wait);
+        });
+    }
+
+    static constexpr sdbusplus::vtable_t _vtable[] = {
+        vtable::start(),
+        vtable::property("Calls", "a{st}", _get_calls),
+        vtable::property("Errors", "a{st}", _get_errors),
+        vtable::property("HandlerTimeUs", "a{sa{sd}}", _get_handler_time),
+        vtable::property("QueueWaitUs", "a{sa{sd}}", _get_queue_wait),
+        vtable::end(),
+    };
+
+    const method_stats& _stats;
+    interface_t _interface;
+};
+
+} // namespace sdbusplus::server
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace sdbusplus::server
+{
+
+/** @brief Coalesces PropertiesChanged signals.
+ *
+ *  Property changes are queued per (path, interface) and sent as a single
+ *  PropertiesChanged per interface when the batch is flushed.  sd-bus reads
+ *  the values through the property getters at that point, so subscribers
+ *  always see the latest value of every property in the signal.
+ *
+ *  The batch does not own an event loop.  The `schedule` callback is invoked
+ *  once whenever the batch goes from empty to dirty; it should arrange for
+ *  `flush()` to run, e.g. on the next loop iteration or after a time window.
+ *  Without one, the owner calls `flush()` itself.
+ */
+class property_batch
+{
+  public:
+    /** Counters since construction. */
+    struct statistics
+    {
+        /** Property changes queued; one signal each without batching. */
+        uint64_t changes = 0;
+        /** PropertiesChanged signals actually sent. */
+        uint64_t signals = 0;
+        /** Signals that could not be sent, ex. the object was removed. */
+        uint64_t failures = 0;
+
+        /** Signals avoided by coalescing. */
+        uint64_t saved() const noexcept
+        {
+            return changes - signals - failures;
+        }
+    };
+
+    property_batch() = delete;
+    property_batch(const property_batch&) = delete;
+    property_batch& operator=(const property_batch&) = delete;
+    property_batch(property_batch&&) = delete;
+    property_batch& operator=(property_batch&&) = delete;
+    ~property_batch() = default;
+
+    /** @brief Construct a batch emitting on a bus.
+     *  @param[in] bus - Bus to emit on.
+     *  @param[in] schedule - Called when the batch becomes dirty.
+     */
+    explicit property_batch(bus_t& bus, std::function<void()> schedule = {}) :
+        _bus(bus), _schedule(std::move(schedule))
+    {}
+
+    /** @brief Queue a PropertiesChanged for one property.
+     *  @param[in] path - Object path.
+     *  @param[in] interface - Interface holding the property.
+     *  @param[in] property - The property that changed.
+     */
+    void mark(std::string_view path, std::string_view interface,
+              std::string_view property)
+    {
+        bool wasEmpty = _pending.empty();
+
+        auto& names = _pending[{std::string(path), std::string(interface)}];
+        if (std::ranges::find(names, property) == names.end())
+        {
+            names.emplace_back(property);
+        }
+        ++_stats.changes;
+
+        if (wasEmpty && _schedule)
+        {
+            _schedule();
+        }
+    }
+
+    /** @brief Send one PropertiesChanged per dirty interface. */
+    void flush()
+    {
+        auto queued = std::exchange(_pending, {});
+
+        for (auto& [key, names] : queued)
+        {
+            std::vector<char*> strv;
+            for (auto& n : names)
+            {
+                strv.push_back(n.data());
+            }
+            strv.push_back(nullptr);
+
+            auto r = sd_bus_emit_properties_changed_strv(
+                _bus.get(), key.first.c_str(), key.second.c_str(),
+                strv.data());
+
+            if (r < 0)
+            {
+                _stats.failures += names.size();
+            }
+            else
+            {
+                ++_stats.signals;
+            }
+        }
+    }
+
+    /** @return true if changes are waiting to be flushed. */
+    bool dirty() const noexcept
+    {
+        return !_pending.empty();
+    }
+
+    const statistics& stats() const noexcept
+    {
+        return _stats;
+    }
+
+  private:
+    bus_t& _bus;
+    std::function<void()> _schedule;
+    std::map<std::pair<std::string, std::string>, std::vector<std::string>>
+        _pending;
+    statistics _stats;
+};
+
+} // namespace sdbusplus::server
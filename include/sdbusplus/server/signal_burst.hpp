@@ -0,0 +1,201 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/message/append_as.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sdbusplus::server
+{
+
+/** @brief Queues signals and sends them in bursts.
+ *
+ *  Signals are built as they are queued, with string arguments appended
+ *  straight from views, and sent back to back by flush().  A signal whose
+ *  body never changes (a heartbeat, a fixed event) can be built once with
+ *  prebuilt() and queued again and again without being rebuilt.
+ *
+ *  sd-bus writes what the socket accepts and keeps the rest in its write
+ *  queue until the connection is next processed.  flush() records when
+ *  that happens (backpressure) and, past `high_water` queued messages,
+ *  blocks until the queue drains rather than let it grow without bound.
+ */
+class signal_burst
+{
+  public:
+    /** Counters since construction. */
+    struct statistics
+    {
+        /** Signals handed to sd-bus. */
+        uint64_t sent = 0;
+        /** flush() calls that sent something. */
+        uint64_t bursts = 0;
+        /** Sends that left messages waiting for the socket. */
+        uint64_t backpressure = 0;
+        /** Largest sd-bus write queue seen. */
+        uint64_t max_queued = 0;
+        /** Times flush() blocked because the queue passed high_water. */
+        uint64_t blocked = 0;
+    };
+
+    signal_burst() = delete;
+    signal_burst(const signal_burst&) = delete;
+    signal_burst& operator=(const signal_burst&) = delete;
+    signal_burst(signal_burst&&) = delete;
+    signal_burst& operator=(signal_burst&&) = delete;
+    ~signal_burst() = default;
+
+    /** @brief Construct a burst sender.
+     *  @param[in] bus - Bus to emit on.
+     *  @param[in] high_water - sd-bus write queue length at which flush()
+     *                          blocks until the socket catches up.
+     */
+    explicit signal_burst(bus_t& bus, size_t high_water = 4096) :
+        _bus(bus), _high_water(high_water)
+    {}
+
+    /** @brief Build a signal and queue it until the next flush(). */
+    template <typename... Args>
+    void queue(const char* path, const char* interface, const char* member,
+               const Args&... args)
+    {
+        _queued.emplace_back(build(path, interface, member, args...));
+    }
+
+    /** @brief Queue a signal from prebuilt() again. */
+    void queue(message_t& prebuilt)
+    {
+        _queued.emplace_back(prebuilt.get());
+    }
+
+    /** @brief Build a signal that can be queued many times.
+     *
+     *  Its first send seals it with the connection's next serial, and
+     *  every later send reuses that serial, so receivers that track
+     *  serials see the same one for each copy.
+     */
+    template <typename... Args>
+    message_t prebuilt(const char* path, const char* interface,
+                       const char* member, const Args&... args)
+    {
+        return build(path, interface, member, args...);
+    }
+
+    /** @brief Send every queued signal.
+     *
+     *  If sd-bus refuses a signal, the SdBusError is thrown and that signal
+     *  and the ones after it stay queued, in order, for the next flush();
+     *  pending() counts them.
+     *
+     *  @return - The number of signals this call sent.
+     */
+    size_t flush()
+    {
+        auto queued = std::exchange(_queued, {});
+
+        size_t sent = 0;
+        for (auto& m : queued)
+        {
+            auto r = sd_bus_send(_bus.get(), m.get(), nullptr);
+            if (r < 0)
+            {
+                _queued.assign(std::make_move_iterator(queued.begin() + sent),
+                               std::make_move_iterator(queued.end()));
+                if (sent)
+                {
+                    ++_stats.bursts;
+                }
+                throw exception::SdBusError(-r, "sd_bus_send");
+            }
+            ++sent;
+            ++_stats.sent;
+
+            uint64_t waiting = 0;
+            if (sd_bus_get_n_queued_write(_bus.get(), &waiting) < 0 ||
+                waiting == 0)
+            {
+                continue;
+            }
+
+            ++_stats.backpressure;
+            _stats.max_queued = std::max(_stats.max_queued, waiting);
+            if (waiting >= _high_water)
+            {
+                ++_stats.blocked;
+                _bus.flush();
+            }
+        }
+
+        if (!queued.empty())
+        {
+            ++_stats.bursts;
+        }
+
+        // Keep the vector's capacity for the next burst.
+        queued.clear();
+        _queued = std::move(queued);
+        return sent;
+    }
+
+    /** @return - Signals waiting for flush(). */
+    size_t pending() const noexcept
+    {
+        return _queued.size();
+    }
+
+    const statistics& stats() const noexcept
+    {
+        return _stats;
+    }
+
+  private:
+    template <typename... Args>
+    message_t build(const char* path, const char* interface,
+                    const char* member, const Args&... args)
+    {
+        sd_bus_message* raw = nullptr;
+        auto r = sd_bus_message_new_signal(_bus.get(), &raw, path, interface,
+                                           member);
+        if (r < 0)
+        {
+            throw exception::SdBusError(-r, "sd_bus_message_new_signal");
+        }
+        message_t m{raw, std::false_type{}};
+
+        (append(m, args), ...);
+        return m;
+    }
+
+    template <typename T>
+    static void append(message_t& m, const T& v)
+    {
+        if constexpr (std::is_convertible_v<const T&, std::string_view> &&
+                      !std::is_same_v<T, std::string>)
+        {
+            message::append_as<std::string>(m, std::string_view(v));
+        }
+        else
+        {
+            m.append(v);
+        }
+    }
+
+    bus_t& _bus;
+    size_t _high_water;
+    std::vector<message_t> _queued;
+    statistics _stats;
+};
+
+} // namespace sdbusplus::server
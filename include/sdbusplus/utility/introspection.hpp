@@ -0,0 +1,376 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace sdbusplus::utility
+{
+
+/** Kinds of interface member reported by parse_introspection(). */
+enum class introspection_member
+{
+    method,
+    signal,
+};
+
+namespace details
+{
+
+enum class introspection_element
+{
+    node,
+    interface,
+    method,
+    signal,
+    property,
+    arg,
+    other,
+};
+
+inline introspection_element introspection_kind(std::string_view name)
+{
+    using enum introspection_element;
+    if (name == "node")
+    {
+        return node;
+    }
+    if (name == "interface")
+    {
+        return interface;
+    }
+    if (name == "method")
+    {
+        return method;
+    }
+    if (name == "signal")
+    {
+        return signal;
+    }
+    if (name == "property")
+    {
+        return property;
+    }
+    if (name == "arg")
+    {
+        return arg;
+    }
+    return other;
+}
+
+/* The attributes of one tag that the parser reports. */
+struct introspection_attributes
+{
+    enum index
+    {
+        name,
+        type,
+        access,
+        direction,
+        count,
+    };
+
+    std::array<std::string_view, count> values{};
+    /* Storage for values that needed entity decoding. */
+    std::array<std::string, count> decoded{};
+
+    std::string_view operator[](index i) const noexcept
+    {
+        return values[i];
+    }
+
+    void set(std::string_view key, std::string_view value)
+    {
+        index i = count;
+        if (key == "name")
+        {
+            i = name;
+        }
+        else if (key == "type")
+        {
+            i = type;
+        }
+        else if (key == "access")
+        {
+            i = access;
+        }
+        else if (key == "direction")
+        {
+            i = direction;
+        }
+        if (i == count)
+        {
+            return;
+        }
+
+        if (value.find('&') == std::string_view::npos)
+        {
+            values[i] = value;
+            return;
+        }
+        decoded[i] = decode(value);
+        values[i] = decoded[i];
+    }
+
+    void clear() noexcept
+    {
+        values = {};
+    }
+
+    static std::string decode(std::string_view v)
+    {
+        static constexpr std::array<std::pair<std::string_view, char>, 5>
+            entities{{{"&amp;", '&'},
+                      {"&lt;", '<'},
+                      {"&gt;", '>'},
+                      {"&quot;", '"'},
+                      {"&apos;", '\''}}};
+
+        std::string r;
+        r.reserve(v.size());
+        while (!v.empty())
+        {
+            bool replaced = false;
+            if (v.front() == '&')
+            {
+                for (const auto& [e, c] : entities)
+                {
+                    if (v.starts_with(e))
+                    {
+                        r += c;
+                        v.remove_prefix(e.size());
+                        replaced = true;
+                        break;
+                    }
+                }
+            }
+            if (!replaced)
+            {
+                r += v.front();
+                v.remove_prefix(1);
+            }
+        }
+        return r;
+    }
+};
+
+} // namespace details
+
+/** @brief Parse D-Bus introspection XML in one pass, without building a
+ *         document.
+ *
+ *  Reports, for the object that was introspected (the outermost <node>):
+ *    h.child(name)                   - each child <node>, name as written;
+ *    h.interface(name) -> bool       - each <interface>; returning false
+ *                                      skips its members unparsed;
+ *    h.member(kind, name)            - each <method> or <signal>;
+ *    h.arg(type, direction)          - each <arg> of the last member, with
+ *                                      direction empty if not given;
+ *    h.property(name, type, access)  - each <property>.
+ *
+ *  Annotations, comments, the DOCTYPE and anything inside child nodes are
+ *  skipped.  String arguments point into `xml` or the parser's scratch
+ *  space and are only valid during the call.
+ *
+ *  @return - false if the XML is malformed.
+ */
+template <typename Handler>
+bool parse_introspection(std::string_view xml, Handler& h)
+{
+    using enum details::introspection_element;
+    using attributes = details::introspection_attributes;
+
+    std::vector<details::introspection_element> open;
+    size_t nodes = 0;
+    attributes attrs;
+    size_t pos = 0;
+
+    auto isSpace = [](char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    };
+
+    while (true)
+    {
+        pos = xml.find('<', pos);
+        if (pos == std::string_view::npos)
+        {
+            return open.empty();
+        }
+        auto rest = xml.substr(pos);
+
+        // Declarations, comments and the DOCTYPE carry nothing we report.
+        if (rest.starts_with("<?") || rest.starts_with("<!"))
+        {
+            size_t end = 0;
+            if (rest.starts_with("<!--"))
+            {
+                end = rest.find("-->");
+            }
+            else if (rest.starts_with("<?"))
+            {
+                end = rest.find("?>");
+            }
+            else
+            {
+                // A DOCTYPE may carry an internal subset in [].
+                end = rest.find('>');
+                if (rest.find('[') < end)
+                {
+                    end = rest.find("]>");
+                }
+            }
+            if (end == std::string_view::npos)
+            {
+                return false;
+            }
+            pos += end + 1;
+            continue;
+        }
+
+        if (rest.starts_with("</"))
+        {
+            auto end = rest.find('>');
+            if (end == std::string_view::npos || open.empty())
+            {
+                return false;
+            }
+            if (open.back() == node)
+            {
+                --nodes;
+            }
+            open.pop_back();
+            pos += end + 1;
+            continue;
+        }
+
+        // <name attr="value" ...> or <name ... />
+        size_t i = 1;
+        while (i < rest.size() && !isSpace(rest[i]) && rest[i] != '>' &&
+               rest[i] != '/')
+        {
+            ++i;
+        }
+        auto kind = details::introspection_kind(rest.substr(1, i - 1));
+
+        attrs.clear();
+        bool closed = false;
+        while (true)
+        {
+            while (i < rest.size() && isSpace(rest[i]))
+            {
+                ++i;
+            }
+            if (i >= rest.size())
+            {
+                return false;
+            }
+            if (rest[i] == '>')
+            {
+                ++i;
+                break;
+            }
+            if (rest.substr(i).starts_with("/>"))
+            {
+                i += 2;
+                closed = true;
+                break;
+            }
+
+            auto eq = rest.find('=', i);
+            if (eq == std::string_view::npos || eq + 1 >= rest.size())
+            {
+                return false;
+            }
+            auto key = rest.substr(i, eq - i);
+            while (!key.empty() && isSpace(key.back()))
+            {
+                key.remove_suffix(1);
+            }
+            auto q = eq + 1;
+            while (q < rest.size() && isSpace(rest[q]))
+            {
+                ++q;
+            }
+            if (q >= rest.size() || (rest[q] != '"' && rest[q] != '\''))
+            {
+                return false;
+            }
+            auto close = rest.find(rest[q], q + 1);
+            if (close == std::string_view::npos)
+            {
+                return false;
+            }
+            attrs.set(key, rest.substr(q + 1, close - q - 1));
+            i = close + 1;
+        }
+        pos += i;
+
+        auto parent = open.empty() ? other : open.back();
+        // Only the introspected node's own elements are reported.
+        bool own = nodes == 1;
+
+        switch (kind)
+        {
+            case node:
+                if (own && parent == node)
+                {
+                    h.child(attrs[attributes::name]);
+                }
+                break;
+            case interface:
+                if (own && parent == node &&
+                    !h.interface(attrs[attributes::name]) && !closed)
+                {
+                    // Interfaces do not nest; jump to this one's end.
+                    auto end = xml.find("</interface>", pos);
+                    if (end == std::string_view::npos)
+                    {
+                        return false;
+                    }
+                    pos = end + std::string_view("</interface>").size();
+                    continue;
+                }
+                break;
+            case method:
+            case signal:
+                if (own && parent == interface)
+                {
+                    h.member(kind == method ? introspection_member::method
+                                            : introspection_member::signal,
+                             attrs[attributes::name]);
+                }
+                break;
+            case property:
+                if (own && parent == interface)
+                {
+                    h.property(attrs[attributes::name],
+                               attrs[attributes::type],
+                               attrs[attributes::access]);
+                }
+                break;
+            case arg:
+                if (own && (parent == method || parent == signal))
+                {
+                    h.arg(attrs[attributes::type],
+                          attrs[attributes::direction]);
+                }
+                break;
+            case other:
+                break;
+        }
+
+        if (!closed)
+        {
+            if (kind == node)
+            {
+                ++nodes;
+            }
+            open.push_back(kind);
+        }
+    }
+}
+
+} // namespace sdbusplus::utility
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace sdbusplus::utility::perfect_hash
+{
+
+/** @brief Integer finalizer used for both levels of the hash.
+ *
+ *  Must match `mix` in tools/sdbusplus/perfecthash.py.
+ */
+constexpr uint32_t mix(uint32_t h) noexcept
+{
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return h;
+}
+
+/** @brief 32-bit FNV-1a, finalized with `mix`.
+ *
+ *  Must match `fnv1a` in tools/sdbusplus/perfecthash.py, which builds the
+ *  displacement tables consumed by `lookup`.
+ */
+constexpr uint32_t hash(std::string_view s) noexcept
+{
+    uint32_t h = 2166136261u;
+    for (auto c : s)
+    {
+        h ^= static_cast<uint8_t>(c);
+        h *= 16777619u;
+    }
+    return mix(h);
+}
+
+/** @brief Map a name to its slot in an sdbus++ generated perfect hash.
+ *
+ *  Every known name maps to a distinct slot in [0, N).  Unknown names map to
+ *  an arbitrary slot, so the caller must still compare against the name
+ *  stored there.  The string is only walked once; the displacement re-mixes
+ *  the first-level hash.
+ *
+ *  @param[in] s - The name to look up.
+ *  @param[in] displacements - The table generated by sdbus++.
+ *
+ *  @return - The slot for `s`.
+ */
+template <size_t N>
+constexpr size_t lookup(std::string_view s,
+                        const std::array<int32_t, N>& displacements) noexcept
+{
+    static_assert(N > 0, "Empty perfect hash table.");
+
+    auto h = hash(s);
+    auto d = displacements[h % N];
+    if (d < 0)
+    {
+        return static_cast<size_t>(-d - 1);
+    }
+    return mix(h ^ static_cast<uint32_t>(d)) % N;
+}
+
+} // namespace sdbusplus::utility::perfect_hash
@@ -1,30 +1,41 @@
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/connection_pool.hpp>
+#include <sdbusplus/message/arena.hpp>
 
 #include <cstdint>
 #include <iostream>
+#include <memory_resource>
+#include <string_view>
+#include <tuple>
 
 /** An example dbus client application.
  *  Calls org.freedesktop.login1's ListUsers interface to find all active
  *  users in the system and displays their username.
+ *
+ *  The reply is read with message::unpack_arena(): the list is allocated
+ *  from an arena and the names are views into the reply, so neither may
+ *  outlive the other.
  */
 
 int main()
 {
     using namespace sdbusplus;
 
-    auto b = bus::new_default_system();
-    auto m =
-        b.new_method_call("org.freedesktop.login1", "/org/freedesktop/login1",
-                          "org.freedesktop.login1.Manager", "ListUsers");
-    auto reply = b.call(m);
+    using return_type = std::pmr::vector<
+        std::tuple<uint32_t, std::string_view, std::string_view>>;
 
-    using return_type =
-        std::vector<std::tuple<uint32_t, std::string, message::object_path>>;
-    auto users = reply.unpack<return_type>();
+    auto reply = bus::connection_pool::system_pool().with([](bus_t& b) {
+        auto m = b.new_method_call(
+            "org.freedesktop.login1", "/org/freedesktop/login1",
+            "org.freedesktop.login1.Manager", "ListUsers");
+        return b.call(m);
+    });
 
-    for (auto& user : users)
+    std::pmr::monotonic_buffer_resource arena;
+    for (const auto& [uid, name, path] :
+         message::unpack_arena<return_type>(reply, arena))
     {
-        std::cout << std::get<std::string>(user) << "\n";
+        std::cout << name << "\n";
     }
 
     return 0;
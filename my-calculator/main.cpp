@@ -5,17 +5,46 @@
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/exception.hpp>
 
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#ifndef BOOST_ASIO_DISABLE_THREADS
+#include <sdbusplus/asio/strand_pool.hpp>
+#endif
+
 class CalculatorService {
   public:
-    CalculatorService(boost::asio::io_context& io) : 
+    CalculatorService(boost::asio::io_context& io, size_t threads = 0) : 
         conn_(std::make_shared<sdbusplus::asio::connection>(io, sdbusplus::bus::new_system())),
         objServer_(conn_) 
     {
+#ifndef BOOST_ASIO_DISABLE_THREADS
+        // Bus I/O stays on this thread; method bodies go to the workers.
+        if (threads > 0) {
+            pool_ = std::make_unique<sdbusplus::asio::strand_pool>(threads);
+        }
+#else
+        if (threads > 0) {
+            std::cerr << "Built without asio-threads; running single-threaded" << std::endl;
+        }
+#endif
         conn_->request_name(serviceName_);
         setupInterface();
     }
 
   private:
+    // Run a method body on this object's strand when threaded, else inline.
+    template <typename F>
+    auto dispatch(boost::asio::yield_context yield [[maybe_unused]], F&& f) {
+#ifndef BOOST_ASIO_DISABLE_THREADS
+        if (pool_) {
+            return pool_->run(objectPath_, yield, std::forward<F>(f));
+        }
+#endif
+        return f();
+    }
+
     void setupInterface() {
         calculatorIface_ = objServer_.add_unique_interface(
             objectPath_, interfaceName_,
@@ -38,7 +67,7 @@ class CalculatorService {
                 // This satisfies the "No dbus type conversion" error.
                 
                 i.register_method("Multiply", 
-                    [this](boost::asio::yield_context /*yield*/, int64_t x, int64_t y) {
+                    [this](boost::asio::yield_context yield, int64_t x, int64_t y) {
                         // 1.
                         // Simulate a 2-second cloud calculation
                         // boost::asio::steady_timer timer(conn_->get_io_context());
@@ -51,16 +80,22 @@ class CalculatorService {
                         //     *conn_, destService, destPath, destIface, "Value", yield[ec]);
                         // lastResult_ = ... taxRate;
 
-                        lastResult_ = x * y;
+                        // Computed on a worker; lastResult_ belongs to the
+                        // bus thread, where dispatch() resumes.
+                        lastResult_ = dispatch(yield, [x, y] {
+                            return x * y;
+                        });
                         return lastResult_; // Returns int64_t directly
                     });
 
                 i.register_method("Divide", 
-                    [this](boost::asio::yield_context /*yield*/, int64_t x, int64_t y) {
-                        if (y == 0) {
-                            throw sdbusplus::exception::SdBusError(EDOM, "DivisionByZero");
-                        }
-                        lastResult_ = x / y;
+                    [this](boost::asio::yield_context yield, int64_t x, int64_t y) {
+                        lastResult_ = dispatch(yield, [x, y] {
+                            if (y == 0) {
+                                throw sdbusplus::exception::SdBusError(EDOM, "DivisionByZero");
+                            }
+                            return x / y;
+                        });
                         return lastResult_;
                     });
 
@@ -79,6 +114,9 @@ class CalculatorService {
     std::shared_ptr<sdbusplus::asio::connection> conn_;
     sdbusplus::asio::object_server objServer_;
     std::unique_ptr<sdbusplus::asio::dbus_interface> calculatorIface_;
+#ifndef BOOST_ASIO_DISABLE_THREADS
+    std::unique_ptr<sdbusplus::asio::strand_pool> pool_;
+#endif
 
     const char* serviceName_ = "xyz.openbmc_project.Calculator";
     const char* objectPath_ = "/xyz/openbmc_project/calculator";
@@ -88,10 +126,17 @@ class CalculatorService {
     std::string status_ = "xyz.openbmc_project.Calculator.State.Success";
 };
 
-int main() {
+// usage: calculator-server [--threads <n>]
+//   --threads needs a build with -Dasio-threads=enabled.
+int main(int argc, char** argv) {
+    size_t threads = 0;
+    if (argc == 3 && std::string(argv[1]) == "--threads") {
+        threads = std::strtoul(argv[2], nullptr, 10);
+    }
+
     try {
         boost::asio::io_context io;
-        CalculatorService calc(io);
+        CalculatorService calc(io, threads);
         io.run();
     }
     catch (const std::exception& e) {
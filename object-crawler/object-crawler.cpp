@@ -0,0 +1,118 @@
+#include <sdbusplus/async.hpp>
+#include <sdbusplus/async/crawler.hpp>
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/** Walk the object trees of one or more services with Introspect.
+ *
+ *  usage: object-crawler [--concurrency <n>] [--root <path>] [--list]
+ *                        <service>...
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+    sdbusplus::async::crawl_options crawl;
+    bool list = false;
+    std::vector<std::string> services;
+};
+
+void print(const std::string& service,
+           const sdbusplus::async::object_model& model, bool list)
+{
+    const auto& stats = model.stats();
+    std::cout << service << " (" << model.owner() << "): " << model.size()
+              << " objects, " << model.interface_count() << " interfaces, "
+              << model.interface_sets() << " interface sets, " << stats.calls
+              << " calls, " << stats.errors << " errors\n";
+
+    if (!list)
+    {
+        return;
+    }
+    for (size_t i = 0; i < model.size(); ++i)
+    {
+        std::cout << "  " << model.path(i) << "\n";
+        for (auto id : model.interfaces(i))
+        {
+            std::cout << "    " << model.interface(id).name << "\n";
+        }
+    }
+}
+
+auto startup(sdbusplus::async::context& ctx, const Options& opts)
+    -> sdbusplus::async::task<>
+{
+    auto start = Clock::now();
+    auto models = co_await sdbusplus::async::crawl(ctx, opts.services,
+                                                   opts.crawl);
+    auto elapsed = Clock::now() - start;
+
+    for (const auto& service : opts.services)
+    {
+        auto it = models.find(service);
+        if (it == models.end())
+        {
+            std::cout << service << ": not found\n";
+            continue;
+        }
+        print(service, *it->second, opts.list);
+    }
+
+    std::cout << "Crawled in "
+              << std::chrono::duration<double, std::milli>(elapsed).count()
+              << " ms\n";
+
+    ctx.request_stop();
+    co_return;
+}
+
+int main(int argc, const char* argv[])
+{
+    Options opts;
+    bool usage = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--concurrency" && i + 1 < argc)
+        {
+            opts.crawl.concurrency = std::stoul(argv[++i]);
+        }
+        else if (arg == "--root" && i + 1 < argc)
+        {
+            opts.crawl.root = argv[++i];
+        }
+        else if (arg == "--list")
+        {
+            opts.list = true;
+        }
+        else if (arg.starts_with("-"))
+        {
+            usage = true;
+            break;
+        }
+        else
+        {
+            opts.services.emplace_back(std::move(arg));
+        }
+    }
+    if (usage || opts.services.empty())
+    {
+        std::cerr << "usage: " << argv[0]
+                  << " [--concurrency <n>] [--root <path>] [--list]"
+                     " <service>...\n";
+        return -1;
+    }
+
+    sdbusplus::async::context ctx;
+    ctx.spawn(startup(ctx, opts));
+    ctx.run();
+
+    return 0;
+}
@@ -0,0 +1,447 @@
+#include "object_index.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <boost/asio/io_context.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/asio/method_stats.hpp>
+#include <sdbusplus/asio/object_server.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/method_stats.hpp>
+#include <sdbusplus/utility/introspection.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/** A minimal xyz.openbmc_project.ObjectMapper.
+ *
+ *  Each service is read once, when its well-known name appears: its object
+ *  managers are found with one Introspect pass from "/", which stops at the
+ *  first manager on each branch, and each is read with GetManagedObjects
+ *  and, for its own path, the Introspect reply.
+ *  From then on the index is kept current from InterfacesAdded,
+ *  InterfacesRemoved and NameOwnerChanged alone.  GetObject, GetSubTree and
+ *  GetSubTreePaths answer from memory.
+ */
+
+constexpr auto mapperService = "xyz.openbmc_project.ObjectMapper";
+constexpr auto mapperPath = "/xyz/openbmc_project/object_mapper";
+constexpr auto mapperInterface = "xyz.openbmc_project.ObjectMapper";
+
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+
+void check(int r, const char* what)
+{
+    if (r < 0)
+    {
+        throw sdbusplus::exception::SdBusError(-r, what);
+    }
+}
+
+/* Read an a{sa{sv}} of interfaces and properties, keeping only the
+ * interface names; the properties are skipped undecoded. */
+std::vector<std::string_view> readInterfaces(sd_bus_message* m)
+{
+    std::vector<std::string_view> interfaces;
+
+    check(sd_bus_message_enter_container(m, 'a', "{sa{sv}}"), "enter a");
+    while (true)
+    {
+        auto r = sd_bus_message_enter_container(m, 'e', "sa{sv}");
+        check(r, "enter e");
+        if (r == 0)
+        {
+            break;
+        }
+        const char* name = nullptr;
+        check(sd_bus_message_read_basic(m, 's', &name), "read s");
+        check(sd_bus_message_skip(m, "a{sv}"), "skip a{sv}");
+        check(sd_bus_message_exit_container(m), "exit e");
+        interfaces.emplace_back(name);
+    }
+    check(sd_bus_message_exit_container(m), "exit a");
+
+    return interfaces;
+}
+
+/* What the manager search needs from one Introspect reply. */
+struct ManagerScan
+{
+    std::vector<std::string> children;
+    /** The node's own interfaces, less those every object has. */
+    std::vector<std::string> interfaces;
+    bool manager = false;
+
+    void child(std::string_view name)
+    {
+        if (!name.empty())
+        {
+            children.emplace_back(name);
+        }
+    }
+
+    bool interface(std::string_view name)
+    {
+        manager = manager || name == "org.freedesktop.DBus.ObjectManager";
+        if (name != "org.freedesktop.DBus.Peer" &&
+            name != "org.freedesktop.DBus.Introspectable" &&
+            name != "org.freedesktop.DBus.Properties")
+        {
+            interfaces.emplace_back(name);
+        }
+        return false;
+    }
+
+    void member(sdbusplus::utility::introspection_member, std::string_view) {}
+    void arg(std::string_view, std::string_view) {}
+    void property(std::string_view, std::string_view, std::string_view) {}
+};
+
+std::string childPath(const std::string& parent, const std::string& child)
+{
+    if (child.starts_with('/'))
+    {
+        return child;
+    }
+    return (parent == "/" ? std::string() : parent) + '/' + child;
+}
+
+} // namespace
+
+class ObjectMapper
+{
+  public:
+    explicit ObjectMapper(std::shared_ptr<sdbusplus::asio::connection> conn) :
+        conn_(std::move(conn)), server_(conn_),
+        statsObject_(*conn_, stats_),
+        interfacesAdded_(*conn_,
+                         sdbusplus::bus::match::rules::interfacesAdded(),
+                         [this](sdbusplus::message_t& m) {
+                             onInterfacesAdded(m);
+                         }),
+        interfacesRemoved_(*conn_,
+                           sdbusplus::bus::match::rules::interfacesRemoved(),
+                           [this](sdbusplus::message_t& m) {
+                               onInterfacesRemoved(m);
+                           }),
+        nameOwnerChanged_(*conn_,
+                          sdbusplus::bus::match::rules::nameOwnerChanged(),
+                          [this](sdbusplus::message_t& m) {
+                              onNameOwnerChanged(m);
+                          })
+    {
+        setupInterface();
+        discover();
+        conn_->request_name(mapperService);
+    }
+
+  private:
+    void setupInterface()
+    {
+        iface_ = server_.add_interface(mapperPath, mapperInterface);
+
+        sdbusplus::asio::register_timed_method(
+            *iface_, stats_, "GetObject",
+            [this](const std::string& path,
+                   const std::vector<std::string>& interfaces) {
+                auto r = index_.getObject(path, interfaces);
+                if (!r)
+                {
+                    throw sdbusplus::exception::SdBusError(ENOENT,
+                                                           "GetObject");
+                }
+                return *r;
+            });
+
+        sdbusplus::asio::register_timed_method(
+            *iface_, stats_, "GetSubTree",
+            [this](const std::string& path, int32_t depth,
+                   const std::vector<std::string>& interfaces) {
+                auto r = index_.getSubTree(path, depth, interfaces);
+                if (!r)
+                {
+                    throw sdbusplus::exception::SdBusError(ENOENT,
+                                                           "GetSubTree");
+                }
+                return *r;
+            });
+
+        sdbusplus::asio::register_timed_method(
+            *iface_, stats_, "GetSubTreePaths",
+            [this](const std::string& path, int32_t depth,
+                   const std::vector<std::string>& interfaces) {
+                auto r = index_.getSubTreePaths(path, depth, interfaces);
+                if (!r)
+                {
+                    throw sdbusplus::exception::SdBusError(
+                        ENOENT, "GetSubTreePaths");
+                }
+                return *r;
+            });
+
+        iface_->initialize();
+    }
+
+    bool ignored(std::string_view name) const
+    {
+        return name == "org.freedesktop.DBus" || name == mapperService ||
+               name == conn_->get_unique_name();
+    }
+
+    /* Find the services already on the bus.  The matches are in place, so
+     * nothing that changes meanwhile is missed. */
+    void discover()
+    {
+        started_ = Clock::now();
+        ++pending_;
+        conn_->async_method_call(
+            [this](const boost::system::error_code& ec,
+                   const std::vector<std::string>& names) {
+                if (ec)
+                {
+                    std::cerr << "ListNames failed: " << ec.message() << "\n";
+                    done();
+                    return;
+                }
+                for (const auto& name : names)
+                {
+                    if (name.starts_with(':') || ignored(name))
+                    {
+                        continue;
+                    }
+                    ++pending_;
+                    conn_->async_method_call(
+                        [this, name](const boost::system::error_code& e,
+                                     const std::string& owner) {
+                            if (!e)
+                            {
+                                nameAcquired(name, owner);
+                            }
+                            done();
+                        },
+                        "org.freedesktop.DBus", "/org/freedesktop/DBus",
+                        "org.freedesktop.DBus", "GetNameOwner", name);
+                }
+                done();
+            },
+            "org.freedesktop.DBus", "/org/freedesktop/DBus",
+            "org.freedesktop.DBus", "ListNames");
+    }
+
+    void nameAcquired(const std::string& name, const std::string& owner)
+    {
+        index_.addName(owner, name);
+        if (crawled_.insert(owner).second)
+        {
+            crawl(owner);
+        }
+    }
+
+    /* Read everything `owner` has under its object managers, once. */
+    void crawl(const std::string& owner)
+    {
+        findManagers(owner, "/");
+    }
+
+    /* Introspect `path`: read its objects if it is an object manager,
+     * else look for managers below it.  A manager's subtree is not
+     * descended into; GetManagedObjects covers it, but not the manager's
+     * own path, which is indexed from the Introspect reply. */
+    void findManagers(const std::string& owner, const std::string& path)
+    {
+        ++pending_;
+        conn_->async_method_call(
+            [this, owner, path](const boost::system::error_code& ec,
+                                const std::string& xml) {
+                ManagerScan scan;
+                if (!ec && sdbusplus::utility::parse_introspection(xml, scan))
+                {
+                    if (scan.manager)
+                    {
+                        index_.add(owner, path, scan.interfaces);
+                        readManager(owner, path);
+                    }
+                    else
+                    {
+                        for (const auto& c : scan.children)
+                        {
+                            findManagers(owner, childPath(path, c));
+                        }
+                    }
+                }
+                done();
+            },
+            owner, path, "org.freedesktop.DBus.Introspectable", "Introspect");
+    }
+
+    /* Read every object under the object manager at `path`. */
+    void readManager(const std::string& owner, const std::string& path)
+    {
+        auto m = conn_->new_method_call(owner.c_str(), path.c_str(),
+                                        "org.freedesktop.DBus.ObjectManager",
+                                        "GetManagedObjects");
+        ++pending_;
+        conn_->async_send(m, [this, owner](const boost::system::error_code& ec,
+                                           sdbusplus::message_t& reply) {
+            if (!ec && !reply.is_method_error())
+            {
+                try
+                {
+                    addManagedObjects(owner, reply.get());
+                }
+                catch (const sdbusplus::exception::SdBusError& e)
+                {
+                    std::cerr << "Bad GetManagedObjects from " << owner
+                              << ": " << e.what() << "\n";
+                }
+            }
+            done();
+        });
+    }
+
+    void addManagedObjects(const std::string& owner, sd_bus_message* m)
+    {
+        check(sd_bus_message_enter_container(m, 'a', "{oa{sa{sv}}}"),
+              "enter a");
+        while (true)
+        {
+            auto r = sd_bus_message_enter_container(m, 'e', "oa{sa{sv}}");
+            check(r, "enter e");
+            if (r == 0)
+            {
+                break;
+            }
+            const char* path = nullptr;
+            check(sd_bus_message_read_basic(m, 'o', &path), "read o");
+            index_.add(owner, path, readInterfaces(m));
+            check(sd_bus_message_exit_container(m), "exit e");
+        }
+        check(sd_bus_message_exit_container(m), "exit a");
+    }
+
+    void done()
+    {
+        if (--pending_ == 0 && !ready_)
+        {
+            ready_ = true;
+            std::cerr << "Indexed " << index_.objects() << " objects in "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(
+                             Clock::now() - started_)
+                             .count()
+                      << " ms\n";
+        }
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        auto m = msg.get();
+        const char* path = nullptr;
+        try
+        {
+            check(sd_bus_message_read_basic(m, 'o', &path), "read o");
+            index_.add(msg.get_sender(), path, readInterfaces(m));
+        }
+        catch (const sdbusplus::exception::SdBusError& e)
+        {
+            std::cerr << "Bad InterfacesAdded: " << e.what() << "\n";
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception::SdBusError& e)
+        {
+            std::cerr << "Bad InterfacesRemoved: " << e.what() << "\n";
+            return;
+        }
+        index_.remove(msg.get_sender(), path.str, interfaces);
+    }
+
+    void onNameOwnerChanged(sdbusplus::message_t& msg)
+    {
+        std::string name;
+        std::string oldOwner;
+        std::string newOwner;
+        try
+        {
+            msg.read(name, oldOwner, newOwner);
+        }
+        catch (const sdbusplus::exception::SdBusError& e)
+        {
+            std::cerr << "Bad NameOwnerChanged: " << e.what() << "\n";
+            return;
+        }
+
+        if (ignored(name))
+        {
+            return;
+        }
+
+        if (name.starts_with(':'))
+        {
+            // A connection went away: everything it had goes with it.
+            if (newOwner.empty())
+            {
+                index_.removeOwner(name);
+                crawled_.erase(name);
+            }
+            return;
+        }
+
+        if (!oldOwner.empty())
+        {
+            index_.removeName(oldOwner, name);
+        }
+        if (!newOwner.empty())
+        {
+            nameAcquired(name, newOwner);
+        }
+    }
+
+    std::shared_ptr<sdbusplus::asio::connection> conn_;
+    sdbusplus::asio::object_server server_;
+    std::shared_ptr<sdbusplus::asio::dbus_interface> iface_;
+
+    sdbusplus::server::method_stats stats_;
+    sdbusplus::server::method_stats_object statsObject_;
+
+    mapper::ObjectIndex index_;
+    /** Connections already read, or being read. */
+    std::unordered_set<std::string> crawled_;
+    size_t pending_ = 0;
+    bool ready_ = false;
+    Clock::time_point started_;
+
+    sdbusplus::bus::match_t interfacesAdded_;
+    sdbusplus::bus::match_t interfacesRemoved_;
+    sdbusplus::bus::match_t nameOwnerChanged_;
+};
+
+int main()
+{
+    boost::asio::io_context io;
+    auto conn = std::make_shared<sdbusplus::asio::connection>(io);
+
+    ObjectMapper mapper(conn);
+
+    io.run();
+    return 0;
+}
@@ -0,0 +1,588 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace mapper
+{
+
+/** Service name -> interfaces, as GetObject returns it (a{sas}). */
+using InterfaceMap = std::map<std::string, std::vector<std::string>>;
+/** Path -> services -> interfaces, as GetSubTree returns it (a{sa{sas}}). */
+using SubTree = std::map<std::string, InterfaceMap>;
+
+/** In-memory index of every object on the bus.
+ *
+ *  Paths are kept in a trie, one node per path element, each node listing
+ *  the connections that implement something there and which interfaces.
+ *  An inverted index maps each interface to the nodes implementing it, so
+ *  a subtree query for a rare interface visits only those nodes instead of
+ *  the whole subtree.
+ *
+ *  Objects are recorded per connection (unique name).  Queries report them
+ *  under the connection's well-known names; a connection without one is
+ *  indexed but not reported, as the OpenBMC mapper does.
+ */
+class ObjectIndex
+{
+  public:
+    ObjectIndex()
+    {
+        root_.path = "/";
+    }
+
+    ObjectIndex(const ObjectIndex&) = delete;
+    ObjectIndex& operator=(const ObjectIndex&) = delete;
+    ObjectIndex(ObjectIndex&&) = delete;
+    ObjectIndex& operator=(ObjectIndex&&) = delete;
+    ~ObjectIndex() = default;
+
+    /** @brief Record that `owner` implements `interfaces` at `path`. */
+    template <typename Interfaces>
+    void add(std::string_view owner, std::string_view path,
+             const Interfaces& interfaces)
+    {
+        if (std::ranges::empty(interfaces))
+        {
+            return;
+        }
+
+        auto& o = owner_(owner);
+        auto* node = insert_(path);
+        bool wasObject = !node->owners.empty();
+        auto& ifaces = entry_(*node, o);
+
+        for (const auto& i : interfaces)
+        {
+            auto id = interfaceId_(i);
+            auto it = std::ranges::lower_bound(ifaces, id);
+            if (it != ifaces.end() && *it == id)
+            {
+                continue;
+            }
+            ifaces.insert(it, id);
+            ++byInterface_[id][node];
+        }
+
+        o.nodes.insert(node);
+        if (!wasObject)
+        {
+            count_(node, +1);
+        }
+    }
+
+    /** @brief Record that `owner` no longer implements `interfaces` at
+     *         `path`.
+     */
+    template <typename Interfaces>
+    void remove(std::string_view owner, std::string_view path,
+                const Interfaces& interfaces)
+    {
+        auto o = owners_.find(owner);
+        auto* node = find_(path);
+        if (o == owners_.end() || node == nullptr)
+        {
+            return;
+        }
+        auto e = std::ranges::find(node->owners, &o->second,
+                                   &Node::Entry::first);
+        if (e == node->owners.end())
+        {
+            return;
+        }
+
+        auto& ifaces = e->second;
+        for (const auto& i : interfaces)
+        {
+            auto id = interfaceIds_.find(std::string_view(i));
+            if (id == interfaceIds_.end())
+            {
+                continue;
+            }
+            auto it = std::ranges::lower_bound(ifaces, id->second);
+            if (it == ifaces.end() || *it != id->second)
+            {
+                continue;
+            }
+            ifaces.erase(it);
+            unindex_(node, id->second);
+        }
+
+        if (ifaces.empty())
+        {
+            o->second.nodes.erase(node);
+            dropEntry_(*node, o->second);
+        }
+    }
+
+    /** @brief Forget everything `owner` implements, ex. when it exits. */
+    void removeOwner(std::string_view owner)
+    {
+        auto o = owners_.find(owner);
+        if (o == owners_.end())
+        {
+            return;
+        }
+
+        for (auto* node : o->second.nodes)
+        {
+            auto e = std::ranges::find(node->owners, &o->second,
+                                       &Node::Entry::first);
+            for (auto id : e->second)
+            {
+                unindex_(node, id);
+            }
+            e->second.clear();
+            dropEntry_(*node, o->second);
+        }
+        owners_.erase(o);
+    }
+
+    /** @brief Report `owner`'s objects under the well-known name `name`. */
+    void addName(std::string_view owner, std::string_view name)
+    {
+        auto& names = owner_(owner).names;
+        if (std::ranges::find(names, name) == names.end())
+        {
+            names.emplace_back(name);
+        }
+    }
+
+    /** @brief Stop reporting `owner`'s objects under `name`. */
+    void removeName(std::string_view owner, std::string_view name)
+    {
+        auto o = owners_.find(owner);
+        if (o == owners_.end())
+        {
+            return;
+        }
+        std::erase(o->second.names, name);
+    }
+
+    /** @return - Whether anything is known about `owner`. */
+    bool hasOwner(std::string_view owner) const
+    {
+        return owners_.contains(owner);
+    }
+
+    /** @brief GetObject: the services implementing `path`.
+     *  @param[in] interfaces - Report only services implementing one of
+     *                          these, if not empty.
+     *  @return - nullopt if nothing (matching) is at `path`.
+     */
+    std::optional<InterfaceMap>
+        getObject(std::string_view path,
+                  const std::vector<std::string>& interfaces) const
+    {
+        const auto* node = find_(path);
+        if (node == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        InterfaceMap result;
+        describe_(*node, filter_(interfaces), result);
+        if (result.empty())
+        {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    /** @brief GetSubTree: every object below `path`, not including it.
+     *  @param[in] depth - Levels below `path` to report; 0 for all.
+     *  @param[in] interfaces - Report only services implementing one of
+     *                          these, if not empty.
+     *  @return - nullopt if `path` is unknown.
+     */
+    std::optional<SubTree>
+        getSubTree(std::string_view path, int32_t depth,
+                   const std::vector<std::string>& interfaces) const
+    {
+        const auto* root = find_(path);
+        if (root == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        SubTree result;
+        auto filter = filter_(interfaces);
+        subtree_(*root, depth, filter, [&](const Node& node) {
+            InterfaceMap services;
+            describe_(node, filter, services);
+            if (!services.empty())
+            {
+                result.emplace(node.path, std::move(services));
+            }
+        });
+        return result;
+    }
+
+    /** @brief GetSubTreePaths: the paths GetSubTree would report. */
+    std::optional<std::vector<std::string>>
+        getSubTreePaths(std::string_view path, int32_t depth,
+                        const std::vector<std::string>& interfaces) const
+    {
+        const auto* root = find_(path);
+        if (root == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        std::vector<std::string> result;
+        auto filter = filter_(interfaces);
+        subtree_(*root, depth, filter, [&](const Node& node) {
+            if (reported_(node, filter))
+            {
+                result.emplace_back(node.path);
+            }
+        });
+        std::ranges::sort(result);
+        return result;
+    }
+
+    /** @return - Paths with at least one interface. */
+    size_t objects() const
+    {
+        return root_.objects;
+    }
+
+    /** @return - Interface names seen so far. */
+    size_t interfaces() const
+    {
+        return interfaceNames_.size();
+    }
+
+  private:
+    struct Owner;
+
+    struct Node
+    {
+        using Entry = std::pair<Owner*, std::vector<uint32_t>>;
+
+        std::string path;
+        Node* parent = nullptr;
+        uint32_t depth = 0;
+        /** Objects in this subtree, this node included. */
+        size_t objects = 0;
+        std::map<std::string, std::unique_ptr<Node>, std::less<>> children;
+        /** Connections implementing this path and their sorted interface
+         *  ids; an entry is only kept while it has interfaces. */
+        std::vector<Entry> owners;
+    };
+
+    struct Owner
+    {
+        std::vector<std::string> names;
+        std::unordered_set<Node*> nodes;
+    };
+
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view s) const noexcept
+        {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    using Filter = std::optional<std::vector<uint32_t>>;
+
+    /* Call f(element) for each element of an object path. */
+    template <typename F>
+    static void split_(std::string_view path, F&& f)
+    {
+        while (!path.empty())
+        {
+            auto start = path.find_first_not_of('/');
+            if (start == std::string_view::npos)
+            {
+                return;
+            }
+            path.remove_prefix(start);
+            auto end = path.find('/');
+            f(path.substr(0, end));
+            path.remove_prefix(end == std::string_view::npos ? path.size()
+                                                             : end);
+        }
+    }
+
+    const Node* find_(std::string_view path) const
+    {
+        const Node* node = &root_;
+        split_(path, [&node](std::string_view element) {
+            if (node == nullptr)
+            {
+                return;
+            }
+            auto it = node->children.find(element);
+            node = it == node->children.end() ? nullptr : it->second.get();
+        });
+        return node;
+    }
+
+    Node* find_(std::string_view path)
+    {
+        return const_cast<Node*>(std::as_const(*this).find_(path));
+    }
+
+    Node* insert_(std::string_view path)
+    {
+        Node* node = &root_;
+        split_(path, [&node](std::string_view element) {
+            auto it = node->children.find(element);
+            if (it == node->children.end())
+            {
+                auto child = std::make_unique<Node>();
+                child->path = node->parent ? node->path : std::string();
+                child->path += '/';
+                child->path += element;
+                child->parent = node;
+                child->depth = node->depth + 1;
+                it = node->children.emplace(std::string(element),
+                                            std::move(child))
+                         .first;
+            }
+            node = it->second.get();
+        });
+        return node;
+    }
+
+    Owner& owner_(std::string_view unique)
+    {
+        auto it = owners_.find(unique);
+        if (it == owners_.end())
+        {
+            it = owners_.emplace(std::string(unique), Owner{}).first;
+        }
+        return it->second;
+    }
+
+    uint32_t interfaceId_(std::string_view name)
+    {
+        auto it = interfaceIds_.find(name);
+        if (it != interfaceIds_.end())
+        {
+            return it->second;
+        }
+        auto id = static_cast<uint32_t>(interfaceNames_.size());
+        interfaceNames_.emplace_back(name);
+        byInterface_.emplace_back();
+        interfaceIds_.emplace(std::string(name), id);
+        return id;
+    }
+
+    std::vector<uint32_t>& entry_(Node& node, Owner& o)
+    {
+        auto e = std::ranges::find(node.owners, &o, &Node::Entry::first);
+        if (e == node.owners.end())
+        {
+            return node.owners.emplace_back(&o, std::vector<uint32_t>{})
+                .second;
+        }
+        return e->second;
+    }
+
+    /* Drop o's entry at node if it has no interfaces left. */
+    void dropEntry_(Node& node, Owner& o)
+    {
+        auto e = std::ranges::find(node.owners, &o, &Node::Entry::first);
+        if (e == node.owners.end() || !e->second.empty())
+        {
+            return;
+        }
+        node.owners.erase(e);
+        if (node.owners.empty())
+        {
+            count_(&node, -1);
+            prune_(&node);
+        }
+    }
+
+    void unindex_(Node* node, uint32_t id)
+    {
+        auto& postings = byInterface_[id];
+        auto it = postings.find(node);
+        if (it != postings.end() && --it->second == 0)
+        {
+            postings.erase(it);
+        }
+    }
+
+    static void count_(Node* node, int delta)
+    {
+        for (; node != nullptr; node = node->parent)
+        {
+            node->objects += delta;
+        }
+    }
+
+    /* Remove node and its ancestors while they hold nothing. */
+    void prune_(Node* node)
+    {
+        while (node != &root_ && node->owners.empty() &&
+               node->children.empty())
+        {
+            auto* parent = node->parent;
+            auto name = std::string_view(node->path).substr(
+                node->path.rfind('/') + 1);
+            parent->children.erase(parent->children.find(name));
+            node = parent;
+        }
+    }
+
+    /* Interface ids to match; nullopt matches everything. */
+    Filter filter_(const std::vector<std::string>& interfaces) const
+    {
+        if (interfaces.empty())
+        {
+            return std::nullopt;
+        }
+        std::vector<uint32_t> ids;
+        for (const auto& i : interfaces)
+        {
+            auto it = interfaceIds_.find(std::string_view(i));
+            if (it != interfaceIds_.end())
+            {
+                ids.push_back(it->second);
+            }
+        }
+        std::ranges::sort(ids);
+        return ids;
+    }
+
+    static bool matches_(const std::vector<uint32_t>& ifaces,
+                         const Filter& filter)
+    {
+        if (!filter)
+        {
+            return true;
+        }
+        return std::ranges::any_of(*filter, [&ifaces](uint32_t id) {
+            return std::ranges::binary_search(ifaces, id);
+        });
+    }
+
+    bool reported_(const Node& node, const Filter& filter) const
+    {
+        return std::ranges::any_of(node.owners, [&](const auto& e) {
+            return !e.first->names.empty() && matches_(e.second, filter);
+        });
+    }
+
+    void describe_(const Node& node, const Filter& filter,
+                   InterfaceMap& result) const
+    {
+        for (const auto& [o, ifaces] : node.owners)
+        {
+            if (o->names.empty() || !matches_(ifaces, filter))
+            {
+                continue;
+            }
+
+            std::vector<std::string> names;
+            names.reserve(ifaces.size());
+            for (auto id : ifaces)
+            {
+                names.push_back(interfaceNames_[id]);
+            }
+            std::ranges::sort(names);
+
+            for (const auto& n : o->names)
+            {
+                result.insert_or_assign(n, names);
+            }
+        }
+    }
+
+    /* Call f(node) for every object below root within depth, using the
+     * inverted index when the filter names fewer nodes than the subtree
+     * holds. */
+    template <typename F>
+    void subtree_(const Node& root, int32_t depth, const Filter& filter,
+                  F&& f) const
+    {
+        auto maxDepth = depth > 0 ? root.depth + static_cast<uint32_t>(depth)
+                                  : UINT32_MAX;
+
+        if (filter)
+        {
+            size_t candidates = 0;
+            for (auto id : *filter)
+            {
+                candidates += byInterface_[id].size();
+            }
+
+            if (candidates < root.objects)
+            {
+                std::unordered_set<const Node*> seen;
+                for (auto id : *filter)
+                {
+                    for (const auto& [node, refs] : byInterface_[id])
+                    {
+                        if (node->depth > root.depth &&
+                            node->depth <= maxDepth &&
+                            ancestor_(*node, root.depth) == &root &&
+                            seen.insert(node).second)
+                        {
+                            f(*node);
+                        }
+                    }
+                }
+                return;
+            }
+        }
+
+        walk_(root, maxDepth, f);
+    }
+
+    template <typename F>
+    static void walk_(const Node& node, uint32_t maxDepth, F& f)
+    {
+        if (node.depth >= maxDepth)
+        {
+            return;
+        }
+        for (const auto& [name, child] : node.children)
+        {
+            if (!child->owners.empty())
+            {
+                f(*child);
+            }
+            walk_(*child, maxDepth, f);
+        }
+    }
+
+    static const Node* ancestor_(const Node& node, uint32_t depth)
+    {
+        const Node* n = &node;
+        while (n->depth > depth)
+        {
+            n = n->parent;
+        }
+        return n;
+    }
+
+    Node root_;
+    std::unordered_map<std::string, Owner, StringHash, std::equal_to<>>
+        owners_;
+    std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>>
+        interfaceIds_;
+    std::vector<std::string> interfaceNames_;
+    /** Interface id -> nodes implementing it -> owners doing so there. */
+    std::vector<std::unordered_map<const Node*, uint32_t>> byInterface_;
+};
+
+} // namespace mapper
@@ -3,6 +3,7 @@
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/asio/object_server.hpp>
 #include <sdbusplus/asio/property.hpp>
+#include <sdbusplus/asio/property_batch.hpp>
 #include <sdbusplus/bus.hpp>
 
 #include <iostream>
@@ -18,7 +19,7 @@ class Application
   public:
     Application(boost::asio::io_context& ioc, sdbusplus::asio::connection& bus,
                 sdbusplus::asio::object_server& objServer) :
-        ioc_(ioc), bus_(bus), objServer_(objServer)
+        ioc_(ioc), bus_(bus), objServer_(objServer), batch_(ioc, bus)
     {
         demo_ = objServer_.add_unique_interface(
             demoObjectPath, demoInterfaceName,
@@ -141,11 +142,26 @@ class Application
         demo_->signal_property(propertyGoodbyesName);
     }
 
+    // Repeated changes made within one io_context tick are coalesced into a
+    // single PropertiesChanged carrying the latest value.
+    void batchedChangeGoodbyes(std::string_view value)
+    {
+        goodbyes_ = value;
+        batch_.signal_property(*demo_, propertyGoodbyesName);
+    }
+
+    const auto& batchStats() const
+    {
+        return batch_.stats();
+    }
+
   private:
     boost::asio::io_context& ioc_;
     sdbusplus::asio::connection& bus_;
     sdbusplus::asio::object_server& objServer_;
 
+    sdbusplus::asio::property_batch batch_;
+
     std::unique_ptr<sdbusplus::asio::dbus_interface> demo_;
     std::string greetings_ = "Hello";
     std::string goodbyes_ = "Bye";
@@ -171,6 +187,11 @@ int main(int, char**)
 
     app.syncChangeGoodbyes("Good bye");
 
+    for (auto value : {"Farewell", "So long", "See you"})
+    {
+        app.batchedChangeGoodbyes(value);
+    }
+
     boost::asio::post(ioc,
                       [&app] { app.asyncReadPropertyWithIncorrectType(); });
     boost::asio::post(ioc, [&app] { app.asyncReadProperties(); });
@@ -178,6 +199,10 @@ int main(int, char**)
 
     ioc.run();
 
+    const auto& stats = app.batchStats();
+    std::cout << "Batched property changes: " << stats.changes
+              << ", signals sent: " << stats.signals
+              << ", signals saved: " << stats.saved() << "\n";
     std::cout << "Fatal errors count: " << app.fatalErrors() << "\n";
 
     return app.fatalErrors();
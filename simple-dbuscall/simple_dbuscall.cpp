@@ -1,15 +1,18 @@
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/connection_pool.hpp>
 #include <iostream>
 
 int main() {
-    auto bus = sdbusplus::bus::new_default();
+    // Borrow a connection; it goes back to the pool for reuse when `bus` is
+    // destroyed, instead of being closed.
+    auto bus = sdbusplus::bus::connection_pool::default_pool().acquire();
     std::string busName = "org.freedesktop.DBus";
     std::string objectPath = "/org/freedesktop/DBus";
     std::string interfaceName = "org.freedesktop.DBus";
     std::string propertyName = "Interfaces";
 
     // Create a method call to the Get method of the org.freedesktop.DBus.Properties interface
-    auto method = bus.new_method_call(
+    auto method = bus->new_method_call(
         busName.c_str(), 
         objectPath.c_str(), 
         "org.freedesktop.DBus.Properties", 
@@ -21,7 +24,7 @@ int main() {
 
     try {
         // Call the method with timeout and read the response
-        auto reply = bus.call(method);
+        auto reply = bus->call(method);
         std::variant<std::vector<std::string>> propertyValue;
         reply.read(propertyValue);
 
@@ -1,16 +1,17 @@
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/connection_pool.hpp>
 #include <iostream>
 #include <chrono>
 
 int main() {
-    auto bus = sdbusplus::bus::new_default();
+    auto bus = sdbusplus::bus::connection_pool::default_pool().acquire();
     std::string busName = "org.freedesktop.DBus";
     std::string objectPath = "/org/freedesktop/DBus";
     std::string interfaceName = "org.freedesktop.DBus";
     std::string propertyName = "Interfaces";
 
     // Create a method call to the Get method of the org.freedesktop.DBus.Properties interface
-    auto method = bus.new_method_call(
+    auto method = bus->new_method_call(
         busName.c_str(), 
         objectPath.c_str(), 
         "org.freedesktop.DBus.Properties", 
@@ -25,7 +26,7 @@ int main() {
         auto timeout_duration = std::chrono::milliseconds(5000);
 
         // Call the method with timeout and read the response
-        auto reply = bus.call(method, timeout_duration);
+        auto reply = bus->call(method, timeout_duration);
         std::variant<std::vector<std::string>> propertyValue;
         reply.read(propertyValue);
 
@@ -0,0 +1,226 @@
+"""Batch mode: many outputs from one sdbus++ process.
+
+A batch file has one line per output piece:
+
+    TYPE PROCESS ITEM OUTPUT
+
+Lines naming the same OUTPUT are rendered in order and concatenated, as
+repeated `sdbus++ ... >> OUTPUT` would.  Blank lines and lines starting
+with '#' are ignored.
+
+The templates are looked up once per worker process and, with a cache
+directory, their compiled modules are kept on disk between runs.  An
+output is skipped when the digest of everything it was generated from
+(its YAML, the generator and its templates, the options) matches the one
+recorded when it was last written, and it is only rewritten when its
+content changes.  Either way its mtime is brought up to date, as build
+tools like ninja expect of a command's outputs.
+"""
+
+import concurrent.futures
+import hashlib
+import multiprocessing
+import os
+import sys
+
+
+class Job(object):
+    def __init__(self, output):
+        self.output = output
+        self.parts = []
+
+
+def parse(lines, valid_types, valid_processes):
+    jobs = {}
+    for n, line in enumerate(lines, 1):
+        line = line.strip()
+        if not line or line.startswith("#"):
+            continue
+
+        fields = line.split()
+        if len(fields) != 4:
+            raise ValueError(
+                "line %d: expected 'TYPE PROCESS ITEM OUTPUT': %s" % (n, line)
+            )
+        typeName, process, item, output = fields
+        if typeName not in valid_types:
+            raise ValueError("line %d: invalid type '%s'" % (n, typeName))
+        if process not in valid_processes:
+            raise ValueError("line %d: invalid process '%s'" % (n, process))
+
+        output = os.path.abspath(output)
+        jobs.setdefault(output, Job(output)).parts.append(
+            (typeName, process, item)
+        )
+    return list(jobs.values())
+
+
+def fingerprint(*dirs):
+    """Digest every generator source and template under 'dirs'."""
+    h = hashlib.sha256()
+    for d in sorted(set(os.path.realpath(d) for d in dirs)):
+        for root, subdirs, files in os.walk(d):
+            subdirs[:] = sorted(s for s in subdirs if s != "__pycache__")
+            for f in sorted(files):
+                if not f.endswith((".py", ".mako", ".yaml")):
+                    continue
+                path = os.path.join(root, f)
+                h.update(path.encode())
+                with open(path, "rb") as fd:
+                    h.update(fd.read())
+    return h.hexdigest()
+
+
+class Batch(object):
+    def __init__(self, args, valid_types, valid_processes, make_lookup):
+        self.args = args
+        self.valid_types = valid_types
+        self.valid_processes = valid_processes
+        self.make_lookup = make_lookup
+        self.lookup = None
+
+        module_path = os.path.dirname(os.path.abspath(__file__))
+        self.generator = fingerprint(
+            module_path, args.templatedir, args.schemadir
+        )
+
+        # One small file per output, so concurrent runs sharing a cache
+        # never overwrite each other's records.
+        self.stampdir = None
+        if args.cache_dir:
+            self.stampdir = os.path.join(args.cache_dir, "stamps")
+            os.makedirs(self.stampdir, exist_ok=True)
+
+    def stampfile(self, output):
+        name = hashlib.sha256(output.encode()).hexdigest()
+        return os.path.join(self.stampdir, name)
+
+    def stamp(self, output):
+        if not self.stampdir:
+            return None
+        try:
+            with open(self.stampfile(output)) as f:
+                return f.read()
+        except OSError:
+            return None
+
+    def record(self, output, digest):
+        if not self.stampdir:
+            return
+        tmp = "%s.%d.tmp" % (self.stampfile(output), os.getpid())
+        with open(tmp, "w") as f:
+            f.write(digest)
+        os.replace(tmp, self.stampfile(output))
+
+    def digest(self, job):
+        h = hashlib.sha256()
+        h.update(self.generator.encode())
+        h.update(b"static" if self.args.static_marshal else b"default")
+        for typeName, process, item in job.parts:
+            h.update(("\0%s\0%s\0%s\0" % (typeName, process, item)).encode())
+            cls = self.valid_types[typeName]
+            filename = os.path.join(
+                self.args.rootdir, item.replace(".", "/") + cls.yaml_suffix
+            )
+            with open(filename, "rb") as f:
+                h.update(f.read())
+        return h.hexdigest()
+
+    def render(self, job):
+        if self.lookup is None:
+            self.lookup = self.make_lookup()
+
+        result = ""
+        for typeName, process, item in job.parts:
+            instance = self.valid_types[typeName].load(
+                item, self.args.rootdir, self.args.schemadir
+            )
+            if self.args.static_marshal:
+                instance.static_marshal = True
+            function = getattr(instance, self.valid_processes[process])
+            result += function(self.lookup) + "\n"
+        return result
+
+    def generate(self, job):
+        """Write 'job' unless its content is unchanged; None on success."""
+        try:
+            content = self.render(job)
+
+            try:
+                with open(job.output) as f:
+                    if f.read() == content:
+                        os.utime(job.output)
+                        return None
+            except OSError:
+                pass
+
+            os.makedirs(os.path.dirname(job.output), exist_ok=True)
+            tmp = "%s.%d.tmp" % (job.output, os.getpid())
+            with open(tmp, "w") as f:
+                f.write(content)
+            os.replace(tmp, job.output)
+            return None
+        except Exception as e:
+            return "%s: %s: %s" % (job.output, type(e).__name__, e)
+
+    def run(self, jobs):
+        pending = []
+        skipped = 0
+        for job in jobs:
+            try:
+                digest = self.digest(job)
+            except OSError:
+                # Missing YAML; let generate() report it.
+                digest = None
+            if (
+                digest
+                and self.stamp(job.output) == digest
+                and os.path.exists(job.output)
+            ):
+                os.utime(job.output)
+                skipped += 1
+                continue
+            pending.append((job, digest))
+
+        if self.args.jobs > 1 and len(pending) > 1:
+            # Forked workers inherit this object; each builds its template
+            # lookup on its first job.
+            global _batch
+            _batch = self
+            ctx = multiprocessing.get_context("fork")
+            with concurrent.futures.ProcessPoolExecutor(
+                max_workers=self.args.jobs, mp_context=ctx
+            ) as pool:
+                results = list(
+                    pool.map(
+                        _generate,
+                        [job for job, _ in pending],
+                        chunksize=max(1, len(pending) // (self.args.jobs * 4)),
+                    )
+                )
+        else:
+            results = [self.generate(job) for job, _ in pending]
+
+        errors = []
+        for (job, digest), error in zip(pending, results):
+            if error:
+                errors.append(error)
+            elif digest:
+                self.record(job.output, digest)
+
+        for e in errors:
+            print(e, file=sys.stderr)
+        if self.args.verbose:
+            print(
+                "sdbus++: %d generated, %d unchanged, %d failed"
+                % (len(pending) - len(errors), skipped, len(errors)),
+                file=sys.stderr,
+            )
+        return 1 if errors else 0
+
+
+_batch = None
+
+
+def _generate(job):
+    return _batch.generate(job)
@@ -0,0 +1,91 @@
+"""Caches for the parts of sdbus++ that do not depend on what is rendered.
+
+Parsed YAML is kept in memory, keyed by the file's path, mtime and size, so
+an interface rendered into several outputs is parsed once per process.  With
+a cache directory (`sdbus++ --cache-dir`), parsed YAML and compiled Mako
+templates are also kept on disk, keyed by a digest of their content, so a
+later process, or a file touched without being changed, reuses them:
+
+    <dir>/yaml/<sha256>.pickle    the parsed document
+    <dir>/mako/<sha256>.py        the compiled template module
+
+Entries are written atomically and never modified, so concurrent processes
+may share a directory.  Nothing is evicted; the directory can be removed at
+any time.
+"""
+
+import hashlib
+import os
+import pickle
+
+import mako
+import yaml
+
+_directory = None
+_parsed = {}
+
+
+def configure(directory):
+    """Keep parsed YAML and compiled templates under 'directory'."""
+    global _directory
+    _directory = directory
+
+
+def _write(path, data):
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    tmp = "%s.%d.tmp" % (path, os.getpid())
+    with open(tmp, "wb") as f:
+        f.write(data)
+    os.replace(tmp, path)
+
+
+def load_yaml(filename):
+    """Parse 'filename', or return a fresh copy of its cached parse."""
+    st = os.stat(filename)
+    key = (os.path.abspath(filename), st.st_mtime_ns, st.st_size)
+    blob = _parsed.get(key)
+    if blob is None:
+        with open(filename, "rb") as f:
+            data = f.read()
+
+        path = None
+        if _directory:
+            path = os.path.join(
+                _directory, "yaml", hashlib.sha256(data).hexdigest()
+            )
+            path += ".pickle"
+            try:
+                with open(path, "rb") as f:
+                    blob = f.read()
+            except OSError:
+                pass
+
+        if blob is None:
+            blob = pickle.dumps(
+                yaml.safe_load(data), protocol=pickle.HIGHEST_PROTOCOL
+            )
+            if path:
+                _write(path, blob)
+
+        _parsed[key] = blob
+
+    # The loaders pop and rewrite what they are given; never share it.
+    return pickle.loads(blob)
+
+
+def template_module(filename, uri):
+    """Where Mako keeps the compiled module for template 'filename'.
+
+    Used as a TemplateLookup's modulename_callable.  The name is a digest of
+    the template and the Mako version, so an edited template never finds a
+    stale module and a reverted one finds its old module again.
+    """
+    if not _directory:
+        return None
+
+    h = hashlib.sha256()
+    h.update(mako.__version__.encode())
+    h.update(uri.encode())
+    with open(filename, "rb") as f:
+        h.update(f.read())
+    return os.path.join(_directory, "mako", h.hexdigest() + ".py")
@@ -1,4 +1,5 @@
 from .namedelement import NamedElement
+from .perfecthash import PerfectHash
 from .property import Property
 
 """ Class for parsing 'enum' definition elements from an interface.
@@ -10,3 +11,14 @@ class Enum(NamedElement):
         self.values = [Property(**v) for v in kwargs.pop("values", [])]
 
         super(Enum, self).__init__(**kwargs)
+
+    def build_hash(self):
+        """Build the perfect hash over this enum's value names.  The
+        "<interface>.<enum>." prefix is shared by every value, so it is
+        checked once rather than hashed.
+        """
+        self.value_hash = PerfectHash([v.name for v in self.values])
+
+    def values_by_slot(self):
+        by_name = {v.name: v for v in self.values}
+        return [by_name[n] for n in self.value_hash.slots]
@@ -1,7 +1,6 @@
 import os
 
-import yaml
-
+from . import cache
 from .namedelement import NamedElement
 from .renderer import Renderer
 
@@ -13,17 +12,17 @@ class ErrorElement(NamedElement):
 
 
 class Error(NamedElement, Renderer):
+    yaml_suffix = ".errors.yaml"
+
     @staticmethod
     def load(name, rootdir, schemadir):
         filename = os.path.join(
-            rootdir, name.replace(".", "/") + ".errors.yaml"
+            rootdir, name.replace(".", "/") + Error.yaml_suffix
         )
 
-        with open(filename) as f:
-            data = f.read()
-            y = yaml.safe_load(data)
-            y = {"name": name, "errors": y}
-            return Error(**y)
+        y = cache.load_yaml(filename)
+        y = {"name": name, "errors": y}
+        return Error(**y)
 
     def __init__(self, **kwargs):
         self.errors = [ErrorElement(**n) for n in kwargs.pop("errors", [])]
@@ -4,8 +4,8 @@ import json
 import os
 
 import jsonschema
-import yaml
 
+from . import cache
 from .namedelement import NamedElement
 from .property import Property
 from .renderer import Renderer
@@ -155,30 +155,39 @@ class EventElement(NamedElement):
 
 
 class Event(NamedElement, Renderer):
+    yaml_suffix = ".events.yaml"
+
+    # Checking the schema costs more than validating against it; do it once
+    # per schema file and process.
+    _validators = {}
+
     @staticmethod
-    def load(name, rootdir, schemadir):
+    def validator(schemadir):
         schemafile = os.path.join(schemadir, "events.schema.yaml")
-        with open(schemafile) as f:
-            data = f.read()
-            schema = yaml.safe_load(data)
+        validator = Event._validators.get(schemafile)
+        if validator is None:
+            schema = cache.load_yaml(schemafile)
 
             spec = jsonschema.Draft202012Validator
             spec.check_schema(schema)
 
-            validator = spec(schema)
+            validator = Event._validators[schemafile] = spec(schema)
+        return validator
+
+    @staticmethod
+    def load(name, rootdir, schemadir):
+        validator = Event.validator(schemadir)
 
         filename = os.path.join(
-            rootdir, name.replace(".", "/") + ".events.yaml"
+            rootdir, name.replace(".", "/") + Event.yaml_suffix
         )
 
-        with open(filename) as f:
-            data = f.read()
-            y = yaml.safe_load(data)
+        y = cache.load_yaml(filename)
 
-            validator.validate(y)
+        validator.validate(y)
 
-            y["name"] = name
-            return Event(**y)
+        y["name"] = name
+        return Event(**y)
 
     def __init__(self, **kwargs):
         self.version = kwargs.pop("version")
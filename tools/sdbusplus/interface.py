@@ -1,11 +1,11 @@
 import os
 
-import yaml
-
+from . import cache
 from .enum import Enum
 from .method import Method
 from .namedelement import NamedElement
 from .path import Path
+from .perfecthash import PerfectHash
 from .property import Property
 from .renderer import Renderer
 from .servicename import ServiceName
@@ -13,17 +13,17 @@ from .signal import Signal
 
 
 class Interface(NamedElement, Renderer):
+    yaml_suffix = ".interface.yaml"
+
     @staticmethod
     def load(name, rootdir, schemadir):
         filename = os.path.join(
-            rootdir, name.replace(".", "/") + ".interface.yaml"
+            rootdir, name.replace(".", "/") + Interface.yaml_suffix
         )
 
-        with open(filename) as f:
-            data = f.read()
-            y = yaml.safe_load(data)
-            y["name"] = name
-            return Interface(**y)
+        y = cache.load_yaml(filename)
+        y["name"] = name
+        return Interface(**y)
 
     def __init__(self, **kwargs):
         self.properties = [Property(**p) for p in kwargs.pop("properties", [])]
@@ -34,9 +34,20 @@ class Interface(NamedElement, Renderer):
         self.service_names = [
             ServiceName(**s) for s in kwargs.pop("service_names", [])
         ]
+        self.property_hash = PerfectHash([p.name for p in self.properties])
+
+        # Set by 'sdbus++ --static-marshal'; changes the server-cpp output.
+        self.static_marshal = False
+
+        for e in self.enums:
+            e.build_hash()
 
         super(Interface, self).__init__(**kwargs)
 
+    def properties_by_slot(self):
+        by_name = {p.name: p for p in self.properties}
+        return [by_name[n] for n in self.property_hash.slots]
+
     def joinedName(self, join_str, append):
         return join_str.join(self.namespaces + [self.classname, append])
 
@@ -1,9 +1,11 @@
 import argparse
 import os
+import sys
 
 import mako.lookup
 
 import sdbusplus
+from sdbusplus import batch, cache
 
 
 def main():
@@ -52,10 +54,51 @@ def main():
         type=str,
         help="Location of schema files.",
     )
+    parser.add_argument(
+        "--static-marshal",
+        dest="static_marshal",
+        action="store_true",
+        help="Emit D-Bus signatures as string literals and marshal "
+        "server-cpp method and property callbacks inline.",
+    )
+    parser.add_argument(
+        "-b",
+        "--batch",
+        dest="batch",
+        type=str,
+        help="Generate the outputs listed in this file ('-' for stdin), "
+        "one 'TYPE PROCESS ITEM OUTPUT' per line, instead of one ITEM.",
+    )
+    parser.add_argument(
+        "-j",
+        "--jobs",
+        dest="jobs",
+        default=os.cpu_count() or 1,
+        type=int,
+        help="Worker processes for --batch.",
+    )
+    parser.add_argument(
+        "-c",
+        "--cache-dir",
+        dest="cache_dir",
+        default=os.environ.get("SDBUSPP_CACHE_DIR"),
+        type=str,
+        help="Keep compiled templates, parsed YAML and, for --batch, the "
+        "digests of generated outputs here.  Defaults to "
+        "$SDBUSPP_CACHE_DIR.",
+    )
+    parser.add_argument(
+        "-v",
+        "--verbose",
+        dest="verbose",
+        action="store_true",
+        help="Summarize what --batch generated on stderr.",
+    )
     parser.add_argument(
         "typeName",
         metavar="TYPE",
         type=str,
+        nargs="?",
         choices=valid_types.keys(),
         help="Type to operate on.",
     )
@@ -63,6 +106,7 @@ def main():
         "process",
         metavar="PROCESS",
         type=str,
+        nargs="?",
         choices=valid_processes.keys(),
         help="Process to apply.",
     )
@@ -70,15 +114,46 @@ def main():
         "item",
         metavar="ITEM",
         type=str,
+        nargs="?",
         help="Item to process.",
     )
 
     args = parser.parse_args()
 
-    lookup = mako.lookup.TemplateLookup(directories=[args.templatedir])
+    cache.configure(args.cache_dir)
+
+    def make_lookup():
+        # Templates do not change during a run; skip the stat on every
+        # nested render.
+        return mako.lookup.TemplateLookup(
+            directories=[args.templatedir],
+            modulename_callable=cache.template_module,
+            filesystem_checks=False,
+        )
+
+    if args.batch:
+        if args.typeName:
+            parser.error("TYPE PROCESS ITEM are read from --batch")
+        f = sys.stdin if args.batch == "-" else open(args.batch)
+        try:
+            jobs = batch.parse(f, valid_types, valid_processes)
+        except ValueError as e:
+            parser.error("%s: %s" % (args.batch, e))
+        sys.exit(
+            batch.Batch(args, valid_types, valid_processes, make_lookup).run(
+                jobs
+            )
+        )
+
+    if not args.item:
+        parser.error("TYPE, PROCESS and ITEM are required without --batch")
+
+    lookup = make_lookup()
 
     instance = valid_types[args.typeName].load(
         args.item, args.rootdir, args.schemadir
     )
+    if args.static_marshal:
+        instance.static_marshal = True
     function = getattr(instance, valid_processes[args.process])
     print(function(lookup))
@@ -44,6 +44,12 @@ class Method(NamedElement, Renderer):
         else:
             return "std::tuple<" + self.returns_as_list(interface) + ">"
 
+    def parameters_signature(self):
+        return Property.join_signatures(self.parameters)
+
+    def returns_signature(self):
+        return Property.join_signatures(self.returns)
+
     def parameter(self, interface, p, defaultValue=False, ref=""):
         r = "%s%s %s" % (p.cppTypeParam(interface.name), ref, p.camelCase)
         if defaultValue:
@@ -0,0 +1,81 @@
+""" Minimal perfect hashing of D-Bus names (hash-and-displace).
+
+    The hash and lookup must stay in sync with
+    include/sdbusplus/utility/perfect_hash.hpp.
+"""
+
+
+def mix(h):
+    h ^= h >> 16
+    h = (h * 0x7FEB352D) & 0xFFFFFFFF
+    h ^= h >> 15
+    h = (h * 0x846CA68B) & 0xFFFFFFFF
+    h ^= h >> 16
+    return h
+
+
+def fnv1a(name):
+    h = 2166136261
+    for c in name.encode():
+        h ^= c
+        h = (h * 16777619) & 0xFFFFFFFF
+    return mix(h)
+
+
+class PerfectHash(object):
+    MAX_SEED = 1 << 24
+
+    def __init__(self, names):
+        self.names = list(names)
+        size = max(1, len(self.names))
+
+        if len(set(self.names)) != len(self.names):
+            raise ValueError("Duplicate names in %s" % self.names)
+
+        hashes = {n: fnv1a(n) for n in self.names}
+
+        # Group the names by their first-level bucket, then place the
+        # largest buckets first while the table is still mostly empty.
+        buckets = [[] for _ in range(size)]
+        for n in self.names:
+            buckets[hashes[n] % size].append(n)
+
+        self.displacements = [0] * size
+        slots = [None] * size
+
+        order = sorted(range(size), key=lambda b: -len(buckets[b]))
+        for b in order:
+            bucket = buckets[b]
+            if len(bucket) <= 1:
+                continue
+
+            for seed in range(1, self.MAX_SEED):
+                placed = [mix(hashes[n] ^ seed) % size for n in bucket]
+                if len(set(placed)) == len(placed) and all(
+                    slots[p] is None for p in placed
+                ):
+                    break
+            else:
+                raise RuntimeError("No perfect hash found for %s" % bucket)
+
+            self.displacements[b] = seed
+            for n, p in zip(bucket, placed):
+                slots[p] = n
+
+        # Single-entry buckets go directly into the remaining free slots;
+        # a negative displacement encodes the slot index.
+        free = [i for i in range(size) if slots[i] is None]
+        for b in order:
+            if len(buckets[b]) == 1:
+                p = free.pop(0)
+                self.displacements[b] = -p - 1
+                slots[p] = buckets[b][0]
+
+        self.slots = slots
+
+    def slot(self, name):
+        h = fnv1a(name)
+        d = self.displacements[h % len(self.displacements)]
+        if d < 0:
+            return -d - 1
+        return mix(h ^ d) % len(self.displacements)
@@ -1,3 +1,5 @@
+import functools
+
 import yaml
 
 from .namedelement import NamedElement
@@ -170,8 +172,7 @@ class Property(NamedElement, Renderer):
             and then wrap it in a [ ] and it becomes valid YAML.  (assuming
             the user gave us a valid typename)
         """
-        typeName = self.typeName
-        typeArray = yaml.safe_load("[" + ",[".join(typeName.split("[")) + "]")
+        typeArray = _type_array(self.typeName)
         return self.__preprocess_yaml_type_array(typeArray).pop(0)
 
     """ Take a list of dbus types from YAML and convert it to a recursive data
@@ -207,22 +208,26 @@ class Property(NamedElement, Renderer):
         return result
 
     propertyMap = {
-        "byte": {"cppName": "uint8_t", "params": 0},
-        "boolean": {"cppName": "bool", "params": 0},
-        "int16": {"cppName": "int16_t", "params": 0},
-        "uint16": {"cppName": "uint16_t", "params": 0},
-        "int32": {"cppName": "int32_t", "params": 0},
-        "uint32": {"cppName": "uint32_t", "params": 0},
+        "byte": {"cppName": "uint8_t", "dbusType": "y", "params": 0},
+        "boolean": {"cppName": "bool", "dbusType": "b", "params": 0},
+        "int16": {"cppName": "int16_t", "dbusType": "n", "params": 0},
+        "uint16": {"cppName": "uint16_t", "dbusType": "q", "params": 0},
+        "int32": {"cppName": "int32_t", "dbusType": "i", "params": 0},
+        "uint32": {"cppName": "uint32_t", "dbusType": "u", "params": 0},
         "int64": {
             "cppName": "int64_t",
+            "dbusType": "x",
             "params": 0,
             "registryName": "number",
         },
         "uint64": {
             "cppName": "uint64_t",
+            "dbusType": "t",
             "params": 0,
             "registryName": "number",
         },
+        # size_t and ssize_t are 't'/'x' or 'u'/'i' depending on the target,
+        # so they have no fixed "dbusType"; see signature().
         "size": {
             "cppName": "size_t",
             "params": 0,
@@ -231,36 +236,88 @@ class Property(NamedElement, Renderer):
         "ssize": {"cppName": "ssize_t", "params": 0},
         "double": {
             "cppName": "double",
+            "dbusType": "d",
             "params": 0,
             "registryName": "number",
         },
-        "unixfd": {"cppName": "sdbusplus::message::unix_fd", "params": 0},
+        "unixfd": {
+            "cppName": "sdbusplus::message::unix_fd",
+            "dbusType": "h",
+            "params": 0,
+        },
         "string": {
             "cppName": "std::string",
+            "dbusType": "s",
             "params": 0,
             "registryName": "string",
         },
         "object_path": {
             "cppName": "sdbusplus::message::object_path",
+            "dbusType": "o",
             "params": 0,
             "registryName": "string",
         },
         "signature": {
             "cppName": "sdbusplus::message::signature",
+            "dbusType": "g",
             "params": 0,
         },
-        "array": {"cppName": "std::vector", "params": 1},
-        "set": {"cppName": "std::set", "params": 1},
-        "struct": {"cppName": "std::tuple", "params": -1},
-        "variant": {"cppName": "std::variant", "params": -1},
-        "dict": {"cppName": "std::map", "params": 2},
+        "array": {"cppName": "std::vector", "dbusType": "a", "params": 1},
+        "set": {"cppName": "std::set", "dbusType": "a", "params": 1},
+        "struct": {"cppName": "std::tuple", "dbusType": "(", "params": -1},
+        "variant": {
+            "cppName": "std::variant",
+            "dbusType": "v",
+            "params": -1,
+        },
+        "dict": {"cppName": "std::map", "dbusType": "a{", "params": 2},
         "enum": {
             "cppName": "enum",
+            "dbusType": "s",
             "params": 1,
             "registryName": "string",
         },
     }
 
+    """ Get the D-Bus signature of the property type, ex. 'a{sx}'.
+        None if it depends on the target, as with size and ssize. """
+
+    def signature(self):
+        if not self.typeName:
+            return ""
+        return self.__signature(self.__type_tuple())
+
+    def __signature(self, typeTuple):
+        first, rest = typeTuple
+        result = Property.propertyMap[first].get("dbusType")
+        if result is None:
+            return None
+
+        # Enums are sent as strings and a variant's alternatives travel with
+        # its value; neither spells out its parameters.
+        if first in ["enum", "variant"]:
+            return result
+
+        params = [self.__signature(e) for e in rest]
+        if None in params:
+            return None
+        result += "".join(params)
+        if first == "struct":
+            result += ")"
+        elif first == "dict":
+            result += "}"
+        return result
+
+    """ Get the signatures of 'properties' concatenated, or None if any of
+        them depends on the target. """
+
+    @staticmethod
+    def join_signatures(properties):
+        signatures = [p.signature() for p in properties]
+        if None in signatures:
+            return None
+        return "".join(signatures)
+
     """ Get the registry type of the property. """
 
     def registry_type(self):
@@ -358,3 +415,10 @@ class Property(NamedElement, Renderer):
                 raise ValueError('Invalid flag "{}"'.format(flag))
 
         return " | ".join(cpp_flags)
+
+
+# Every property's type is parsed several times per render, and most
+# interfaces share a handful of types.  The result is only read.
+@functools.lru_cache(maxsize=None)
+def _type_array(typeName):
+    return yaml.safe_load("[" + ",[".join(typeName.split("[")) + "]")
@@ -22,5 +22,8 @@ class Signal(NamedElement, Renderer):
             post=str.rstrip,
         )
 
+    def signature(self):
+        return Property.join_signatures(self.properties)
+
     def cpp_includes(self, interface):
         return interface.enum_includes(self.properties)
@@ -1,8 +1,15 @@
 #pragma once
 #include <sdbusplus/async/server.hpp>
+#include <sdbusplus/message/append_as.hpp>
 #include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/server/admission.hpp>
+#include <sdbusplus/server/method_stats.hpp>
+#include <sdbusplus/server/property_batch.hpp>
+#include <sdbusplus/server/signal_burst.hpp>
 #include <sdbusplus/server/transaction.hpp>
 
+#include <array>
+#include <string>
 #include <type_traits>
 
 % for h in interface.cpp_includes():
@@ -49,7 +56,8 @@ class ${interface.classname} :
   public:
     explicit ${interface.classname}(const char* path) :
         _${interface.joinedName("_", "interface")}(
-            _context(), path, interface, _vtable, this)
+            _context(), path, interface, _vtable, this),
+        _path(path)
     {}
 
     ${interface.classname}(
@@ -78,6 +86,54 @@ ${s.render(loader, "signal.aserver.emit.hpp.mako", signal=s, interface=interface
         _${interface.joinedName("_", "interface")}.emit_removed();
     }
 
+    /** @brief Coalesce this interface's PropertiesChanged signals.
+     *
+     *  While set, property changes are queued in the batch and sent as one
+     *  signal per interface when it is flushed.  The batch must outlive this
+     *  object or be reset first.
+     *
+     *  @param[in] batch - Batch to queue in, or nullptr to emit every change
+     *                     immediately.
+     */
+    void batch_property_changes(sdbusplus::server::property_batch* batch)
+    {
+        _batch = batch;
+    }
+
+% if interface.methods:
+    /** @brief Count calls and time the method handlers.
+     *
+     *  Each method's calls, error replies, queue wait and handler time are
+     *  recorded in `stats` under "${interface.name}.<Method>".
+     *
+     *  @param[in] stats - Registry to record in, or nullptr to stop.
+     */
+    void record_method_stats(sdbusplus::server::method_stats* stats)
+    {
+    % for i, m in enumerate(interface.methods):
+        _method_counters[${i}] =
+            stats ? &stats->method(interface, "${m.name}") : nullptr;
+    % endfor
+    }
+
+    /** @brief Bound the async method handlers in flight.
+     *
+     *  Calls beyond `control`'s limits, each method being gated as
+     *  "${interface.name}.<Method>", are answered at once with
+     *  admission_control::busy_error.  Synchronous handlers finish within
+     *  their callback and are not gated.
+     *
+     *  @param[in] control - Limits to admit calls by, or nullptr to stop.
+     */
+    void limit_method_calls(sdbusplus::server::admission_control* control)
+    {
+    % for i, m in enumerate(interface.methods):
+        _method_admission[${i}] =
+            control ? &control->method(interface, "${m.name}") : nullptr;
+    % endfor
+    }
+% endif
+
     /* Property access tags. */
 % for p in interface.properties:
 ${p.render(loader, "property.aserver.tag.hpp.mako", property=p, interface=interface)}\
@@ -101,6 +157,19 @@ ${p.render(loader, "property.aserver.set.hpp.mako", property=p, interface=interf
 % endfor
 
   private:
+    /** @brief Emit, or queue in the batch, PropertiesChanged. */
+    void _property_changed(const char* name)
+    {
+        if (_batch)
+        {
+            _batch->mark(_path, interface, name);
+        }
+        else
+        {
+            _${interface.joinedName("_", "interface")}.property_changed(name);
+        }
+    }
+
     /** @return the async context */
     sdbusplus::async::context& _context()
     {
@@ -110,6 +179,14 @@ ${p.render(loader, "property.aserver.set.hpp.mako", property=p, interface=interf
 
     sdbusplus::server::interface_t
         _${interface.joinedName("_", "interface")};
+    std::string _path;
+    sdbusplus::server::property_batch* _batch = nullptr;
+% if interface.methods:
+    std::array<sdbusplus::server::method_stats::counters*, ${len(interface.methods)}>
+        _method_counters{};
+    std::array<sdbusplus::server::admission_control::gate*, ${len(interface.methods)}>
+        _method_admission{};
+% endif
 
 % for p in interface.properties:
 ${p.render(loader, "property.aserver.typeid.hpp.mako", property=p, interface=interface)}\
@@ -1,8 +1,16 @@
 #pragma once
+#include <sdbusplus/async/batch.hpp>
 #include <sdbusplus/async/client.hpp>
+#include <sdbusplus/async/deadline.hpp>
 #include <sdbusplus/async/execution.hpp>
+#include <sdbusplus/async/property_cache.hpp>
+#include <sdbusplus/async/signal_hub.hpp>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 % for h in interface.cpp_includes():
 #include <${h}>
@@ -63,44 +71,81 @@ ${m.render(loader, "method.client.hpp.mako", method=m, interface=interface)}
     % for p in interface.properties:
 ${p.render(loader, "property.client.hpp.mako", property=p, interface=interface)}
     % endfor
+    % for s in interface.signals:
+${s.render(loader, "signal.client.hpp.mako", signal=s, interface=interface)}
+    % endfor
 
     % if interface.properties:
     auto properties()
     {
         return proxy.template get_all_properties<PropertiesVariant>(context()) |
-               sdbusplus::async::execution::then([](auto&& v) {
-                   properties_t result;
-                   for (const auto& [property, value] : v)
-                   {
-                       std::visit(
-                           [&](auto v) {
-                               % for p in interface.properties:
-                               if (property == "${p.name}")
-                               {
-                                   if constexpr (std::is_same_v<
-                                                     std::decay_t<decltype(v)>,
-                                                     ${p.cppTypeParam(interface.name)}>)
-                                   {
-                                       result.${p.snake_case} = v;
-                                       return;
-                                   }
-                                   else
-                                   {
-                                       throw exception::UnpackPropertyError(
-                                           property,
-                                           UnpackErrorReason::wrongType);
-                                   }
-                               }
-                               % endfor
-                           },
-                           value);
-                   }
-                   return result;
-               });
+               sdbusplus::async::execution::then(
+                   [](auto&& v) { return _unpack_properties(v); });
+    }
+
+    /** Get all properties, from `cache` while it holds all of them. */
+    auto properties(
+        sdbusplus::async::property_cache<PropertiesVariant>& cache)
+    {
+        return cache.get_all() |
+               sdbusplus::async::execution::then(
+                   [](auto&& v) { return _unpack_properties(v); });
+    }
+
+    /** Get all properties from `caller`'s object, before `d`.
+     *
+     *  The GetAll reply is decoded in place by read_properties(): no
+     *  container of names and variants is built, and unknown properties
+     *  are skipped undecoded.
+     */
+    auto properties(sdbusplus::async::deadline_caller& caller,
+                    sdbusplus::async::deadline d = {})
+        -> sdbusplus::async::task<properties_t>
+    {
+        auto reply = co_await caller.template call<sdbusplus::message_t>(
+            "org.freedesktop.DBus.Properties", "GetAll", d, interface);
+
+        properties_t result;
+        read_properties(reply, result);
+        co_return result;
     }
     % endif
 
   private:
+    % if interface.properties:
+    static properties_t _unpack_properties(const auto& v)
+    {
+        properties_t result;
+        for (const auto& [property, value] : v)
+        {
+            switch (property_slot(property).value_or(${len(interface.properties)}))
+            {
+                % for i, p in enumerate(interface.properties_by_slot()):
+                case ${i}:
+                    _unpack_property(property, value, result.${p.snake_case});
+                    break;
+                % endfor
+                default:
+                    break;
+            }
+        }
+        return result;
+    }
+
+    template <typename T>
+    static void _unpack_property(const std::string& property,
+                                 const PropertiesVariant& value, T& member)
+    {
+        auto p = std::get_if<T>(&value);
+        if (!p)
+        {
+            throw exception::UnpackPropertyError(
+                property, UnpackErrorReason::wrongType);
+        }
+        member = *p;
+    }
+
+    % endif
     // Conversion constructor from proxy used by client_t.
     explicit constexpr ${interface.classname}(Proxy p) :
         proxy(p.interface(interface))
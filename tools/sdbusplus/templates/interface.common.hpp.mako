@@ -1,14 +1,18 @@
 #pragma once
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <tuple>
 
 #include <sdbusplus/exception.hpp>
 #include <sdbusplus/message.hpp>
+#include <sdbusplus/message/read_properties.hpp>
 #include <sdbusplus/utility/dedup_variant.hpp>
+#include <sdbusplus/utility/perfect_hash.hpp>
 
 % for h in interface.cpp_includes():
 #include <${h}>
@@ -52,6 +56,27 @@ struct ${interface.classname}
 
     using PropertiesVariant = sdbusplus::utility::dedup_variant_t<
         ${",\n        ".join(sorted(setOfPropertyTypes()))}>;
+
+    /** @brief Look up a property by name in constant time.
+     *  @param[in] name - The property name, ex. "${interface.properties[0].name}".
+     *  @return - The property's slot in the generated perfect hash, or
+     *            std::nullopt if the interface has no such property.
+     */
+    static constexpr std::optional<size_t>
+        property_slot(std::string_view name) noexcept;
+
+    /** @brief Read an a{sv} of properties, such as a GetAll reply, into
+     *         `result`.
+     *
+     *  Each name is matched through property_slot() without being copied,
+     *  and its value read straight into its member; unknown names are
+     *  skipped.  Throws UnpackPropertyError if a property has another type.
+     *
+     *  @param[in] m - The message, positioned at the array.
+     *  @param[in,out] result - Members of properties in `m` are replaced.
+     */
+    static void read_properties(sdbusplus::message_t& m,
+                                properties_t& result);
     % else:
     using properties_t = std::nullopt_t;
     % endif
@@ -108,15 +133,16 @@ struct ${interface.classname}
      *
      *  @note Throws if string is not a valid mapping.
      */
-    static ${e.name} convert${e.name}FromString(const std::string& s);
+    static constexpr ${e.name}
+        convert${e.name}FromString(std::string_view s);
 
     /** @brief Convert a string to an appropriate enum value.
      *  @param[in] s - The string to convert in the form of
      *                 "${interface.name}.<value name>"
      *  @return - The enum value or std::nullopt
      */
-    static std::optional<${e.name}>
-        convertStringTo${e.name}(const std::string& s) noexcept;
+    static constexpr std::optional<${e.name}>
+        convertStringTo${e.name}(std::string_view s) noexcept;
 
     /** @brief Convert an enum value to a string.
      *  @param[in] e - The enum to convert to a string.
@@ -124,6 +150,14 @@ struct ${interface.classname}
      *            "${interface.name}.<value name>"
      */
     static std::string convert${e.name}ToString(${e.name} e);
+
+    /** @brief Convert an enum value to a string without allocating.
+     *  @param[in] e - The enum to convert to a string.
+     *  @return - A view of the static string, in the form of
+     *            "${interface.name}.<value name>"
+     */
+    static constexpr std::string_view
+        convert${e.name}ToStringView(${e.name} e);
     % endfor
 };
 
@@ -142,39 +176,110 @@ inline std::string convertForMessage(${interface.classname}::${e.name} e)
 }
 % endfor
 
+    % if interface.properties:
+
+namespace details
+{
+using namespace std::literals::string_view_literals;
+
+/** Perfect hash displacements for ${interface.classname} property names */
+inline constexpr std::array<int32_t, ${len(interface.properties)}> \
+propertyDisplacements${interface.classname} = {
+    ${", ".join(str(d) for d in interface.property_hash.displacements)},
+};
+
+/** ${interface.classname} property names indexed by perfect hash slot */
+inline constexpr std::array propertySlots${interface.classname} = {
+    % for p in interface.properties_by_slot():
+    "${p.name}"sv,
+    % endfor
+};
+} //  namespace details
+
+constexpr auto ${interface.classname}::property_slot(std::string_view name) noexcept
+    -> std::optional<size_t>
+{
+    auto slot = sdbusplus::utility::perfect_hash::lookup(
+        name, details::propertyDisplacements${interface.classname});
+
+    if (details::propertySlots${interface.classname}[slot] != name)
+    {
+        return std::nullopt;
+    }
+    return slot;
+}
+
+inline void ${interface.classname}::read_properties(
+    sdbusplus::message_t& m, properties_t& result)
+{
+    sdbusplus::message::read_properties(
+        m, [&](std::string_view name, auto& value) {
+            switch (property_slot(name).value_or(${len(interface.properties)}))
+            {
+    % for i, p in enumerate(interface.properties_by_slot()):
+                case ${i}:
+                    value.read(result.${p.snake_case});
+                    break;
+    % endfor
+                default:
+                    break;
+            }
+        });
+}
+    % endif
     % for e in interface.enums:
 
 namespace details
 {
 using namespace std::literals::string_view_literals;
 
-/** String to enum mapping for ${interface.classname}::${e.name} */
+/** String to enum mapping for ${interface.classname}::${e.name}, indexed by value */
 inline constexpr std::array mapping${interface.classname}${e.name} = {
     % for v in e.values:
     std::make_tuple("${interface.name}.${e.name}.${v.name}"sv,
                     ${interface.classname}::${e.name}::${v.name} ),
     % endfor
 };
+
+/** Perfect hash displacements for ${interface.classname}::${e.name} value
+ *  names */
+inline constexpr std::array<int32_t, ${len(e.values)}> \
+displacements${interface.classname}${e.name} = {
+    ${", ".join(str(d) for d in e.value_hash.displacements)},
+};
+
+/** ${interface.classname}::${e.name} values indexed by perfect hash slot */
+inline constexpr std::array slots${interface.classname}${e.name} = {
+    % for v in e.values_by_slot():
+    ${interface.classname}::${e.name}::${v.name},
+    % endfor
+};
 } //  namespace details
 
-inline auto ${interface.classname}::convertStringTo${e.name}(const std::string& s) noexcept
+constexpr auto ${interface.classname}::convertStringTo${e.name}(std::string_view s) noexcept
     -> std::optional<${e.name}>
 {
-    auto i = std::find_if(std::begin(details::mapping${interface.classname}${e.name}),
-                          std::end(details::mapping${interface.classname}${e.name}),
-                          [&s](auto& e){ return s == std::get<0>(e); } );
+    constexpr std::string_view prefix = "${interface.name}.${e.name}.";
 
-    if (std::end(details::mapping${interface.classname}${e.name}) == i)
+    if (!s.starts_with(prefix))
     {
         return std::nullopt;
     }
-    else
+
+    auto name = s.substr(prefix.size());
+    auto v = details::slots${interface.classname}${e.name}[
+        sdbusplus::utility::perfect_hash::lookup(
+            name, details::displacements${interface.classname}${e.name})];
+
+    if (std::get<0>(details::mapping${interface.classname}${e.name}[
+            static_cast<size_t>(v)]).substr(prefix.size()) != name)
     {
-        return std::get<1>(*i);
+        return std::nullopt;
     }
+    return v;
 }
 
-inline auto ${interface.classname}::convert${e.name}FromString(const std::string& s) -> ${e.name}
+constexpr auto ${interface.classname}::convert${e.name}FromString(std::string_view s) -> ${e.name}
 {
     auto r = convertStringTo${e.name}(s);
 
@@ -188,18 +293,22 @@ inline auto ${interface.classname}::convert${e.name}FromString(const std::string
     }
 }
 
-inline std::string ${interface.classname}::convert${e.name}ToString(
-    ${interface.classname}::${e.name} v)
+constexpr auto ${interface.classname}::convert${e.name}ToStringView(
+    ${interface.classname}::${e.name} v) -> std::string_view
 {
-    auto i = std::find_if(std::begin(details::mapping${interface.classname}${e.name}),
-                          std::end(details::mapping${interface.classname}${e.name}),
-                          [v](auto& e){ return v == std::get<1>(e); });
+    auto i = static_cast<size_t>(v);
 
-    if (i == std::end(details::mapping${interface.classname}${e.name}))
+    if (i >= details::mapping${interface.classname}${e.name}.size())
     {
         throw std::invalid_argument(std::to_string(static_cast<int>(v)));
     }
-    return std::string(std::get<0>(*i));
+    return std::get<0>(details::mapping${interface.classname}${e.name}[i]);
+}
+
+inline std::string ${interface.classname}::convert${e.name}ToString(
+    ${interface.classname}::${e.name} v)
+{
+    return std::string(convert${e.name}ToStringView(v));
 }
     % endfor
 
@@ -211,7 +320,7 @@ namespace sdbusplus::message::details
 template <>
 struct convert_from_string<common::${interface.cppNamespacedClass()}::${e.name}>
 {
-    static auto op(const std::string& value) noexcept
+    static constexpr auto op(std::string_view value) noexcept
     {
         return common::${interface.cppNamespacedClass()}::
             convertStringTo${e.name}(value);
@@ -4,6 +4,7 @@
 #include <sdbusplus/sdbuspp_support/server.hpp>
 #include <sdbusplus/server.hpp>
 #include <string>
+#include <string_view>
 #include <tuple>
 
 #include <${interface.headerFile("server")}>
@@ -24,30 +25,46 @@ ${ p.render(loader, "property.server.cpp.mako", property=p, interface=interface)
     % endfor
 
     % if interface.properties:
-void ${interface.classname}::setPropertyByName(const std::string& _name,
+void ${interface.classname}::setPropertyByName(std::string_view _name,
                                      const PropertiesVariant& val,
                                      bool skipSignal)
 {
-        % for p in interface.properties:
-    if (_name == "${p.name}")
+    auto slot = property_slot(_name);
+    if (!slot)
     {
-        auto& v = std::get<${p.cppTypeParam(interface.name)}>(\
-val);
-        ${p.camelCase}(v, skipSignal);
         return;
     }
+
+    switch (*slot)
+    {
+        % for i, p in enumerate(interface.properties_by_slot()):
+        case ${i}: // ${p.name}
+        {
+            auto& v = std::get<${p.cppTypeParam(interface.name)}>(\
+val);
+            ${p.camelCase}(v, skipSignal);
+            return;
+        }
         % endfor
+    }
 }
 
-auto ${interface.classname}::getPropertyByName(const std::string& _name) ->
+auto ${interface.classname}::getPropertyByName(std::string_view _name) ->
         PropertiesVariant
 {
-    % for p in interface.properties:
-    if (_name == "${p.name}")
+    auto slot = property_slot(_name);
+    if (!slot)
     {
-        return ${p.camelCase}();
+        return PropertiesVariant();
     }
+
+    switch (*slot)
+    {
+    % for i, p in enumerate(interface.properties_by_slot()):
+        case ${i}: // ${p.name}
+            return ${p.camelCase}();
     % endfor
+    }
 
     return PropertiesVariant();
 }
@@ -3,7 +3,9 @@
 #include <map>
 #include <sdbusplus/sdbus.hpp>
 #include <sdbusplus/server.hpp>
+#include <sdbusplus/server/property_batch.hpp>
 #include <string>
+#include <string_view>
 #include <systemd/sd-bus.h>
 
 % for h in interface.cpp_includes():
@@ -41,7 +43,7 @@ class ${interface.classname} :
         ${interface.classname}(bus_t& bus, const char* path) :
             _${interface.joinedName("_", "interface")}(
                 bus, path, interface, _vtable, this),
-            _sdbusplus_bus(bus) {}
+            _sdbusplus_bus(bus), _sdbusplus_path(path) {}
 
     % if interface.properties:
         /** @brief Constructor to initialize the object from a map of
@@ -88,7 +90,7 @@ ${p.camelCase}(${p.cppTypeParam(interface.name)} value);
          *  @param[in] _name - A string representation of the property name.
          *  @param[in] val - A variant containing the value to set.
          */
-        void setPropertyByName(const std::string& _name,
+        void setPropertyByName(std::string_view _name,
                                const PropertiesVariant& val,
                                bool skipSignal = false);
 
@@ -96,7 +98,7 @@ ${p.camelCase}(${p.cppTypeParam(interface.name)} value);
          *  @param[in] _name - A string representation of the property name.
          *  @return - A variant containing the value of the property.
          */
-        PropertiesVariant getPropertyByName(const std::string& _name);
+        PropertiesVariant getPropertyByName(std::string_view _name);
 
     % endif
 
@@ -119,11 +121,38 @@ ${p.camelCase}(${p.cppTypeParam(interface.name)} value);
             return  _sdbusplus_bus;
         }
 
+        /** @brief Coalesce this interface's PropertiesChanged signals.
+         *
+         *  While set, property changes are queued in the batch and sent as
+         *  one signal per interface when it is flushed.  The batch must
+         *  outlive this object or be reset first.
+         *
+         *  @param[in] batch - Batch to queue in, or nullptr to emit every
+         *                     change immediately.
+         */
+        void batch_property_changes(sdbusplus::server::property_batch* batch)
+        {
+            _sdbusplus_batch = batch;
+        }
+
     private:
     % for m in interface.methods:
 ${ m.cpp_prototype(loader, interface=interface, ptype='callback-header') }
     % endfor
 
+        /** @brief Emit, or queue in the batch, PropertiesChanged. */
+        void _emit_property_changed(const char* _name)
+        {
+            if (_sdbusplus_batch)
+            {
+                _sdbusplus_batch->mark(_sdbusplus_path, interface, _name);
+            }
+            else
+            {
+                _${interface.joinedName("_", "interface")}.property_changed(_name);
+            }
+        }
+
     % for p in interface.properties:
         /** @brief sd-bus callback for get-property '${p.name}' */
         static int _callback_get_${p.name}(
@@ -141,6 +170,8 @@ ${ m.cpp_prototype(loader, interface=interface, ptype='callback-header') }
         sdbusplus::server::interface_t
                 _${interface.joinedName("_", "interface")};
         bus_t&  _sdbusplus_bus;
+        std::string _sdbusplus_path;
+        sdbusplus::server::property_batch* _sdbusplus_batch = nullptr;
 
     % for p in interface.properties:
         ${p.cppTypeParam(interface.name)} _${p.camelCase}${p.default_value(interface.name)};
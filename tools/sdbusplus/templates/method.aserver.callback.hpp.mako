@@ -9,6 +9,7 @@ m_return = method.cpp_return_type(interface)
 i_name = interface.classname
 m_param_count = len(method.parameters)
 m_return_count = len(method.returns)
+m_index = interface.methods.index(method)
 %>\
     static int _callback_m_${m_name}(sd_bus_message* msg, void* context,
                                      sd_bus_error* error [[maybe_unused]])
@@ -21,6 +22,8 @@ m_return_count = len(method.returns)
     {
         auto self = static_cast<${i_name}*>(context);
         auto self_i = static_cast<Instance*>(self);
+        sdbusplus::server::method_timer timer(
+            self->_method_counters[${m_index}], msg);
 
         try
         {
@@ -52,6 +55,7 @@ m_return_count = len(method.returns)
 
                 if constexpr (!is_async)
                 {
+                    timer.started();
                     auto r = m.new_method_return();
 % if m_return_count == 0:
                     \
@@ -75,7 +79,17 @@ self_i->method_call(${m_tag}{}, m\
                 }
                 else
                 {
+                    sdbusplus::server::admission_ticket ticket(
+                        self->_method_admission[${m_index}], msg);
+                    if (!ticket)
+                    {
+                        timer.failed();
+                        return ticket.reject(error);
+                    }
+
                     auto fn = [](auto self, auto self_i,
+                                 sdbusplus::server::method_timer timer,
+                                 sdbusplus::server::admission_ticket ticket,
                                  sdbusplus::message_t m\
 % if m_param_count:
 ,
@@ -84,9 +98,10 @@ self_i->method_call(${m_tag}{}, m\
 )
                             -> sdbusplus::async::task<>
                     {
+                        timer.started();
+                        ticket.started();
                         try
                         {
-
                             auto r = m.new_method_return();
 % if m_return_count == 0:
                             \
@@ -113,12 +128,14 @@ co_await self_i->method_call(
 % for e in method.errors:
                         catch(const ${interface.errorNamespacedClass(e)}& e)
                         {
+                            timer.failed();
                             m.new_method_error(e).method_return();
                             co_return;
                         }
                         % endfor
                         catch(const std::exception&)
                         {
+                            timer.failed();
                             self->_context().get_bus().set_current_exception(
                                 std::current_exception());
                             co_return;
@@ -126,7 +143,8 @@ co_await self_i->method_call(
                     };
 
                     self->_context().spawn(
-                        std::move(fn(self, self_i, m\
+                        std::move(fn(self, self_i, std::move(timer),
+                                     std::move(ticket), m\
 % if m_param_count:
 , ${m_pmove}\
 % endif
@@ -146,6 +164,7 @@ co_await self_i->method_call(
 
                 if constexpr (!is_async)
                 {
+                    timer.started();
                     auto r = m.new_method_return();
 % if m_return_count == 0:
                     \
@@ -169,7 +188,17 @@ self_i->method_call(${m_tag}{}\
                 }
                 else
                 {
+                    sdbusplus::server::admission_ticket ticket(
+                        self->_method_admission[${m_index}], msg);
+                    if (!ticket)
+                    {
+                        timer.failed();
+                        return ticket.reject(error);
+                    }
+
                     auto fn = [](auto self, auto self_i,
+                                 sdbusplus::server::method_timer timer,
+                                 sdbusplus::server::admission_ticket ticket,
                                  sdbusplus::message_t m\
 % if m_param_count:
 ,
@@ -178,9 +207,10 @@ self_i->method_call(${m_tag}{}\
 )
                             -> sdbusplus::async::task<>
                     {
+                        timer.started();
+                        ticket.started();
                         try
                         {
-
                             auto r = m.new_method_return();
 % if m_return_count == 0:
                             \
@@ -207,12 +237,14 @@ co_await self_i->method_call(
 % for e in method.errors:
                         catch(const ${interface.errorNamespacedClass(e)}& e)
                         {
+                            timer.failed();
                             m.new_method_error(e).method_return();
                             co_return;
                         }
                         % endfor
                         catch(const std::exception&)
                         {
+                            timer.failed();
                             self->_context().get_bus().set_current_exception(
                                 std::current_exception());
                             co_return;
@@ -220,7 +252,8 @@ co_await self_i->method_call(
                     };
 
                     self->_context().spawn(
-                        std::move(fn(self, self_i, m\
+                        std::move(fn(self, self_i, std::move(timer),
+                                     std::move(ticket), m\
 % if m_param_count:
 , ${m_pmove}\
 % endif
@@ -231,11 +264,13 @@ co_await self_i->method_call(
 % for e in method.errors:
         catch(const ${interface.errorNamespacedClass(e)}& e)
         {
+            timer.failed();
             return e.set_error(error);
         }
 % endfor
         catch(const std::exception&)
         {
+            timer.failed();
             self->_context().get_bus().set_current_exception(
                 std::current_exception());
             return -EINVAL;
@@ -29,3 +29,49 @@ ${method.returns_as_list(interface)}>(context(), "${method.name}"\
     % endif
 );
     }
+
+    /** @brief ${ method.name } (deadline)
+     *  Call ${ method.name } on `caller`'s object, failing with ETIMEDOUT
+     *  once `d` passes.  Stopping the awaiting task releases the pending
+     *  reply at once.
+     *
+     *  @param[in] caller - The object's address and outcome counters.
+     *  @param[in] d - Deadline for the reply.
+    % for p in method.parameters:
+     *  @param[in] ${p.camelCase} - ${p.description.strip()}
+    % endfor
+     */
+    auto ${method.snake_case}(sdbusplus::async::deadline_caller& caller,
+        sdbusplus::async::deadline d\
+    % if len(method.parameters) != 0:
+, ${method.get_parameters_str(interface, join_str=", ")}\
+    % endif
+)
+    {
+        return caller.template call<\
+${method.returns_as_list(interface)}>(interface, "${method.name}", d\
+    % if len(method.parameters) != 0:
+, ${method.parameters_as_list()}\
+    % endif
+);
+    }
+
+    /** @brief ${ method.name } (pipelined)
+     *  Call ${ method.name } once per argument tuple, keeping at most
+     *  'window' calls in flight on the client's context.
+     *
+     *  @param[in] args - Arguments for each call.
+     *  @param[in] window - Maximum number of outstanding calls.
+     *
+     *  @return One sdbusplus::async::batch_result per call, in request order.
+     *          A failed call carries its exception instead of a value.
+     */
+    auto ${method.snake_case}_batch(
+        std::vector<std::tuple<${method.parameter_types_as_list(interface)}>> args,
+        size_t window = 16)
+    {
+        return sdbusplus::async::batch<${method.cpp_return_type(interface)}>(
+            std::move(args), window, [this](auto&&... a) {
+                return ${method.snake_case}(std::forward<decltype(a)>(a)...);
+            });
+    }
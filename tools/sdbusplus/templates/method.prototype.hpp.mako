@@ -33,12 +33,38 @@
 ###
     % elif ptype == 'callback-cpp':
 int ${interface.classname}::_callback_${ method.CamelCase }(
+    % if interface.static_marshal:
+        sd_bus_message* msg, void* context,
+        sd_bus_error* error [[maybe_unused]])
+    % else:
         sd_bus_message* msg, void* context, sd_bus_error* error)
+    % endif
 {
     auto o = static_cast<${interface.classname}*>(context);
 
     try
     {
+    % if interface.static_marshal:
+        auto m = sdbusplus::message_t(msg, o->get_bus().getInterface());
+        % for p in method.parameters:
+        ${p.cppTypeParam(interface.name)} ${p.camelCase}{};
+        % endfor
+        % if method.parameters:
+        m.read(${method.parameters_as_list()});
+        % endif
+
+        auto r = m.new_method_return();
+        % if len(method.returns) == 0:
+        o->${ method.camelCase }(${method.parameters_as_list(lambda p: f"std::move({p.camelCase})")});
+        % elif len(method.returns) == 1:
+        r.append(o->${ method.camelCase }(${method.parameters_as_list(lambda p: f"std::move({p.camelCase})")}));
+        % else:
+        std::apply([&r](auto&&... v) { r.append(std::move(v)...); },
+                   o->${ method.camelCase }(${method.parameters_as_list(lambda p: f"std::move({p.camelCase})")}));
+        % endif
+        r.method_return();
+        return 1;
+    % else:
         return sdbusplus::sdbuspp::method_callback\
     % if len(method.returns) > 1:
 <true>\
@@ -52,6 +78,7 @@ int ${interface.classname}::_callback_${ method.CamelCase }(
                                 ${method.parameters_as_list()});
                     }
                 ));
+    % endif
     }
     % for e in method.errors:
     catch(const ${interface.errorNamespacedClass(e)}& e)
@@ -70,12 +97,34 @@ namespace details
 {
 namespace ${interface.classname}
 {
+    % if interface.static_marshal and method.parameters_signature() is not None:
+static constexpr char _param_${ method.CamelCase }[] = "${ method.parameters_signature() }";
+static_assert(std::string_view(_param_${ method.CamelCase }) ==
+        utility::tuple_to_array(message::types::type_id<
+                ${ method.parameter_types_as_list(interface) }>()).data());
+    % elif interface.static_marshal:
+static constexpr auto _param_${ method.CamelCase } =
+        utility::tuple_to_array(message::types::type_id<
+                ${ method.parameter_types_as_list(interface) }>());
+    % endif
+    % if interface.static_marshal and method.returns_signature() is not None:
+static constexpr char _return_${ method.CamelCase }[] = "${ method.returns_signature() }";
+static_assert(std::string_view(_return_${ method.CamelCase }) ==
+        utility::tuple_to_array(message::types::type_id<
+                ${ method.returns_as_list(interface, full=True) }>()).data());
+    % elif interface.static_marshal:
+static constexpr auto _return_${ method.CamelCase } =
+        utility::tuple_to_array(message::types::type_id<
+                ${ method.returns_as_list(interface, full=True) }>());
+    % endif
+    % if not interface.static_marshal:
 static const auto _param_${ method.CamelCase } =
         utility::tuple_to_array(message::types::type_id<
                 ${ method.parameter_types_as_list(interface) }>());
 static const auto _return_${ method.CamelCase } =
         utility::tuple_to_array(message::types::type_id<
                 ${ method.returns_as_list(interface, full=True) }>());
+    % endif
 }
 }
     % endif
@@ -1,6 +1,13 @@
+<%
+# With --static-marshal the signatures are char arrays, not std::arrays,
+# unless they depend on the target's size_t.
+static = interface.static_marshal
+param = "" if static and method.parameters_signature() is not None else ".data()"
+ret = "" if static and method.returns_signature() is not None else ".data()"
+%>\
     vtable::method("${method.name}",
-                   details::${interface.classname}::_param_${ method.CamelCase }.data(),
-                   details::${interface.classname}::_return_${ method.CamelCase }.data(),
+                   details::${interface.classname}::_param_${ method.CamelCase }${param},
+                   details::${interface.classname}::_return_${ method.CamelCase }${ret},
         % if method.cpp_flags:
                    _callback_${method.CamelCase},
                    ${method.cpp_flags}\
@@ -18,21 +18,33 @@ i_name = interface.classname
             // Set up the transaction.
             sdbusplus::server::transaction::set_id(m);
 
-            // Get property value and add to message.
+            // Get property value and add to message.  Getters may return a
+            // const reference or a view; either is appended in place.
             if constexpr (server_details::has_get_property_msg<${p_tag},
                                                                Instance>)
             {
-                auto v = self->${p_name}(m);
-                static_assert(std::is_convertible_v<decltype(v), ${p_type}>,
-                              "Property doesn't convert to '${p_type}'.");
-                m.append<${p_type}>(std::move(v));
+                decltype(auto) v = self->${p_name}(m);
+                static_assert(
+                    sdbusplus::message::appendable_as<${p_type}, decltype(v)>,
+                    "Property doesn't convert to '${p_type}'.");
+                sdbusplus::message::append_as<${p_type}>(m, v);
+            }
+            else if constexpr (server_details::has_get_property_nomsg<
+                                   ${p_tag}, Instance>)
+            {
+                decltype(auto) v = self->${p_name}();
+                static_assert(
+                    sdbusplus::message::appendable_as<${p_type}, decltype(v)>,
+                    "Property doesn't convert to '${p_type}'.");
+                sdbusplus::message::append_as<${p_type}>(m, v);
             }
             else
             {
-                auto v = self->${p_name}();
-                static_assert(std::is_convertible_v<decltype(v), ${p_type}>,
-                              "Property doesn't convert to '${p_type}'.");
-                m.append<${p_type}>(std::move(v));
+                static_assert(
+                    !server_details::has_get_property_missing_const<${p_tag},
+                                                                    Instance>,
+                    "Missing const on get_property(${p_tag})?");
+                m.append(self->${p_name}_);
             }
         }
         % for e in property.errors:
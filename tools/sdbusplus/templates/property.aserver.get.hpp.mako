@@ -2,12 +2,12 @@
 p_name = property.snake_case;
 p_tag = property.snake_case + "_t"
 %>\
-    auto ${p_name}() const
+    decltype(auto) ${p_name}() const
         requires server_details::has_get_property_nomsg<${p_tag}, Instance>
     {
         return static_cast<const Instance*>(this)->get_property(${p_tag}{});
     }
-    auto ${p_name}(sdbusplus::message_t& m) const
+    decltype(auto) ${p_name}(sdbusplus::message_t& m) const
         requires server_details::has_get_property_msg<${p_tag}, Instance>
     {
         return static_cast<const Instance*>(this)->get_property(${p_tag}{}, m);
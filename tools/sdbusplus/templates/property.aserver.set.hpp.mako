@@ -2,7 +2,6 @@
 p_name = property.snake_case;
 p_tag = property.snake_case + "_t"
 p_type = property.cppTypeParam(interface.name)
-i_name = interface.joinedName("_", "interface")
 %>\
     template <bool EmitSignal = true, typename Arg = ${p_type}>
     void ${p_name}(Arg&& new_value)
@@ -14,7 +13,7 @@ i_name = interface.joinedName("_", "interface")
 
         if (changed && EmitSignal)
         {
-            _${i_name}.property_changed("${property.name}");
+            _property_changed("${property.name}");
         }
     }
 
@@ -28,7 +27,7 @@ i_name = interface.joinedName("_", "interface")
 
         if (changed && EmitSignal)
         {
-            _${i_name}.property_changed("${property.name}");
+            _property_changed("${property.name}");
         }
     }
 
@@ -46,6 +45,6 @@ i_name = interface.joinedName("_", "interface")
 
         if (changed && EmitSignal)
         {
-            _${i_name}.property_changed("${property.name}");
+            _property_changed("${property.name}");
         }
     }
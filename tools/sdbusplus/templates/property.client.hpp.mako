@@ -7,6 +7,14 @@
 ${property.cppTypeParam(interface.name)}>(context(), "${property.name}");
     }
 
+    /** Get value of ${property.name}, from `cache` when it holds it. */
+    auto ${property.snake_case}(
+        sdbusplus::async::property_cache<PropertiesVariant>& cache)
+    {
+        return cache.template get<\
+${property.cppTypeParam(interface.name)}>("${property.name}");
+    }
+
 % if 'const' not in property.flags and 'readonly' not in property.flags:
     /** Set value of ${property.name}
      *  ${property.description.strip()}
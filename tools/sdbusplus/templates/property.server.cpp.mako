@@ -7,12 +7,21 @@ auto ${interface.classname}::${property.camelCase}() const ->
 int ${interface.classname}::_callback_get_${property.name}(
         sd_bus* /*bus*/, const char* /*path*/, const char* /*interface*/,
         const char* /*property*/, sd_bus_message* reply, void* context,
+% if interface.static_marshal:
+        sd_bus_error* error [[maybe_unused]])
+% else:
         sd_bus_error* error)
+% endif
 {
     auto o = static_cast<${interface.classname}*>(context);
 
     try
     {
+    % if interface.static_marshal:
+        auto m = sdbusplus::message_t(reply, o->get_bus().getInterface());
+        m.append(o->${property.camelCase}());
+        return 1;
+    % else:
         return sdbusplus::sdbuspp::property_callback(
                 reply, o->get_bus().getInterface(), error,
                 std::function(
@@ -21,6 +30,7 @@ int ${interface.classname}::_callback_get_${property.name}(
                         return o->${property.camelCase}();
                     }
                 ));
+    % endif
     }
     % for e in property.errors:
     catch(const ${interface.errorNamespacedClass(e)}& e)
@@ -44,7 +54,7 @@ auto ${interface.classname}::${property.camelCase}(${property.cppTypeParam(inter
         _${property.camelCase} = value;
         if (!skipSignal)
         {
-            _${interface.joinedName("_", "interface")}.property_changed("${property.name}");
+            _emit_property_changed("${property.name}");
         }
     }
 
@@ -61,12 +71,23 @@ auto ${interface.classname}::${property.camelCase}(${property.cppTypeParam(inter
 int ${interface.classname}::_callback_set_${property.name}(
         sd_bus* /*bus*/, const char* /*path*/, const char* /*interface*/,
         const char* /*property*/, sd_bus_message* value, void* context,
+% if interface.static_marshal:
+        sd_bus_error* error [[maybe_unused]])
+% else:
         sd_bus_error* error)
+% endif
 {
     auto o = static_cast<${interface.classname}*>(context);
 
     try
     {
+    % if interface.static_marshal:
+        auto m = sdbusplus::message_t(value, o->get_bus().getInterface());
+        ${property.cppTypeParam(interface.name)} arg{};
+        m.read(arg);
+        o->${property.camelCase}(std::move(arg));
+        return 1;
+    % else:
         return sdbusplus::sdbuspp::property_callback(
                 value, o->get_bus().getInterface(), error,
                 std::function(
@@ -75,6 +96,7 @@ int ${interface.classname}::_callback_set_${property.name}(
                         o->${property.camelCase}(std::move(arg));
                     }
                 ));
+    % endif
     }
     % for e in property.errors:
     catch(const ${interface.errorNamespacedClass(e)}& e)
@@ -94,8 +116,19 @@ namespace details
 {
 namespace ${interface.classname}
 {
+% if interface.static_marshal and property.signature() is not None:
+static constexpr char _property_${property.name}[] = "${property.signature()}";
+static_assert(std::string_view(_property_${property.name}) ==
+    utility::tuple_to_array(message::types::type_id<
+            ${property.cppTypeParam(interface.name, full=True)}>()).data());
+% elif interface.static_marshal:
+static constexpr auto _property_${property.name} =
+    utility::tuple_to_array(message::types::type_id<
+            ${property.cppTypeParam(interface.name, full=True)}>());
+% else:
 static const auto _property_${property.name} =
     utility::tuple_to_array(message::types::type_id<
             ${property.cppTypeParam(interface.name, full=True)}>());
+% endif
 }
 }
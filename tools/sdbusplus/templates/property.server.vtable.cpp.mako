@@ -1,5 +1,9 @@
+<%
+static = interface.static_marshal and property.signature() is not None
+data = "" if static else ".data()"
+%>\
     vtable::property("${property.name}",
-                     details::${interface.classname}::_property_${property.name}.data(),
+                     details::${interface.classname}::_property_${property.name}${data},
                      _callback_get_${property.name},
         % if 'const' not in property.flags and 'readonly' not in property.flags:
                      _callback_set_${property.name},
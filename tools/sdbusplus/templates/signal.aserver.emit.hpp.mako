@@ -8,6 +8,15 @@
             (p.cppTypeParam(interface.name), p.camelCase, p.default_value(interface.name))
         return r
 
+    def const_parameters():
+        return ",\n            ".\
+            join([ const_parameter(p) for p in signal.properties ])
+
+    def const_parameter(p):
+        r = "const %s& %s%s" % \
+            (p.cppTypeParam(interface.name), p.camelCase, p.default_value(interface.name))
+        return r
+
     def parameters_as_list():
         return ", ".join([ p.camelCase for p in signal.properties ])
 
@@ -32,3 +41,28 @@
         m.append(${parameters_as_list()});
         m.signal_send();
     }
+
+    /** @brief Queue signal '${signal.name}' in a burst
+     *
+     *  The signal is sent by the burst's next flush(), back to back with
+     *  the rest of the burst.
+     *
+     *  @param[in] burst - Burst to queue in.
+% for p in signal.properties:
+     *  @param[in] ${p.camelCase} - ${p.description.strip()}
+% endfor
+     */
+    void ${signal.camelCase}(sdbusplus::server::signal_burst& burst\
+% if len(signal.properties) != 0:
+,
+            ${const_parameters()}\
+% endif
+)
+    {
+        burst.queue(_path.c_str(), interface, "${signal.name}"\
+% if len(signal.properties) != 0:
+,
+                    ${parameters_as_list()}\
+% endif
+);
+    }
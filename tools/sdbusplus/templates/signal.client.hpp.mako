@@ -0,0 +1,50 @@
+<%
+    def types():
+        return ", ".join([ p.cppTypeParam(interface.name)
+                for p in signal.properties ])
+
+    def spec():
+        return ("{.sender = std::string(service),\n"
+                "                  .path = std::string(path),\n"
+                "                  .interface = interface,\n"
+                "                  .member = \"%s\"}" % signal.name)
+%>\
+    /** @brief Subscribe to signal '${signal.name}'
+     *  ${ signal.description.strip() }
+     *
+     *  Signals from `service` at `path` are queued from now on;
+     *  `co_await s.next()` takes the next one\
+% if len(signal.properties) == 1:
+ as ${signal.properties[0].cppTypeParam(interface.name)}\
+% elif len(signal.properties) > 1:
+ as std::tuple<${types()}>\
+% endif
+.
+     *  Subscriptions to the same signal of the same object through `hub`
+     *  share one match.
+     *
+     *  @param[in] hub - Shared matches of the client's connection.
+     *  @param[in] service - The object's service.
+     *  @param[in] path - The object's path.
+     */
+    auto ${signal.snake_case}(
+        sdbusplus::async::signal_hub& hub, std::string_view service,
+        std::string_view path)
+    {
+        return sdbusplus::async::signal_subscription<${types()}>(
+            hub, ${spec()});
+    }
+
+    /** @brief Subscribe `callback` to signal '${signal.name}'
+     *  As above, with each signal handed to `callback(${types()})` as it
+     *  is dispatched instead of queued.
+     */
+    template <typename Callback>
+    auto ${signal.snake_case}(
+        sdbusplus::async::signal_hub& hub, std::string_view service,
+        std::string_view path, Callback&& callback)
+    {
+        return sdbusplus::async::signal_subscription<${types()}>(
+            hub, ${spec()},
+            std::forward<Callback>(callback));
+    }
@@ -50,9 +50,20 @@ namespace details
 {
 namespace ${interface.classname}
 {
+    % if interface.static_marshal and signal.signature() is not None:
+static constexpr char _signal_${ signal.CamelCase }[] = "${ signal.signature() }";
+static_assert(std::string_view(_signal_${ signal.CamelCase }) ==
+        utility::tuple_to_array(message::types::type_id<
+                ${ parameters_types_as_list() }>()).data());
+    % elif interface.static_marshal:
+static constexpr auto _signal_${ signal.CamelCase } =
+        utility::tuple_to_array(message::types::type_id<
+                ${ parameters_types_as_list() }>());
+    % else:
 static const auto _signal_${ signal.CamelCase } =
         utility::tuple_to_array(message::types::type_id<
                 ${ parameters_types_as_list() }>());
+    % endif
 }
 }
     % endif
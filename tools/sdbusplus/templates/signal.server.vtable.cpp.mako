@@ -1,2 +1,6 @@
+<%
+static = interface.static_marshal and signal.signature() is not None
+data = "" if static else ".data()"
+%>\
     vtable::signal("${signal.name}",
-                   details::${interface.classname}::_signal_${signal.CamelCase }.data()),
+                   details::${interface.classname}::_signal_${signal.CamelCase }${data}),
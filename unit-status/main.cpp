@@ -0,0 +1,487 @@
+#include "systemd1.hpp"
+#include "unit_table.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/asio/method_stats.hpp>
+#include <sdbusplus/asio/object_server.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/method_stats.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+/** Unit states for many callers, from one connection to systemd.
+ *
+ *  Units are resolved with ListUnitsByNames and ListUnitsByPatterns, as
+ *  many per call as a query names, the first time they are asked for.
+ *  From then on they are kept current from PropertiesChanged on their unit
+ *  objects (one match for all of them) and queries are answered from the
+ *  local table without calling systemd.
+ *
+ *  usage: unit-status [--systemd <bus name>] [--pattern <glob>]...
+ */
+
+constexpr auto statusService = "com.example.UnitStatus";
+constexpr auto statusPath = "/com/example/UnitStatus";
+constexpr auto statusInterface = "com.example.UnitStatus";
+
+/** (LoadState, ActiveState, SubState) */
+using Status = std::tuple<std::string, std::string, std::string>;
+using StatusMap = std::map<std::string, Status>;
+using Entries = std::vector<systemd1::ListUnitsEntry>;
+
+namespace rules = sdbusplus::bus::match::rules;
+
+namespace
+{
+
+void check(int r, const char* what)
+{
+    if (r < 0)
+    {
+        throw sdbusplus::exception::SdBusError(-r, what);
+    }
+}
+
+unit_status::Unit toUnit(const systemd1::ListUnitsEntry& e)
+{
+    using namespace systemd1;
+    return {std::get<UNIT_NAME>(e), std::get<UNIT_OBJ_PATH>(e).str,
+            std::get<UNIT_LOAD_STATE>(e), std::get<UNIT_ACTIVE_STATE>(e),
+            std::get<UNIT_SUB_STATE>(e)};
+}
+
+Status toStatus(const unit_status::Unit& u)
+{
+    return {u.load, u.active, u.sub};
+}
+
+} // namespace
+
+class UnitStatus
+{
+  public:
+    UnitStatus(std::shared_ptr<sdbusplus::asio::connection> conn,
+               std::string systemd) :
+        conn_(std::move(conn)), systemd_(std::move(systemd)), server_(conn_),
+        statsObject_(*conn_, stats_),
+        propertiesChanged_(
+            *conn_,
+            rules::type::signal() + rules::sender(systemd_) +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::member("PropertiesChanged") +
+                rules::argN(0, systemd1::unitInterface),
+            [this](sdbusplus::message_t& m) { onPropertiesChanged(m); }),
+        unitNew_(*conn_,
+                 rules::type::signal() + rules::sender(systemd_) +
+                     rules::interface(systemd1::managerInterface) +
+                     rules::member("UnitNew"),
+                 [this](sdbusplus::message_t& m) { onUnitNew(m); }),
+        unitRemoved_(*conn_,
+                     rules::type::signal() + rules::sender(systemd_) +
+                         rules::interface(systemd1::managerInterface) +
+                         rules::member("UnitRemoved"),
+                     [this](sdbusplus::message_t& m) { onUnitRemoved(m); }),
+        nameOwnerChanged_(*conn_, rules::nameOwnerChanged(systemd_),
+                          [this](sdbusplus::message_t& m) {
+                              onNameOwnerChanged(m);
+                          })
+    {
+        setupInterface();
+        subscribe();
+        conn_->request_name(statusService);
+    }
+
+    /** @brief Resolve `patterns` ahead of the first query. */
+    void preload(std::vector<std::string> patterns)
+    {
+        if (patterns.empty())
+        {
+            return;
+        }
+        ++systemdCalls_;
+        conn_->async_method_call(
+            [this, patterns](const boost::system::error_code& ec,
+                             const Entries& entries) {
+                if (ec)
+                {
+                    std::cerr << "ListUnitsByPatterns failed: " << ec.message()
+                              << "\n";
+                    return;
+                }
+                for (const auto& e : entries)
+                {
+                    table_.set(toUnit(e));
+                }
+                for (const auto& p : patterns)
+                {
+                    table_.track(p);
+                }
+            },
+            systemd_, systemd1::path, systemd1::managerInterface,
+            "ListUnitsByPatterns", std::vector<std::string>{}, patterns);
+    }
+
+  private:
+    void setupInterface()
+    {
+        iface_ = server_.add_interface(statusPath, statusInterface);
+
+        sdbusplus::asio::register_timed_method(
+            *iface_, stats_, "GetUnitStatus",
+            [this](boost::asio::yield_context yield,
+                   const std::vector<std::string>& names) {
+                return getUnitStatus(yield, names);
+            });
+
+        sdbusplus::asio::register_timed_method(
+            *iface_, stats_, "GetUnitStatusByPatterns",
+            [this](boost::asio::yield_context yield,
+                   const std::vector<std::string>& patterns) {
+                return getUnitStatusByPatterns(yield, patterns);
+            });
+
+        using sdbusplus::vtable::property_::none;
+        iface_->register_property_r<uint32_t>(
+            "Units", none, [this](const auto&) {
+                return static_cast<uint32_t>(table_.size());
+            });
+        iface_->register_property_r<uint64_t>(
+            "Hits", none, [this](const auto&) { return hits_; });
+        iface_->register_property_r<uint64_t>(
+            "Misses", none, [this](const auto&) { return misses_; });
+        iface_->register_property_r<uint64_t>(
+            "SystemdCalls", none,
+            [this](const auto&) { return systemdCalls_; });
+        iface_->register_property_r<uint64_t>(
+            "Updates", none, [this](const auto&) { return updates_; });
+
+        iface_->initialize();
+    }
+
+    /* Call a ListUnits* method of systemd and add what it returns. */
+    template <typename... Args>
+    void resolve(boost::asio::yield_context yield, const char* method,
+                 const Args&... args)
+    {
+        ++systemdCalls_;
+        boost::system::error_code ec;
+        auto entries = conn_->yield_method_call<Entries>(
+            yield, ec, systemd_, systemd1::path, systemd1::managerInterface,
+            method, args...);
+        if (ec)
+        {
+            throw sdbusplus::exception::SdBusError(ec.value(), method);
+        }
+        for (const auto& e : entries)
+        {
+            table_.set(toUnit(e));
+        }
+    }
+
+    StatusMap getUnitStatus(boost::asio::yield_context yield,
+                            const std::vector<std::string>& names)
+    {
+        std::vector<std::string> missing;
+        for (const auto& n : names)
+        {
+            if (table_.find(n) == nullptr)
+            {
+                missing.push_back(n);
+            }
+        }
+        hits_ += names.size() - missing.size();
+        misses_ += missing.size();
+
+        // Everything not yet known, in one call.
+        if (!missing.empty())
+        {
+            resolve(yield, "ListUnitsByNames", missing);
+        }
+
+        StatusMap r;
+        for (const auto& n : names)
+        {
+            if (auto u = table_.find(n))
+            {
+                r.emplace(n, toStatus(*u));
+            }
+        }
+        return r;
+    }
+
+    StatusMap getUnitStatusByPatterns(boost::asio::yield_context yield,
+                                      const std::vector<std::string>& patterns)
+    {
+        std::vector<std::string> missing;
+        for (const auto& p : patterns)
+        {
+            if (!table_.tracked(p))
+            {
+                missing.push_back(p);
+            }
+        }
+        hits_ += patterns.size() - missing.size();
+        misses_ += missing.size();
+
+        if (!missing.empty())
+        {
+            resolve(yield, "ListUnitsByPatterns", std::vector<std::string>{},
+                    missing);
+            for (auto& p : missing)
+            {
+                table_.track(std::move(p));
+            }
+        }
+
+        StatusMap r;
+        for (const auto* u : table_.match(patterns))
+        {
+            r.emplace(u->name, toStatus(*u));
+        }
+        return r;
+    }
+
+    /* Ask systemd to send unit signals; it sends none without a
+     * subscriber. */
+    void subscribe()
+    {
+        conn_->async_method_call(
+            [](const boost::system::error_code& ec) {
+                if (ec)
+                {
+                    std::cerr << "Subscribe failed: " << ec.message() << "\n";
+                }
+            },
+            systemd_, systemd1::path, systemd1::managerInterface, "Subscribe");
+    }
+
+    /* Re-read units whose state was invalidated rather than sent, or that
+     * appeared under a tracked pattern. */
+    void refresh(std::vector<std::string> names)
+    {
+        ++systemdCalls_;
+        conn_->async_method_call(
+            [this](const boost::system::error_code& ec,
+                   const Entries& entries) {
+                if (ec)
+                {
+                    return;
+                }
+                for (const auto& e : entries)
+                {
+                    table_.set(toUnit(e));
+                }
+            },
+            systemd_, systemd1::path, systemd1::managerInterface,
+            "ListUnitsByNames", names);
+    }
+
+    /* PropertiesChanged(s interface, a{sv} changed, as invalidated), with
+     * the state strings read in place and everything else skipped.  The
+     * match is in place before any unit is listed, so a change is either
+     * in the ListUnits* reply or arrives after it. */
+    void onPropertiesChanged(sdbusplus::message_t& msg)
+    {
+        auto path = msg.get_path();
+        auto name = table_.name(path);
+        if (name == nullptr)
+        {
+            return;
+        }
+
+        using Field = unit_status::UnitTable::Field;
+        auto field = [](std::string_view p) -> std::optional<Field> {
+            if (p == "LoadState")
+            {
+                return Field::load;
+            }
+            if (p == "ActiveState")
+            {
+                return Field::active;
+            }
+            if (p == "SubState")
+            {
+                return Field::sub;
+            }
+            return std::nullopt;
+        };
+
+        auto m = msg.get();
+        try
+        {
+            check(sd_bus_message_skip(m, "s"), "skip s");
+            check(sd_bus_message_enter_container(m, 'a', "{sv}"), "enter a");
+            while (true)
+            {
+                auto r = sd_bus_message_enter_container(m, 'e', "sv");
+                check(r, "enter e");
+                if (r == 0)
+                {
+                    break;
+                }
+                const char* property = nullptr;
+                check(sd_bus_message_read_basic(m, 's', &property), "read s");
+                auto f = field(property);
+                if (f && sd_bus_message_enter_container(m, 'v', "s") > 0)
+                {
+                    const char* value = nullptr;
+                    check(sd_bus_message_read_basic(m, 's', &value), "read s");
+                    check(sd_bus_message_exit_container(m), "exit v");
+                    table_.update(path, *f, value);
+                    ++updates_;
+                }
+                else
+                {
+                    check(sd_bus_message_skip(m, "v"), "skip v");
+                }
+                check(sd_bus_message_exit_container(m), "exit e");
+            }
+            check(sd_bus_message_exit_container(m), "exit a");
+
+            std::vector<std::string> invalidated;
+            msg.read(invalidated);
+            for (const auto& p : invalidated)
+            {
+                if (field(p))
+                {
+                    refresh({*name});
+                    break;
+                }
+            }
+        }
+        catch (const sdbusplus::exception::SdBusError& e)
+        {
+            std::cerr << "Bad PropertiesChanged: " << e.what() << "\n";
+        }
+    }
+
+    void onUnitNew(sdbusplus::message_t& msg)
+    {
+        std::string id;
+        sdbusplus::message::object_path path;
+        try
+        {
+            msg.read(id, path);
+        }
+        catch (const sdbusplus::exception::SdBusError& e)
+        {
+            std::cerr << "Bad UnitNew: " << e.what() << "\n";
+            return;
+        }
+        if (table_.find(id) == nullptr && table_.covered(id))
+        {
+            refresh({id});
+        }
+    }
+
+    void onUnitRemoved(sdbusplus::message_t& msg)
+    {
+        std::string id;
+        sdbusplus::message::object_path path;
+        try
+        {
+            msg.read(id, path);
+        }
+        catch (const sdbusplus::exception::SdBusError& e)
+        {
+            std::cerr << "Bad UnitRemoved: " << e.what() << "\n";
+            return;
+        }
+        // Resolved again, with one call, if it is asked for.
+        table_.remove(id);
+    }
+
+    /* A new systemd knows nothing of the old one's subscription, and the
+     * table may be stale: start over. */
+    void onNameOwnerChanged(sdbusplus::message_t& msg)
+    {
+        std::string name;
+        std::string oldOwner;
+        std::string newOwner;
+        try
+        {
+            msg.read(name, oldOwner, newOwner);
+        }
+        catch (const sdbusplus::exception::SdBusError& e)
+        {
+            std::cerr << "Bad NameOwnerChanged: " << e.what() << "\n";
+            return;
+        }
+
+        table_.clear();
+        if (!newOwner.empty())
+        {
+            subscribe();
+        }
+    }
+
+    std::shared_ptr<sdbusplus::asio::connection> conn_;
+    std::string systemd_;
+    sdbusplus::asio::object_server server_;
+    std::shared_ptr<sdbusplus::asio::dbus_interface> iface_;
+
+    sdbusplus::server::method_stats stats_;
+    sdbusplus::server::method_stats_object statsObject_;
+
+    unit_status::UnitTable table_;
+    /** Names and patterns answered from the table. */
+    uint64_t hits_ = 0;
+    /** Names and patterns that needed systemd. */
+    uint64_t misses_ = 0;
+    uint64_t systemdCalls_ = 0;
+    /** States applied from PropertiesChanged. */
+    uint64_t updates_ = 0;
+
+    sdbusplus::bus::match_t propertiesChanged_;
+    sdbusplus::bus::match_t unitNew_;
+    sdbusplus::bus::match_t unitRemoved_;
+    sdbusplus::bus::match_t nameOwnerChanged_;
+};
+
+int main(int argc, const char* argv[])
+{
+    std::string systemd = systemd1::service;
+    std::vector<std::string> patterns;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--systemd" && i + 1 < argc)
+        {
+            systemd = argv[++i];
+        }
+        else if (arg == "--pattern" && i + 1 < argc)
+        {
+            patterns.emplace_back(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--systemd <bus name>] [--pattern <glob>]...\n";
+            return -1;
+        }
+    }
+
+    boost::asio::io_context io;
+    auto conn = std::make_shared<sdbusplus::asio::connection>(io);
+
+    UnitStatus status(conn, systemd);
+    status.preload(std::move(patterns));
+
+    io.run();
+    return 0;
+}
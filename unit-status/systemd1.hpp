@@ -0,0 +1,66 @@
+#pragma once
+
+#include <sdbusplus/message/native_types.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+/** Names and types of org.freedesktop.systemd1 shared by unit-status and
+ *  systemd1-mock. */
+namespace systemd1
+{
+
+constexpr auto service = "org.freedesktop.systemd1";
+constexpr auto path = "/org/freedesktop/systemd1";
+constexpr auto managerInterface = "org.freedesktop.systemd1.Manager";
+constexpr auto unitInterface = "org.freedesktop.systemd1.Unit";
+constexpr auto unitPathPrefix = "/org/freedesktop/systemd1/unit/";
+
+/** One unit, as ListUnits, ListUnitsByNames and ListUnitsByPatterns return
+ *  it: (ssssssouso). */
+using ListUnitsEntry =
+    std::tuple<std::string, std::string, std::string, std::string,
+               std::string, std::string, sdbusplus::message::object_path,
+               uint32_t, std::string, sdbusplus::message::object_path>;
+
+enum ListUnitsField
+{
+    UNIT_NAME,
+    UNIT_DESC,
+    UNIT_LOAD_STATE,
+    UNIT_ACTIVE_STATE,
+    UNIT_SUB_STATE,
+    UNIT_FOLLOWING,
+    UNIT_OBJ_PATH,
+    UNIT_JOB_ID,
+    UNIT_JOB_TYPE,
+    UNIT_JOB_PATH,
+};
+
+/** @brief The object path systemd gives a unit: its name with every byte
+ *         but [A-Za-z0-9] written as _xx.
+ */
+inline std::string unitPath(std::string_view name)
+{
+    std::string p = unitPathPrefix;
+    for (unsigned char c : name)
+    {
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+            (c >= '0' && c <= '9'))
+        {
+            p += static_cast<char>(c);
+        }
+        else
+        {
+            char hex[4];
+            std::snprintf(hex, sizeof(hex), "_%02x", c);
+            p += hex;
+        }
+    }
+    return p;
+}
+
+} // namespace systemd1
@@ -0,0 +1,277 @@
+#include "systemd1.hpp"
+#include "unit_table.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/asio/object_server.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+/** A stand-in for the parts of org.freedesktop.systemd1 that unit-status
+ *  uses, so it can be run and measured without systemd.
+ *
+ *  Manager: ListUnits, ListUnitsByNames, ListUnitsByPatterns, LoadUnit,
+ *  StartUnit, StopUnit, Subscribe and Unsubscribe.  Each loaded unit is an
+ *  object with org.freedesktop.systemd1.Unit's Id, LoadState, ActiveState
+ *  and SubState.  As in systemd, a state change is one PropertiesChanged
+ *  carrying every changed property (and a timestamp), and signals are only
+ *  sent while someone is subscribed.
+ *
+ *  usage: systemd1-mock [--name <bus name>] [--units <n>] [<unit>...]
+ *
+ *  --units adds mock<i>.service for i < n; all start active (running).
+ */
+
+class Systemd1Mock
+{
+  public:
+    explicit Systemd1Mock(std::shared_ptr<sdbusplus::asio::connection> conn) :
+        conn_(std::move(conn)), server_(conn_)
+    {
+        setupManager();
+    }
+
+    void add(const std::string& name, const std::string& active,
+             const std::string& sub)
+    {
+        if (units_.contains(name))
+        {
+            return;
+        }
+        auto& u = units_[name];
+        u.unit = {name, systemd1::unitPath(name), "loaded", active, sub};
+        u.iface = server_.add_unique_interface(
+            u.unit.path, systemd1::unitInterface,
+            [&u](sdbusplus::asio::dbus_interface& i) {
+                using sdbusplus::vtable::property_::const_;
+                using sdbusplus::vtable::property_::emits_change;
+                i.register_property_r<std::string>(
+                    "Id", const_, [&u](const auto&) { return u.unit.name; });
+                i.register_property_r<std::string>(
+                    "LoadState", emits_change,
+                    [&u](const auto&) { return u.unit.load; });
+                i.register_property_r<std::string>(
+                    "ActiveState", emits_change,
+                    [&u](const auto&) { return u.unit.active; });
+                i.register_property_r<std::string>(
+                    "SubState", emits_change,
+                    [&u](const auto&) { return u.unit.sub; });
+            });
+
+        if (subscribers_ > 0)
+        {
+            auto s = conn_->new_signal(systemd1::path,
+                                       systemd1::managerInterface, "UnitNew");
+            s.append(name, sdbusplus::message::object_path(u.unit.path));
+            s.signal_send();
+        }
+    }
+
+  private:
+    struct MockUnit
+    {
+        unit_status::Unit unit;
+        std::unique_ptr<sdbusplus::asio::dbus_interface> iface;
+    };
+
+    static systemd1::ListUnitsEntry entry(const unit_status::Unit& u)
+    {
+        return {u.name,
+                "Mock " + u.name,
+                u.load,
+                u.active,
+                u.sub,
+                "",
+                sdbusplus::message::object_path(u.path),
+                0,
+                "",
+                sdbusplus::message::object_path("/")};
+    }
+
+    /* A unit systemd has never heard of is listed, not-found, all the
+     * same. */
+    static systemd1::ListUnitsEntry notFound(const std::string& name)
+    {
+        return entry(
+            {name, systemd1::unitPath(name), "not-found", "inactive", "dead"});
+    }
+
+    void setupManager()
+    {
+        manager_ = server_.add_interface(systemd1::path,
+                                         systemd1::managerInterface);
+
+        manager_->register_method("ListUnits", [this]() {
+            std::vector<systemd1::ListUnitsEntry> r;
+            for (const auto& [name, u] : units_)
+            {
+                r.push_back(entry(u.unit));
+            }
+            return r;
+        });
+
+        manager_->register_method(
+            "ListUnitsByNames", [this](const std::vector<std::string>& names) {
+                std::vector<systemd1::ListUnitsEntry> r;
+                for (const auto& n : names)
+                {
+                    auto it = units_.find(n);
+                    r.push_back(it == units_.end() ? notFound(n)
+                                                   : entry(it->second.unit));
+                }
+                return r;
+            });
+
+        manager_->register_method(
+            "ListUnitsByPatterns",
+            [this](const std::vector<std::string>& states,
+                   const std::vector<std::string>& patterns) {
+                std::vector<systemd1::ListUnitsEntry> r;
+                for (const auto& [name, u] : units_)
+                {
+                    bool state = states.empty();
+                    for (const auto& s : states)
+                    {
+                        state = state || s == u.unit.load ||
+                                s == u.unit.active || s == u.unit.sub;
+                    }
+                    bool pattern = patterns.empty();
+                    for (const auto& p : patterns)
+                    {
+                        pattern = pattern ||
+                                  unit_status::UnitTable::matches(p, name);
+                    }
+                    if (state && pattern)
+                    {
+                        r.push_back(entry(u.unit));
+                    }
+                }
+                return r;
+            });
+
+        manager_->register_method("LoadUnit", [this](const std::string& name) {
+            if (!units_.contains(name))
+            {
+                add(name, "inactive", "dead");
+            }
+            return sdbusplus::message::object_path(units_[name].unit.path);
+        });
+
+        manager_->register_method(
+            "StartUnit", [this](const std::string& name, const std::string&) {
+                return change(name, "active", "running");
+            });
+
+        manager_->register_method(
+            "StopUnit", [this](const std::string& name, const std::string&) {
+                return change(name, "inactive", "dead");
+            });
+
+        manager_->register_method("Subscribe", [this]() { ++subscribers_; });
+        manager_->register_method("Unsubscribe", [this]() {
+            if (subscribers_ > 0)
+            {
+                --subscribers_;
+            }
+        });
+
+        manager_->initialize();
+    }
+
+    sdbusplus::message::object_path change(const std::string& name,
+                                           const std::string& active,
+                                           const std::string& sub)
+    {
+        auto it = units_.find(name);
+        if (it == units_.end())
+        {
+            throw sdbusplus::exception::SdBusError(ENOENT, "NoSuchUnit");
+        }
+        auto& u = it->second.unit;
+        u.active = active;
+        u.sub = sub;
+
+        if (subscribers_ > 0)
+        {
+            using Value = std::variant<std::string, uint64_t>;
+            std::map<std::string, Value> changed{
+                {"ActiveState", u.active},
+                {"SubState", u.sub},
+                {"StateChangeTimestamp", ++timestamp_},
+            };
+            auto s = conn_->new_signal(u.path.c_str(),
+                                       "org.freedesktop.DBus.Properties",
+                                       "PropertiesChanged");
+            s.append(systemd1::unitInterface, changed,
+                     std::vector<std::string>{});
+            s.signal_send();
+        }
+
+        return sdbusplus::message::object_path(
+            "/org/freedesktop/systemd1/job/" + std::to_string(++jobs_));
+    }
+
+    std::shared_ptr<sdbusplus::asio::connection> conn_;
+    sdbusplus::asio::object_server server_;
+    std::shared_ptr<sdbusplus::asio::dbus_interface> manager_;
+    std::map<std::string, MockUnit> units_;
+    size_t subscribers_ = 0;
+    uint64_t jobs_ = 0;
+    uint64_t timestamp_ = 0;
+};
+
+int main(int argc, const char* argv[])
+{
+    std::string name = systemd1::service;
+    size_t count = 0;
+    std::vector<std::string> units;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--name" && i + 1 < argc)
+        {
+            name = argv[++i];
+        }
+        else if (arg == "--units" && i + 1 < argc)
+        {
+            count = std::stoul(argv[++i]);
+        }
+        else if (arg.starts_with("-"))
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--name <bus name>] [--units <n>] [<unit>...]\n";
+            return -1;
+        }
+        else
+        {
+            units.push_back(std::move(arg));
+        }
+    }
+
+    boost::asio::io_context io;
+    auto conn = std::make_shared<sdbusplus::asio::connection>(io);
+
+    Systemd1Mock mock(conn);
+    for (size_t i = 0; i < count; ++i)
+    {
+        mock.add("mock" + std::to_string(i) + ".service", "active", "running");
+    }
+    for (const auto& u : units)
+    {
+        mock.add(u, "active", "running");
+    }
+    conn->request_name(name.c_str());
+
+    io.run();
+    return 0;
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <fnmatch.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace unit_status
+{
+
+/** What unit-status knows about one unit. */
+struct Unit
+{
+    std::string name;
+    std::string path;
+    std::string load;
+    std::string active;
+    std::string sub;
+};
+
+/** @brief The local table unit-status answers from.
+ *
+ *  Units are keyed by name, with a second index by object path for
+ *  applying PropertiesChanged.  The patterns already resolved against
+ *  systemd are remembered, so a repeated pattern query, or a new unit that
+ *  one of them covers, can be answered without asking for the whole set
+ *  again.
+ */
+class UnitTable
+{
+  public:
+    /** Fields PropertiesChanged may carry. */
+    enum class Field
+    {
+        load,
+        active,
+        sub,
+    };
+
+    /** @return - The unit, or nullptr if it has never been resolved. */
+    const Unit* find(std::string_view name) const
+    {
+        auto it = units_.find(std::string(name));
+        return it == units_.end() ? nullptr : &it->second;
+    }
+
+    /** @return - The name of the unit at `path`, or nullptr. */
+    const std::string* name(std::string_view path) const
+    {
+        auto it = paths_.find(std::string(path));
+        return it == paths_.end() ? nullptr : &it->second;
+    }
+
+    /** @brief Record a unit as systemd listed it. */
+    void set(Unit u)
+    {
+        auto it = units_.find(u.name);
+        if (it != units_.end() && it->second.path != u.path)
+        {
+            paths_.erase(it->second.path);
+        }
+        paths_[u.path] = u.name;
+        auto name = u.name;
+        units_.insert_or_assign(std::move(name), std::move(u));
+    }
+
+    /** @brief Apply one changed property of the unit at `path`.
+     *  @return - false if the unit is not in the table.
+     */
+    bool update(std::string_view path, Field f, std::string_view value)
+    {
+        auto n = name(path);
+        if (n == nullptr)
+        {
+            return false;
+        }
+        auto& u = units_.at(*n);
+        switch (f)
+        {
+            case Field::load:
+                u.load = value;
+                break;
+            case Field::active:
+                u.active = value;
+                break;
+            case Field::sub:
+                u.sub = value;
+                break;
+        }
+        return true;
+    }
+
+    void remove(std::string_view name)
+    {
+        auto it = units_.find(std::string(name));
+        if (it == units_.end())
+        {
+            return;
+        }
+        paths_.erase(it->second.path);
+        units_.erase(it);
+    }
+
+    /** @brief Forget everything, as when systemd restarts. */
+    void clear()
+    {
+        units_.clear();
+        paths_.clear();
+        patterns_.clear();
+    }
+
+    void track(std::string pattern)
+    {
+        if (!tracked(pattern))
+        {
+            patterns_.push_back(std::move(pattern));
+        }
+    }
+
+    bool tracked(std::string_view pattern) const
+    {
+        return std::ranges::find(patterns_, pattern) != patterns_.end();
+    }
+
+    /** @return - Whether a tracked pattern covers `name`. */
+    bool covered(const std::string& name) const
+    {
+        return std::ranges::any_of(patterns_, [&name](const auto& p) {
+            return matches(p, name);
+        });
+    }
+
+    /** @return - The units in the table matching any of `patterns`. */
+    std::vector<const Unit*>
+        match(const std::vector<std::string>& patterns) const
+    {
+        std::vector<const Unit*> r;
+        for (const auto& [name, u] : units_)
+        {
+            if (std::ranges::any_of(patterns, [&name](const auto& p) {
+                    return matches(p, name);
+                }))
+            {
+                r.push_back(&u);
+            }
+        }
+        return r;
+    }
+
+    size_t size() const
+    {
+        return units_.size();
+    }
+
+    /** @brief Shell-style matching, as ListUnitsByPatterns does it. */
+    static bool matches(const std::string& pattern, const std::string& name)
+    {
+        return fnmatch(pattern.c_str(), name.c_str(), FNM_NOESCAPE) == 0;
+    }
+
+  private:
+    std::unordered_map<std::string, Unit> units_;
+    std::unordered_map<std::string, std::string> paths_;
+    std::vector<std::string> patterns_;
+};
+
+} // namespace unit_status
@@ -1,8 +1,12 @@
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/connection_pool.hpp>
+#include <sdbusplus/message/arena.hpp>
 
 #include <iostream>
+#include <memory_resource>
 #include <vector>
 #include <string>
+#include <string_view>
 
 enum UnitStructFields
 {
@@ -18,42 +22,48 @@ enum UnitStructFields
     UNIT_ALWAYS_ROOT_PATH
 };
 
+// Views into the reply, read with sdbusplus::message::unpack_arena().
 using UnitStruct = std::tuple<
-    std::string,
-    std::string,
-    std::string,
-    std::string,
-    std::string,
-    std::string,
-    sdbusplus::message::object_path,
+    std::string_view,
+    std::string_view,
+    std::string_view,
+    std::string_view,
+    std::string_view,
+    std::string_view,
+    std::string_view,
     uint32_t,
-    std::string,
-    sdbusplus::message::object_path
+    std::string_view,
+    std::string_view
 >;
 
 bool getServiceStatus(const std::vector<std::string>& serviceNames)
 {
-    auto bus = sdbusplus::bus::new_default();
+    // Connections are shared across calls instead of made per call.
+    auto& pool = sdbusplus::bus::connection_pool::default_pool();
 
     std::string service = "org.freedesktop.systemd1";
     std::string path = "/org/freedesktop/systemd1";
     std::string interface = "org.freedesktop.systemd1.Manager";
     std::string method = "ListUnitsByNames";
-    auto msg = bus.new_method_call(service.c_str(), path.c_str(), interface.c_str(), method.c_str());
-
-    // Append the service names to the message
-    msg.append(serviceNames);
 
     try {
-        auto reply = bus.call(msg);
+        auto reply = pool.with([&](sdbusplus::bus_t& b) {
+            auto m = b.new_method_call(service.c_str(), path.c_str(),
+                                       interface.c_str(), method.c_str());
+            m.append(serviceNames);
+            return b.call(m);
+        });
 
-        std::vector<UnitStruct> units;
-        reply.read(units);
+        // The units are views into the reply, in a list from the arena.
+        std::pmr::monotonic_buffer_resource arena;
+        auto units =
+            sdbusplus::message::unpack_arena<std::pmr::vector<UnitStruct>>(
+                reply, arena);
 
         for (const UnitStruct& unit : units)
         {
-            const std::string& serviceName = std::get<UNIT_NAME>(unit);
-            const std::string& activeState = std::get<UNIT_ACTIVE_STATE>(unit);
+            std::string_view serviceName = std::get<UNIT_NAME>(unit);
+            std::string_view activeState = std::get<UNIT_ACTIVE_STATE>(unit);
 
             if (activeState.compare("active") == 0) {
                 std::cout << serviceName << " is active" << std::endl;